@@ -0,0 +1,70 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "perf_counters.hpp"
+#include "pure_simd.hpp"
+
+namespace {
+    std::vector<float> random_distances(std::size_t n)
+    {
+        std::mt19937_64 gen(42);
+        std::uniform_real_distribution<float> dist(0.0f, 100.0f);
+
+        std::vector<float> xs(n);
+        for (auto& x : xs)
+            x = dist(gen);
+        return xs;
+    }
+
+    // The first argument is the number of elements, which are reduced as
+    // many times as it takes to reach 2^20 elements, like the distances of
+    // many points to `n` centroids.
+    template <typename F>
+    void run_argmin(benchmark::State& state, F reduce)
+    {
+        std::size_t n = state.range(0);
+        std::size_t rows = std::max<std::size_t>(1, (std::size_t(1) << 20) / n);
+        auto xs = random_distances(n * rows);
+
+        perf_counters counters;
+        for (auto _ : state) {
+            for (std::size_t r = 0; r < rows; ++r)
+                benchmark::DoNotOptimize(reduce(xs.data() + r * n, n));
+        }
+        counters.report_to(state);
+        state.SetItemsProcessed(state.iterations() * rows * n);
+        state.SetBytesProcessed(state.iterations() * rows * n * sizeof(float));
+    }
+
+    void BM_argminmax_std_min_element(benchmark::State& state)
+    {
+        run_argmin(state, [](const float* xs, std::size_t n) { return std::min_element(xs, xs + n) - xs; });
+    }
+
+    template <std::size_t VectorSize>
+    void BM_argminmax_argmin(benchmark::State& state)
+    {
+        run_argmin(state, [](const float* xs, std::size_t n) { return pure_simd::argmin<VectorSize>(xs, n); });
+    }
+
+    void BM_argminmax_std_minmax_element(benchmark::State& state)
+    {
+        run_argmin(state, [](const float* xs, std::size_t n) { return std::minmax_element(xs, xs + n).first - xs; });
+    }
+
+    template <std::size_t VectorSize>
+    void BM_argminmax_minmax_element(benchmark::State& state)
+    {
+        run_argmin(state, [](const float* xs, std::size_t n) { return pure_simd::minmax_element<VectorSize>(xs, n).first; });
+    }
+}
+
+BENCHMARK(BM_argminmax_std_min_element)->Arg(64)->Arg(1024)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_argminmax_argmin, 8)->Arg(64)->Arg(1024)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_argminmax_argmin, 16)->Arg(64)->Arg(1024)->Arg(1 << 20);
+BENCHMARK(BM_argminmax_std_minmax_element)->Arg(64)->Arg(1024)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_argminmax_minmax_element, 8)->Arg(64)->Arg(1024)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_argminmax_minmax_element, 16)->Arg(64)->Arg(1024)->Arg(1 << 20);
@@ -0,0 +1,97 @@
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "perf_counters.hpp"
+#include "pure_simd.hpp"
+
+namespace {
+    template <typename T>
+    std::vector<T> random_words(std::size_t n)
+    {
+        std::mt19937_64 gen(42);
+
+        std::vector<T> xs(n);
+        for (auto& x : xs)
+            x = static_cast<T>(gen());
+        return xs;
+    }
+
+    template <typename T, typename F>
+    void run_copy(benchmark::State& state, F copy)
+    {
+        std::size_t n = state.range(0);
+        auto src = random_words<T>(n);
+        std::vector<T> dst(n);
+
+        perf_counters counters;
+        for (auto _ : state) {
+            copy(src.data(), n, dst.data());
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+        state.SetItemsProcessed(state.iterations() * n);
+        state.SetBytesProcessed(state.iterations() * n * sizeof(T));
+    }
+
+    // The first argument is the number of words.
+    template <typename T>
+    void BM_bits_memcpy(benchmark::State& state)
+    {
+        run_copy<T>(state, [](const T* src, std::size_t n, T* dst) { std::memcpy(dst, src, n * sizeof(T)); });
+    }
+
+    // Decodes big-endian words byte by byte, as readers usually do.
+    template <typename T>
+    void BM_bits_scalar_byteswap(benchmark::State& state)
+    {
+        run_copy<T>(state, [](const T* src, std::size_t n, T* dst) {
+            auto bytes = reinterpret_cast<const unsigned char*>(src);
+            for (std::size_t i = 0; i < n; ++i, bytes += sizeof(T)) {
+                T x = 0;
+                for (std::size_t b = 0; b < sizeof(T); ++b)
+                    x = static_cast<T>(x << 8 | bytes[b]);
+                dst[i] = x;
+                benchmark::DoNotOptimize(dst[i]);
+            }
+        });
+    }
+
+    template <typename T, std::size_t VectorSize>
+    void BM_bits_byteswap_copy(benchmark::State& state)
+    {
+        run_copy<T>(state, [](const T* src, std::size_t n, T* dst) { pure_simd::byteswap_copy<VectorSize>(src, n, dst); });
+    }
+
+    void BM_bits_scalar_popcount(benchmark::State& state)
+    {
+        run_copy<std::uint64_t>(state, [](const std::uint64_t* src, std::size_t n, std::uint64_t* dst) {
+            for (std::size_t i = 0; i < n; ++i) {
+                dst[i] = static_cast<std::uint64_t>(__builtin_popcountll(src[i]));
+                benchmark::DoNotOptimize(dst[i]);
+            }
+        });
+    }
+
+    template <std::size_t VectorSize>
+    void BM_bits_popcount(benchmark::State& state)
+    {
+        using V = pure_simd::vector<std::uint64_t, VectorSize>;
+
+        run_copy<std::uint64_t>(state, [](const std::uint64_t* src, std::size_t n, std::uint64_t* dst) {
+            for (std::size_t i = 0; i + VectorSize <= n; i += VectorSize)
+                pure_simd::store_to(pure_simd::popcount(pure_simd::load_from<V>(src + i)), dst + i);
+        });
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_bits_memcpy, std::uint32_t)->Arg(1 << 12)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(BM_bits_scalar_byteswap, std::uint32_t)->Arg(1 << 12)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(BM_bits_byteswap_copy, std::uint32_t, 16)->Arg(1 << 12)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(BM_bits_scalar_byteswap, std::uint64_t)->Arg(1 << 12)->Arg(1 << 23);
+BENCHMARK_TEMPLATE(BM_bits_byteswap_copy, std::uint64_t, 8)->Arg(1 << 12)->Arg(1 << 23);
+BENCHMARK(BM_bits_scalar_popcount)->Arg(1 << 12);
+BENCHMARK_TEMPLATE(BM_bits_popcount, 8)->Arg(1 << 12);
@@ -0,0 +1,132 @@
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "perf_counters.hpp"
+#include "pure_simd.hpp"
+
+namespace {
+    std::vector<unsigned char> random_bytes(std::size_t n)
+    {
+        std::mt19937 gen(42);
+
+        std::vector<unsigned char> bytes(n);
+        for (auto& byte : bytes)
+            byte = static_cast<unsigned char>(gen());
+        return bytes;
+    }
+
+    // The first argument is the number of bytes.
+    template <typename F>
+    void run_checksum(benchmark::State& state, F checksum)
+    {
+        const std::size_t size = state.range(0);
+        auto bytes = random_bytes(size);
+
+        perf_counters counters;
+        for (auto _ : state)
+            benchmark::DoNotOptimize(checksum(bytes.data(), size));
+        counters.report_to(state);
+
+        state.SetBytesProcessed(state.iterations() * size);
+    }
+
+    // zlib's adler32: 16 bytes per step, reduced every 5552 bytes.
+    void BM_checksum_scalar_adler32(benchmark::State& state)
+    {
+        run_checksum(state, [](const unsigned char* bytes, std::size_t size) {
+            std::uint32_t a = 1;
+            std::uint32_t b = 0;
+            while (size > 0) {
+                std::size_t block = std::min<std::size_t>(size, 5552);
+                size -= block;
+                for (; block >= 16; block -= 16, bytes += 16) {
+                    for (int i = 0; i < 16; ++i) {
+                        a += bytes[i];
+                        b += a;
+                    }
+                }
+                for (; block > 0; --block) {
+                    a += *bytes++;
+                    b += a;
+                }
+                a %= 65521;
+                b %= 65521;
+            }
+            return b << 16 | a;
+        });
+    }
+
+    template <std::size_t VectorSize>
+    void BM_checksum_adler32(benchmark::State& state)
+    {
+        run_checksum(state, [](const unsigned char* bytes, std::size_t size) { return pure_simd::adler32<VectorSize>(bytes, size); });
+    }
+
+    // Reduced every 65536 words, in the manner of zlib's adler32.
+    void BM_checksum_scalar_fletcher64(benchmark::State& state)
+    {
+        run_checksum(state, [](const unsigned char* bytes, std::size_t size) {
+            auto words = reinterpret_cast<const std::uint32_t*>(bytes);
+            std::size_t n = size / 4;
+            std::uint64_t a = 0;
+            std::uint64_t b = 0;
+            while (n > 0) {
+                std::size_t block = std::min<std::size_t>(n, 65536);
+                n -= block;
+                for (; block > 0; --block) {
+                    a += *words++;
+                    b += a;
+                }
+                a %= 0xffffffff;
+                b %= 0xffffffff;
+            }
+            return b << 32 | a;
+        });
+    }
+
+    template <std::size_t VectorSize>
+    void BM_checksum_fletcher64(benchmark::State& state)
+    {
+        run_checksum(state, [](const unsigned char* bytes, std::size_t size) {
+            return pure_simd::fletcher64<VectorSize>(reinterpret_cast<const std::uint32_t*>(bytes), size / 4);
+        });
+    }
+
+    // A table lookup per byte, like zlib's crc32 without braiding.
+    void BM_checksum_scalar_crc32c(benchmark::State& state)
+    {
+        run_checksum(state, [](const unsigned char* bytes, std::size_t size) {
+            const auto& table = pure_simd::detail::crc32c_slices.table[0];
+
+            std::uint32_t crc = 0xffffffff;
+            for (std::size_t i = 0; i < size; ++i)
+                crc = crc >> 8 ^ table[(crc ^ bytes[i]) & 0xff];
+            return ~crc;
+        });
+    }
+
+    void BM_checksum_slice_by_8_crc32c(benchmark::State& state)
+    {
+        run_checksum(state, [](const unsigned char* bytes, std::size_t size) {
+            return ~pure_simd::detail::crc32c_slice_by_8(0xffffffff, bytes, size);
+        });
+    }
+
+    void BM_checksum_crc32c(benchmark::State& state)
+    {
+        run_checksum(state, [](const unsigned char* bytes, std::size_t size) { return pure_simd::crc32c(bytes, size); });
+    }
+}
+
+BENCHMARK(BM_checksum_scalar_adler32)->Arg(4 << 10)->Arg(16 << 20);
+BENCHMARK_TEMPLATE(BM_checksum_adler32, 16)->Arg(4 << 10)->Arg(16 << 20);
+BENCHMARK_TEMPLATE(BM_checksum_adler32, 64)->Arg(4 << 10)->Arg(16 << 20);
+BENCHMARK(BM_checksum_scalar_fletcher64)->Arg(4 << 10)->Arg(16 << 20);
+BENCHMARK_TEMPLATE(BM_checksum_fletcher64, 8)->Arg(4 << 10)->Arg(16 << 20);
+BENCHMARK_TEMPLATE(BM_checksum_fletcher64, 16)->Arg(4 << 10)->Arg(16 << 20);
+BENCHMARK(BM_checksum_scalar_crc32c)->Arg(4 << 10)->Arg(16 << 20);
+BENCHMARK(BM_checksum_slice_by_8_crc32c)->Arg(4 << 10)->Arg(16 << 20);
+BENCHMARK(BM_checksum_crc32c)->Arg(4 << 10)->Arg(16 << 20);
@@ -0,0 +1,143 @@
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "perf_counters.hpp"
+#include "pure_simd.hpp"
+
+namespace {
+    constexpr std::size_t value_count = std::size_t(1) << 20;
+
+    std::vector<std::uint32_t> random_values(unsigned bits)
+    {
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<std::uint32_t> dist(0, (std::uint64_t { 1 } << bits) - 1);
+
+        std::vector<std::uint32_t> xs(value_count);
+        for (auto& x : xs)
+            x = dist(gen);
+        return xs;
+    }
+
+    std::vector<std::uint32_t> sorted_values()
+    {
+        std::mt19937 gen(42);
+        std::geometric_distribution<std::uint32_t> gap(0.1);
+
+        std::vector<std::uint32_t> xs(value_count);
+        std::uint32_t x = 0;
+        for (auto& value : xs)
+            value = x += gap(gen);
+        return xs;
+    }
+
+    void set_processed(benchmark::State& state)
+    {
+        state.SetItemsProcessed(state.iterations() * value_count);
+        state.SetBytesProcessed(state.iterations() * value_count * sizeof(std::uint32_t));
+    }
+
+    // The usual scalar decoder of a sequential bit stream. The first
+    // argument is the bit width.
+    void BM_codec_scalar_unpack(benchmark::State& state)
+    {
+        const unsigned bits = state.range(0);
+        auto xs = random_values(bits);
+        std::vector<std::uint32_t> packed(value_count * bits / 32 + 1), unpacked(value_count);
+        pure_simd::detail::pack_sequential(xs.data(), value_count, bits, packed.data());
+
+        perf_counters counters;
+        for (auto _ : state) {
+            pure_simd::detail::unpack_sequential(packed.data(), value_count, bits, unpacked.data());
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+        set_processed(state);
+    }
+
+    template <std::size_t VectorSize>
+    void BM_codec_unpack(benchmark::State& state)
+    {
+        const unsigned bits = state.range(0);
+        auto xs = random_values(bits);
+        std::vector<std::uint32_t> packed(pure_simd::packed_size(value_count, bits)), unpacked(value_count);
+        pure_simd::pack_bits<VectorSize>(xs.data(), value_count, bits, packed.data());
+
+        perf_counters counters;
+        for (auto _ : state) {
+            pure_simd::unpack_bits<VectorSize>(packed.data(), value_count, bits, unpacked.data());
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+        set_processed(state);
+    }
+
+    template <std::size_t VectorSize>
+    void BM_codec_pack(benchmark::State& state)
+    {
+        const unsigned bits = state.range(0);
+        auto xs = random_values(bits);
+        std::vector<std::uint32_t> packed(pure_simd::packed_size(value_count, bits));
+
+        perf_counters counters;
+        for (auto _ : state) {
+            pure_simd::pack_bits<VectorSize>(xs.data(), value_count, bits, packed.data());
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+        set_processed(state);
+    }
+
+    // Decodes a sorted list of gaps: unpacking followed by a running sum.
+    void BM_codec_scalar_delta_decode(benchmark::State& state)
+    {
+        auto xs = sorted_values();
+        std::vector<std::uint32_t> gaps(value_count);
+        std::adjacent_difference(xs.begin(), xs.end(), gaps.begin());
+
+        const unsigned bits = pure_simd::required_bits<8>(gaps.data(), value_count);
+        std::vector<std::uint32_t> packed(value_count * bits / 32 + 1), decoded(value_count);
+        pure_simd::detail::pack_sequential(gaps.data(), value_count, bits, packed.data());
+
+        perf_counters counters;
+        for (auto _ : state) {
+            pure_simd::detail::unpack_sequential(packed.data(), value_count, bits, decoded.data());
+            std::uint32_t sum = 0;
+            for (auto& x : decoded)
+                x = sum += x;
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+        set_processed(state);
+    }
+
+    // The first argument selects the coding: 0 for frame of reference, 1 for delta.
+    template <std::size_t VectorSize>
+    void BM_codec_decode(benchmark::State& state)
+    {
+        const auto coding = state.range(0) ? pure_simd::integer_coding::delta : pure_simd::integer_coding::frame_of_reference;
+
+        auto xs = sorted_values();
+        std::vector<std::uint32_t> encoded(pure_simd::max_encoded_size(value_count)), decoded(value_count);
+        auto size = pure_simd::encode<VectorSize>(xs.data(), value_count, encoded.data(), coding);
+
+        perf_counters counters;
+        for (auto _ : state) {
+            pure_simd::decode<VectorSize>(encoded.data(), size, value_count, decoded.data(), coding);
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+        set_processed(state);
+        state.counters["bits_per_value"] = 32.0 * size / value_count;
+    }
+}
+
+BENCHMARK(BM_codec_scalar_unpack)->Arg(5)->Arg(13)->Arg(27);
+BENCHMARK_TEMPLATE(BM_codec_unpack, 8)->Arg(5)->Arg(13)->Arg(27);
+BENCHMARK_TEMPLATE(BM_codec_unpack, 16)->Arg(5)->Arg(13)->Arg(27);
+BENCHMARK_TEMPLATE(BM_codec_pack, 8)->Arg(5)->Arg(13)->Arg(27);
+BENCHMARK(BM_codec_scalar_delta_decode);
+BENCHMARK_TEMPLATE(BM_codec_decode, 8)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_codec_decode, 16)->Arg(0)->Arg(1);
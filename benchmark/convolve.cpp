@@ -0,0 +1,166 @@
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "perf_counters.hpp"
+#include "pure_simd.hpp"
+
+namespace {
+    constexpr std::size_t sample_count = 1 << 16;
+
+    constexpr std::size_t image_width = 512;
+
+    constexpr std::size_t image_height = 512;
+
+    std::vector<float> random_floats(std::size_t n)
+    {
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+        std::vector<float> xs(n);
+        for (auto& x : xs)
+            x = dist(gen);
+        return xs;
+    }
+
+    void set_processed(benchmark::State& state, std::size_t n)
+    {
+        state.SetItemsProcessed(state.iterations() * n);
+        state.SetBytesProcessed(state.iterations() * n * sizeof(float));
+    }
+
+    // The first argument is the number of taps.
+    void BM_convolve_scalar(benchmark::State& state)
+    {
+        const std::size_t taps = state.range(0);
+        auto src = random_floats(sample_count + taps);
+        auto kernel = random_floats(taps);
+        std::vector<float> dst(sample_count);
+
+        perf_counters counters;
+        for (auto _ : state) {
+            for (std::size_t i = 0; i < sample_count; ++i) {
+                float sum = 0.0f;
+                for (std::size_t k = 0; k < taps; ++k)
+                    sum += kernel[k] * src[i + k];
+                dst[i] = sum;
+            }
+
+            benchmark::DoNotOptimize(dst.data());
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+        set_processed(state, sample_count);
+    }
+
+    // Loads the window of every tap from memory, overlapping the previous one.
+    template <std::size_t VectorSize>
+    void BM_convolve_reload(benchmark::State& state)
+    {
+        using fvec = pure_simd::vector<float, VectorSize>;
+
+        const std::size_t taps = state.range(0);
+        auto src = random_floats(sample_count + taps);
+        auto kernel = random_floats(taps);
+        std::vector<float> dst(sample_count);
+
+        perf_counters counters;
+        for (auto _ : state) {
+            for (std::size_t i = 0; i < sample_count; i += VectorSize) {
+                auto sum = pure_simd::scalar<fvec>(0.0f);
+                for (std::size_t k = 0; k < taps; ++k)
+                    sum = sum + pure_simd::scalar<fvec>(kernel[k]) * pure_simd::load_from<fvec>(src.data() + i + k);
+                pure_simd::store_to(sum, dst.data() + i);
+            }
+
+            benchmark::DoNotOptimize(dst.data());
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+        set_processed(state, sample_count);
+    }
+
+    template <std::size_t VectorSize>
+    void BM_convolve_pure_simd(benchmark::State& state)
+    {
+        const std::size_t taps = state.range(0);
+        auto src = random_floats(sample_count);
+        auto kernel = random_floats(taps);
+        std::vector<float> dst(sample_count);
+
+        perf_counters counters;
+        for (auto _ : state) {
+            pure_simd::convolve<VectorSize>(src.data(), src.size(), kernel.data(), taps, dst.data(), pure_simd::border::clamp);
+
+            benchmark::DoNotOptimize(dst.data());
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+        set_processed(state, sample_count);
+    }
+
+    template <std::size_t VectorSize>
+    void BM_convolve_pure_simd_separable(benchmark::State& state)
+    {
+        const std::size_t taps = state.range(0);
+        auto src = random_floats(image_width * image_height);
+        auto kernel = random_floats(taps);
+        std::vector<float> dst(src.size());
+
+        perf_counters counters;
+        for (auto _ : state) {
+            pure_simd::convolve_separable<VectorSize>(src.data(), image_width, image_height,
+                kernel.data(), taps, kernel.data(), taps, dst.data(), pure_simd::border::clamp);
+
+            benchmark::DoNotOptimize(dst.data());
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+        set_processed(state, src.size());
+    }
+
+    void BM_convolve_scalar_stencil(benchmark::State& state)
+    {
+        auto src = random_floats(sample_count + 2);
+        std::vector<float> dst(sample_count);
+
+        perf_counters counters;
+        for (auto _ : state) {
+            for (std::size_t i = 0; i < sample_count; ++i)
+                dst[i] = src[i] - (src[i + 1] + src[i + 1]) + src[i + 2];
+
+            benchmark::DoNotOptimize(dst.data());
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+        set_processed(state, sample_count);
+    }
+
+    template <std::size_t VectorSize>
+    void BM_convolve_pure_simd_stencil(benchmark::State& state)
+    {
+        auto src = random_floats(sample_count);
+        std::vector<float> dst(sample_count);
+
+        perf_counters counters;
+        for (auto _ : state) {
+            pure_simd::stencil<VectorSize, 1>(src.data(), src.size(), dst.data(), [](const auto& w) {
+                return w[0] - (w[1] + w[1]) + w[2];
+            });
+
+            benchmark::DoNotOptimize(dst.data());
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+        set_processed(state, sample_count);
+    }
+}
+
+BENCHMARK(BM_convolve_scalar)->Arg(3)->Arg(7)->Arg(31);
+BENCHMARK_TEMPLATE(BM_convolve_reload, 8)->Arg(3)->Arg(7)->Arg(31);
+BENCHMARK_TEMPLATE(BM_convolve_pure_simd, 8)->Arg(3)->Arg(7)->Arg(31);
+BENCHMARK_TEMPLATE(BM_convolve_pure_simd, 16)->Arg(3)->Arg(7)->Arg(31);
+BENCHMARK_TEMPLATE(BM_convolve_pure_simd_separable, 8)->Arg(3)->Arg(7);
+BENCHMARK(BM_convolve_scalar_stencil);
+BENCHMARK_TEMPLATE(BM_convolve_pure_simd_stencil, 8);
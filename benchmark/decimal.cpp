@@ -0,0 +1,197 @@
+#include <charconv>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "perf_counters.hpp"
+#include "pure_simd.hpp"
+
+namespace {
+    constexpr std::size_t value_count = std::size_t(1) << 18;
+
+    // Integers of 1 to `digits` digits, as in a CSV column of ids or amounts.
+    std::vector<std::uint64_t> random_integers(int digits)
+    {
+        std::mt19937_64 gen(42);
+        std::uniform_int_distribution<int> length(1, digits);
+
+        std::vector<std::uint64_t> xs(value_count);
+        for (auto& x : xs)
+            x = gen() % pure_simd::detail::decimal_powers[length(gen)];
+        return xs;
+    }
+
+    std::string integer_text(int digits)
+    {
+        std::string text;
+        for (auto x : random_integers(digits))
+            text += std::to_string(x) + ',';
+        return text;
+    }
+
+    // Prices with two decimals and measurements with six.
+    std::string double_text()
+    {
+        std::mt19937_64 gen(42);
+        std::uniform_real_distribution<double> dist(0.0, 100000.0);
+
+        std::string text;
+        char buffer[32];
+        for (std::size_t i = 0; i < value_count; ++i) {
+            auto precision = i % 2 == 0 ? 2 : 6;
+            text.append(buffer, std::to_chars(buffer, buffer + sizeof(buffer), dist(gen), std::chars_format::fixed, precision).ptr);
+            text += ',';
+        }
+        return text;
+    }
+
+    // Items are numbers and bytes are characters of text.
+    void set_processed(benchmark::State& state, const std::string& text)
+    {
+        state.SetItemsProcessed(state.iterations() * value_count);
+        state.SetBytesProcessed(state.iterations() * text.size());
+    }
+
+    // The first argument is the maximum number of digits.
+    void BM_decimal_parse_strtoull(benchmark::State& state)
+    {
+        auto text = integer_text(state.range(0));
+        std::vector<std::uint64_t> xs(value_count);
+
+        perf_counters counters;
+        for (auto _ : state) {
+            char* p = text.data();
+            for (auto& x : xs)
+                x = std::strtoull(p, &p, 10), ++p;
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+        set_processed(state, text);
+    }
+
+    void BM_decimal_parse_from_chars(benchmark::State& state)
+    {
+        auto text = integer_text(state.range(0));
+        std::vector<std::uint64_t> xs(value_count);
+
+        perf_counters counters;
+        for (auto _ : state) {
+            const char* p = text.data();
+            for (auto& x : xs)
+                p = std::from_chars(p, text.data() + text.size(), x).ptr + 1;
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+        set_processed(state, text);
+    }
+
+    template <std::size_t VectorSize>
+    void BM_decimal_parse_uint(benchmark::State& state)
+    {
+        auto text = integer_text(state.range(0));
+        std::vector<std::uint64_t> xs(value_count);
+
+        perf_counters counters;
+        for (auto _ : state) {
+            pure_simd::parse_uint<VectorSize>(text.data(), text.data() + text.size(), xs.data(), xs.size());
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+        set_processed(state, text);
+    }
+
+    void BM_decimal_parse_strtod(benchmark::State& state)
+    {
+        auto text = double_text();
+        std::vector<double> xs(value_count);
+
+        perf_counters counters;
+        for (auto _ : state) {
+            char* p = text.data();
+            for (auto& x : xs)
+                x = std::strtod(p, &p), ++p;
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+        set_processed(state, text);
+    }
+
+    void BM_decimal_parse_from_chars_double(benchmark::State& state)
+    {
+        auto text = double_text();
+        std::vector<double> xs(value_count);
+
+        perf_counters counters;
+        for (auto _ : state) {
+            const char* p = text.data();
+            for (auto& x : xs)
+                p = std::from_chars(p, text.data() + text.size(), x).ptr + 1;
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+        set_processed(state, text);
+    }
+
+    template <std::size_t VectorSize>
+    void BM_decimal_parse_double(benchmark::State& state)
+    {
+        auto text = double_text();
+        std::vector<double> xs(value_count);
+
+        perf_counters counters;
+        for (auto _ : state) {
+            pure_simd::parse_double<VectorSize>(text.data(), text.data() + text.size(), xs.data(), xs.size());
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+        set_processed(state, text);
+    }
+
+    void BM_decimal_format_to_chars(benchmark::State& state)
+    {
+        auto xs = random_integers(state.range(0));
+        std::string text(pure_simd::max_formatted_size(value_count), '\0');
+
+        perf_counters counters;
+        for (auto _ : state) {
+            char* p = text.data();
+            for (auto x : xs) {
+                p = std::to_chars(p, p + 20, x).ptr;
+                *p++ = ',';
+            }
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+        set_processed(state, integer_text(state.range(0)));
+    }
+
+    template <std::size_t VectorSize>
+    void BM_decimal_format_uint(benchmark::State& state)
+    {
+        auto xs = random_integers(state.range(0));
+        std::string text(pure_simd::max_formatted_size(value_count), '\0');
+
+        perf_counters counters;
+        for (auto _ : state) {
+            pure_simd::format_uint<VectorSize>(xs.data(), xs.size(), text.data(), ',');
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+        set_processed(state, integer_text(state.range(0)));
+    }
+}
+
+BENCHMARK(BM_decimal_parse_strtoull)->Arg(4)->Arg(10)->Arg(19);
+BENCHMARK(BM_decimal_parse_from_chars)->Arg(4)->Arg(10)->Arg(19);
+BENCHMARK_TEMPLATE(BM_decimal_parse_uint, 8)->Arg(4)->Arg(10)->Arg(19);
+BENCHMARK_TEMPLATE(BM_decimal_parse_uint, 16)->Arg(4)->Arg(10)->Arg(19);
+BENCHMARK(BM_decimal_parse_strtod);
+BENCHMARK(BM_decimal_parse_from_chars_double);
+BENCHMARK_TEMPLATE(BM_decimal_parse_double, 16);
+BENCHMARK(BM_decimal_format_to_chars)->Arg(4)->Arg(10)->Arg(19);
+BENCHMARK_TEMPLATE(BM_decimal_format_uint, 8)->Arg(4)->Arg(10)->Arg(19);
+BENCHMARK_TEMPLATE(BM_decimal_format_uint, 16)->Arg(4)->Arg(10)->Arg(19);
@@ -0,0 +1,87 @@
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "perf_counters.hpp"
+#include "pure_simd.hpp"
+
+namespace {
+    std::vector<float> random_signal(std::size_t n, unsigned seed)
+    {
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+        std::vector<float> xs(n);
+        for (auto& x : xs)
+            x = dist(gen);
+        return xs;
+    }
+
+    // Also reports the customary 5 n log2(n) flops of a complex FFT.
+    void set_processed(benchmark::State& state, std::size_t n)
+    {
+        state.SetItemsProcessed(state.iterations() * n);
+        state.SetBytesProcessed(state.iterations() * n * 2 * sizeof(float));
+        state.counters["flops"] = benchmark::Counter(
+            static_cast<double>(state.iterations()) * 5 * n * std::log2(static_cast<double>(n)),
+            benchmark::Counter::kIsRate);
+    }
+
+    void BM_fft_naive_dft(benchmark::State& state)
+    {
+        const std::size_t n = state.range(0);
+        const auto re = random_signal(n, 1);
+        const auto im = random_signal(n, 2);
+        std::vector<float> out_re(n), out_im(n);
+
+        // Twiddles are tabulated once, leaving the O(n^2) sums.
+        const double pi = std::acos(-1.0);
+        std::vector<float> w_re(n), w_im(n);
+        for (std::size_t k = 0; k < n; ++k) {
+            w_re[k] = static_cast<float>(std::cos(2 * pi * k / n));
+            w_im[k] = static_cast<float>(-std::sin(2 * pi * k / n));
+        }
+
+        perf_counters counters;
+        for (auto _ : state) {
+            for (std::size_t k = 0; k < n; ++k) {
+                float sum_re = 0;
+                float sum_im = 0;
+                for (std::size_t j = 0; j < n; ++j) {
+                    auto w = j * k % n;
+                    sum_re += re[j] * w_re[w] - im[j] * w_im[w];
+                    sum_im += re[j] * w_im[w] + im[j] * w_re[w];
+                }
+                out_re[k] = sum_re;
+                out_im[k] = sum_im;
+            }
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+        set_processed(state, n);
+    }
+
+    template <std::size_t VectorSize>
+    void BM_fft_pure_simd_fft(benchmark::State& state)
+    {
+        const std::size_t n = state.range(0);
+        auto re = random_signal(n, 1);
+        auto im = random_signal(n, 2);
+        auto plan = pure_simd::make_fft_plan<float>(n);
+
+        perf_counters counters;
+        for (auto _ : state) {
+            pure_simd::fft<VectorSize>(plan, re.data(), im.data());
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+        set_processed(state, n);
+    }
+}
+
+BENCHMARK(BM_fft_naive_dft)->RangeMultiplier(4)->Range(1 << 10, 1 << 12);
+BENCHMARK_TEMPLATE(BM_fft_pure_simd_fft, 1)->RangeMultiplier(4)->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(BM_fft_pure_simd_fft, 8)->RangeMultiplier(4)->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(BM_fft_pure_simd_fft, 16)->RangeMultiplier(4)->Range(1 << 10, 1 << 16);
@@ -0,0 +1,153 @@
+#include <algorithm>
+#include <cstring>
+#include <random>
+
+#include "benchmark/benchmark.h"
+
+#include "perf_counters.hpp"
+#include "pure_simd.hpp"
+
+namespace {
+    constexpr std::size_t text_size = 1 << 20;
+
+    // Log-like text: random printable characters with a newline every
+    // 40 to 160 characters. The searched byte '#' only occurs at the end.
+    const std::vector<char>& log_text()
+    {
+        static const std::vector<char> text = [] {
+            std::mt19937 gen(42);
+            std::uniform_int_distribution<> chars('a', 'z');
+            std::uniform_int_distribution<> line_lengths(40, 160);
+
+            std::vector<char> text(text_size);
+            std::size_t next_newline = line_lengths(gen);
+            for (std::size_t i = 0; i < text.size(); ++i) {
+                if (i == next_newline) {
+                    text[i] = '\n';
+                    next_newline += line_lengths(gen);
+                } else {
+                    text[i] = static_cast<char>(chars(gen));
+                }
+            }
+            text.back() = '#';
+            return text;
+        }();
+        return text;
+    }
+
+    void set_processed(benchmark::State& state)
+    {
+        state.SetItemsProcessed(state.iterations() * text_size);
+        state.SetBytesProcessed(state.iterations() * text_size);
+    }
+
+    void BM_find_std_find(benchmark::State& state)
+    {
+        const auto& text = log_text();
+
+        perf_counters counters;
+        for (auto _ : state)
+            benchmark::DoNotOptimize(std::find(text.begin(), text.end(), '#'));
+        counters.report_to(state);
+        set_processed(state);
+    }
+
+    void BM_find_memchr(benchmark::State& state)
+    {
+        const auto& text = log_text();
+
+        perf_counters counters;
+        for (auto _ : state)
+            benchmark::DoNotOptimize(std::memchr(text.data(), '#', text.size()));
+        counters.report_to(state);
+        set_processed(state);
+    }
+
+    template <std::size_t VectorSize>
+    void BM_find_pure_simd_find(benchmark::State& state)
+    {
+        const auto& text = log_text();
+
+        perf_counters counters;
+        for (auto _ : state)
+            benchmark::DoNotOptimize(pure_simd::find<VectorSize>(text.data(), text.size(), '#'));
+        counters.report_to(state);
+        set_processed(state);
+    }
+
+    void BM_find_std_count(benchmark::State& state)
+    {
+        const auto& text = log_text();
+
+        perf_counters counters;
+        for (auto _ : state)
+            benchmark::DoNotOptimize(std::count(text.begin(), text.end(), '\n'));
+        counters.report_to(state);
+        set_processed(state);
+    }
+
+    template <std::size_t VectorSize>
+    void BM_find_pure_simd_count(benchmark::State& state)
+    {
+        const auto& text = log_text();
+
+        perf_counters counters;
+        for (auto _ : state)
+            benchmark::DoNotOptimize(pure_simd::count<VectorSize>(text.data(), text.size(), '\n'));
+        counters.report_to(state);
+        set_processed(state);
+    }
+
+    void BM_find_memchr_split(benchmark::State& state)
+    {
+        const auto& text = log_text();
+
+        perf_counters counters;
+        for (auto _ : state) {
+            std::size_t longest = 0;
+            const char* begin = text.data();
+            const char* end = text.data() + text.size();
+
+            while (const char* pos = static_cast<const char*>(std::memchr(begin, '\n', end - begin))) {
+                longest = std::max<std::size_t>(longest, pos - begin);
+                begin = pos + 1;
+            }
+            longest = std::max<std::size_t>(longest, end - begin);
+
+            benchmark::DoNotOptimize(longest);
+        }
+        counters.report_to(state);
+        set_processed(state);
+    }
+
+    template <std::size_t VectorSize>
+    void BM_find_pure_simd_split(benchmark::State& state)
+    {
+        const auto& text = log_text();
+
+        perf_counters counters;
+        for (auto _ : state) {
+            std::size_t longest = 0;
+            pure_simd::split<VectorSize>(text.data(), text.size(), '\n', [&](std::size_t begin, std::size_t end) {
+                longest = std::max(longest, end - begin);
+            });
+
+            benchmark::DoNotOptimize(longest);
+        }
+        counters.report_to(state);
+        set_processed(state);
+    }
+}
+
+BENCHMARK(BM_find_std_find);
+BENCHMARK(BM_find_memchr);
+BENCHMARK_TEMPLATE(BM_find_pure_simd_find, 32);
+BENCHMARK_TEMPLATE(BM_find_pure_simd_find, 64);
+
+BENCHMARK(BM_find_std_count);
+BENCHMARK_TEMPLATE(BM_find_pure_simd_count, 32);
+BENCHMARK_TEMPLATE(BM_find_pure_simd_count, 64);
+
+BENCHMARK(BM_find_memchr_split);
+BENCHMARK_TEMPLATE(BM_find_pure_simd_split, 32);
+BENCHMARK_TEMPLATE(BM_find_pure_simd_split, 64);
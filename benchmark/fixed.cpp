@@ -0,0 +1,153 @@
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "perf_counters.hpp"
+#include "pure_simd.hpp"
+
+namespace {
+    constexpr std::size_t frame_count = 1 << 14;
+
+    constexpr std::size_t sample_count = 1 << 16;
+
+    using q14 = pure_simd::fixed<std::int16_t, 14>;
+
+    // A low-pass biquad at a tenth of the sample rate, b0, b1, b2, a1, a2.
+    constexpr float lowpass[] { 0.0675f, 0.1349f, 0.0675f, -1.1430f, 0.4128f };
+
+    // A peaking filter that follows it in the chain.
+    constexpr float peaking[] { 1.0883f, -1.5713f, 0.6152f, -1.5713f, 0.7035f };
+
+    template <typename T>
+    std::vector<T> random_samples(std::size_t n)
+    {
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<float> dist(-0.5f, 0.5f);
+
+        std::vector<T> xs(n);
+        for (auto& x : xs)
+            x = T(dist(gen));
+        return xs;
+    }
+
+    // Direct form I on one lane per channel.
+    template <typename V, typename C>
+    struct biquad {
+        using coefficient_vector = typename V::template with_value_t<C>;
+
+        explicit biquad(const float (&cs)[5])
+            : b0 { pure_simd::scalar<coefficient_vector>(C(cs[0])) }
+            , b1 { pure_simd::scalar<coefficient_vector>(C(cs[1])) }
+            , b2 { pure_simd::scalar<coefficient_vector>(C(cs[2])) }
+            , a1 { pure_simd::scalar<coefficient_vector>(C(-cs[3])) }
+            , a2 { pure_simd::scalar<coefficient_vector>(C(-cs[4])) }
+        {
+        }
+
+        V operator()(V x)
+        {
+            V y = x * b0 + x1 * b1 + x2 * b2 + y1 * a1 + y2 * a2;
+            x2 = x1;
+            x1 = x;
+            y2 = y1;
+            y1 = y;
+            return y;
+        }
+
+        coefficient_vector b0, b1, b2, a1, a2;
+        V x1 {}, x2 {}, y1 {}, y2 {};
+    };
+
+    // T is the sample type and C the coefficient type; the samples of the
+    // VectorSize channels are interleaved.
+    template <typename T, typename C, std::size_t VectorSize>
+    void BM_fixed_biquad_chain(benchmark::State& state)
+    {
+        using V = pure_simd::vector<T, VectorSize>;
+
+        auto src = random_samples<T>(frame_count * VectorSize);
+        std::vector<T> dst(src.size());
+
+        perf_counters counters;
+        for (auto _ : state) {
+            biquad<V, C> first { lowpass }, second { peaking };
+            for (std::size_t i = 0; i < src.size(); i += VectorSize)
+                pure_simd::store_to(second(first(pure_simd::load_from<V>(src.data() + i))), dst.data() + i);
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+
+        state.SetItemsProcessed(state.iterations() * src.size());
+        state.SetBytesProcessed(state.iterations() * src.size() * sizeof(T));
+    }
+
+    // The first argument is the number of taps.
+    template <typename T, std::size_t VectorSize>
+    void BM_fixed_fir(benchmark::State& state)
+    {
+        const std::size_t tap_count = state.range(0);
+        auto src = random_samples<T>(sample_count);
+        std::vector<T> taps(tap_count, T(0.5f / tap_count));
+        std::vector<T> dst(sample_count);
+
+        perf_counters counters;
+        for (auto _ : state) {
+            pure_simd::fir<VectorSize>(src.data(), sample_count, taps.data(), tap_count, dst.data());
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+
+        state.SetItemsProcessed(state.iterations() * sample_count);
+        state.SetBytesProcessed(state.iterations() * sample_count * sizeof(T));
+    }
+
+    template <std::size_t VectorSize>
+    void BM_fixed_to_float(benchmark::State& state)
+    {
+        using V = pure_simd::vector<float, VectorSize>;
+
+        auto src = random_samples<pure_simd::q15>(sample_count);
+        std::vector<float> dst(sample_count);
+
+        perf_counters counters;
+        for (auto _ : state) {
+            for (std::size_t i = 0; i < sample_count; i += VectorSize)
+                pure_simd::store_to(pure_simd::load_from<V>(src.data() + i), dst.data() + i);
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+
+        state.SetItemsProcessed(state.iterations() * sample_count);
+    }
+
+    template <std::size_t VectorSize>
+    void BM_fixed_from_float(benchmark::State& state)
+    {
+        using V = pure_simd::vector<float, VectorSize>;
+
+        auto src = random_samples<float>(sample_count);
+        std::vector<pure_simd::q15> dst(sample_count);
+
+        perf_counters counters;
+        for (auto _ : state) {
+            for (std::size_t i = 0; i < sample_count; i += VectorSize)
+                pure_simd::store_to(pure_simd::load_from<V>(src.data() + i), dst.data() + i);
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+
+        state.SetItemsProcessed(state.iterations() * sample_count);
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_fixed_biquad_chain, float, float, 8);
+BENCHMARK_TEMPLATE(BM_fixed_biquad_chain, float, float, 16);
+BENCHMARK_TEMPLATE(BM_fixed_biquad_chain, pure_simd::q15, q14, 16);
+BENCHMARK_TEMPLATE(BM_fixed_biquad_chain, pure_simd::q15, q14, 32);
+BENCHMARK_TEMPLATE(BM_fixed_fir, float, 16)->Arg(16)->Arg(64);
+BENCHMARK_TEMPLATE(BM_fixed_fir, pure_simd::q15, 32)->Arg(16)->Arg(64);
+BENCHMARK_TEMPLATE(BM_fixed_to_float, 16);
+BENCHMARK_TEMPLATE(BM_fixed_from_float, 16);
@@ -0,0 +1,64 @@
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "perf_counters.hpp"
+#include "pure_simd.hpp"
+
+namespace {
+    // 64 MiB of floats per operand, so the dot product is memory-bound.
+    constexpr std::size_t element_count = std::size_t(16) << 20;
+
+    template <typename T>
+    std::vector<T> random_values(unsigned seed)
+    {
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+        std::vector<T> xs(element_count);
+        for (auto& x : xs)
+            x = T(dist(gen));
+        return xs;
+    }
+
+    // T is the storage type of both operands, the products are summed in float.
+    template <typename T, std::size_t VectorSize>
+    void BM_float16_inner_product(benchmark::State& state)
+    {
+        auto xs = random_values<T>(1);
+        auto ys = random_values<T>(2);
+
+        perf_counters counters;
+        for (auto _ : state)
+            benchmark::DoNotOptimize(pure_simd::inner_product<VectorSize>(xs.data(), element_count, ys.data(), 0.0f));
+        counters.report_to(state);
+
+        state.SetItemsProcessed(state.iterations() * element_count);
+        state.SetBytesProcessed(state.iterations() * element_count * 2 * sizeof(T));
+    }
+
+    template <typename T, std::size_t VectorSize>
+    void BM_float16_transform(benchmark::State& state)
+    {
+        auto xs = random_values<T>(1);
+        std::vector<T> ys(element_count);
+
+        perf_counters counters;
+        for (auto _ : state) {
+            pure_simd::transform<VectorSize>(xs.data(), element_count, ys.data(), [](float x) { return x * 0.5f + 1.0f; });
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+
+        state.SetItemsProcessed(state.iterations() * element_count);
+        state.SetBytesProcessed(state.iterations() * element_count * 2 * sizeof(T));
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_float16_inner_product, float, 16)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_float16_inner_product, pure_simd::float16, 16)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_float16_inner_product, pure_simd::bfloat16, 16)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_float16_transform, float, 16)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_float16_transform, pure_simd::float16, 16)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_float16_transform, pure_simd::bfloat16, 16)->Unit(benchmark::kMillisecond);
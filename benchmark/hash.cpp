@@ -0,0 +1,140 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "perf_counters.hpp"
+#include "pure_simd.hpp"
+
+namespace {
+    constexpr std::size_t key_count = std::size_t(1) << 16;
+
+    std::vector<std::uint64_t> random_keys(std::size_t n, std::uint64_t range, std::uint64_t seed = 42)
+    {
+        std::mt19937_64 gen(seed);
+
+        std::vector<std::uint64_t> xs(n);
+        for (auto& x : xs)
+            x = gen() % range + 1;
+        return xs;
+    }
+
+    template <typename Hash>
+    void BM_hash_scalar(benchmark::State& state)
+    {
+        auto keys = random_keys(key_count, ~std::uint64_t { 0 });
+        std::vector<std::uint64_t> hashes(key_count);
+
+        perf_counters counters;
+        for (auto _ : state) {
+            for (std::size_t i = 0; i < key_count; ++i) {
+                hashes[i] = Hash {}(keys[i]);
+                benchmark::DoNotOptimize(hashes[i]);
+            }
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+        state.SetItemsProcessed(state.iterations() * key_count);
+        state.SetBytesProcessed(state.iterations() * key_count * sizeof(std::uint64_t));
+    }
+
+    template <typename Hash, std::size_t VectorSize>
+    void BM_hash_batch(benchmark::State& state)
+    {
+        auto keys = random_keys(key_count, ~std::uint64_t { 0 });
+        std::vector<std::uint64_t> hashes(key_count);
+
+        perf_counters counters;
+        for (auto _ : state) {
+            pure_simd::hash_batch<VectorSize>(keys.data(), key_count, hashes.data(), Hash {});
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+        state.SetItemsProcessed(state.iterations() * key_count);
+        state.SetBytesProcessed(state.iterations() * key_count * sizeof(std::uint64_t));
+    }
+
+    // The first argument is the number of keys in the table, which is half
+    // full. Half of the probes miss.
+    struct probe_data {
+        explicit probe_data(std::size_t build_count)
+            : build(random_keys(build_count, 2 * build_count))
+            , probe(random_keys(key_count, 2 * build_count, 7))
+        {
+        }
+
+        std::vector<std::uint64_t> build;
+        std::vector<std::uint64_t> probe;
+    };
+
+    void BM_hash_probe_unordered_set(benchmark::State& state)
+    {
+        probe_data data(state.range(0));
+        std::unordered_set<std::uint64_t> table(data.build.begin(), data.build.end());
+
+        perf_counters counters;
+        for (auto _ : state) {
+            std::size_t found = 0;
+            for (auto key : data.probe)
+                found += table.count(key);
+            benchmark::DoNotOptimize(found);
+        }
+        counters.report_to(state);
+        state.SetItemsProcessed(state.iterations() * key_count);
+    }
+
+    // VectorSize 1 is plain linear probing, one key and one slot at a time.
+    template <std::size_t VectorSize>
+    void BM_hash_probe_find(benchmark::State& state)
+    {
+        probe_data data(state.range(0));
+
+        std::vector<std::uint64_t> table(2 * data.build.size(), 0);
+        std::vector<std::size_t> slots(std::max(key_count, data.build.size()));
+        pure_simd::hash_table_insert<VectorSize>(table.data(), table.size(), std::uint64_t { 0 }, data.build.data(), data.build.size(), slots.data());
+
+        perf_counters counters;
+        for (auto _ : state) {
+            pure_simd::hash_table_find<VectorSize>(table.data(), table.size(), std::uint64_t { 0 }, data.probe.data(), key_count, slots.data());
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+        state.SetItemsProcessed(state.iterations() * key_count);
+    }
+
+    // The second argument is the number of keys per call, so most blocks of
+    // VectorSize keys are partial, as in a join that probes small batches.
+    template <std::size_t VectorSize>
+    void BM_hash_probe_find_batches(benchmark::State& state)
+    {
+        probe_data data(state.range(0));
+        const auto batch = static_cast<std::size_t>(state.range(1));
+
+        std::vector<std::uint64_t> table(2 * data.build.size(), 0);
+        std::vector<std::size_t> slots(std::max(key_count, data.build.size()));
+        pure_simd::hash_table_insert<VectorSize>(table.data(), table.size(), std::uint64_t { 0 }, data.build.data(), data.build.size(), slots.data());
+
+        perf_counters counters;
+        for (auto _ : state) {
+            for (std::size_t i = 0; i < key_count; i += batch)
+                pure_simd::hash_table_find<VectorSize>(table.data(), table.size(), std::uint64_t { 0 }, data.probe.data() + i, std::min(batch, key_count - i), slots.data() + i);
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+        state.SetItemsProcessed(state.iterations() * key_count);
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_hash_scalar, pure_simd::multiply_shift);
+BENCHMARK_TEMPLATE(BM_hash_batch, pure_simd::multiply_shift, 8);
+BENCHMARK_TEMPLATE(BM_hash_scalar, pure_simd::murmur3_mix);
+BENCHMARK_TEMPLATE(BM_hash_batch, pure_simd::murmur3_mix, 8);
+BENCHMARK_TEMPLATE(BM_hash_scalar, pure_simd::xxhash_mix);
+BENCHMARK_TEMPLATE(BM_hash_batch, pure_simd::xxhash_mix, 8);
+BENCHMARK(BM_hash_probe_unordered_set)->Arg(1 << 12)->Arg(1 << 22);
+BENCHMARK_TEMPLATE(BM_hash_probe_find, 1)->Arg(1 << 12)->Arg(1 << 22);
+BENCHMARK_TEMPLATE(BM_hash_probe_find, 8)->Arg(1 << 12)->Arg(1 << 22);
+BENCHMARK_TEMPLATE(BM_hash_probe_find_batches, 8)->Args({ 1 << 22, 3 })->Args({ 1 << 22, 5 });
@@ -0,0 +1,99 @@
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "perf_counters.hpp"
+#include "pure_simd.hpp"
+
+namespace {
+    constexpr std::size_t key_count = 1 << 20;
+
+    constexpr std::size_t bins = 256;
+
+    // Uniform keys spread the increments over all bins, while skewed keys
+    // (90% of them the same) serialize a scalar loop on a single counter.
+    const std::vector<std::uint8_t>& keys(bool skewed)
+    {
+        static const auto make_keys = [](bool skewed) {
+            std::mt19937 gen(42);
+            std::uniform_int_distribution<> dist(0, bins - 1);
+            std::bernoulli_distribution hot(0.9);
+
+            std::vector<std::uint8_t> keys(key_count);
+            for (auto& key : keys)
+                key = static_cast<std::uint8_t>(skewed && hot(gen) ? 42 : dist(gen));
+            return keys;
+        };
+
+        static const std::vector<std::uint8_t> uniform = make_keys(false);
+        static const std::vector<std::uint8_t> skewed_keys = make_keys(true);
+        return skewed ? skewed_keys : uniform;
+    }
+
+    void set_processed(benchmark::State& state)
+    {
+        state.SetItemsProcessed(state.iterations() * key_count);
+        state.SetBytesProcessed(state.iterations() * key_count * sizeof(std::uint8_t));
+    }
+
+    void BM_histogram_scalar(benchmark::State& state)
+    {
+        const auto& src = keys(state.range(0));
+        std::vector<std::size_t> out(bins);
+
+        perf_counters counters;
+        for (auto _ : state) {
+            std::fill(out.begin(), out.end(), 0);
+            for (auto key : src)
+                ++out[key];
+
+            benchmark::DoNotOptimize(out.data());
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+        set_processed(state);
+    }
+
+    template <std::size_t VectorSize>
+    void BM_histogram_pure_simd(benchmark::State& state)
+    {
+        const auto& src = keys(state.range(0));
+        std::vector<std::size_t> out(bins);
+
+        perf_counters counters;
+        for (auto _ : state) {
+            pure_simd::histogram<VectorSize>(src.data(), src.size(), bins, out.data());
+
+            benchmark::DoNotOptimize(out.data());
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+        set_processed(state);
+    }
+
+    template <std::size_t VectorSize>
+    void BM_histogram_pure_simd_threads(benchmark::State& state)
+    {
+        const auto& src = keys(state.range(0));
+        std::vector<std::size_t> out(bins);
+
+        perf_counters counters;
+        for (auto _ : state) {
+            pure_simd::histogram<VectorSize>(src.data(), src.size(), bins, out.data(), state.range(1));
+
+            benchmark::DoNotOptimize(out.data());
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+        set_processed(state);
+    }
+}
+
+// The first argument selects skewed keys.
+BENCHMARK(BM_histogram_scalar)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_histogram_pure_simd, 4)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_histogram_pure_simd, 8)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_histogram_pure_simd, 16)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_histogram_pure_simd_threads, 8)->Args({ 0, 4 })->Args({ 1, 4 })->UseRealTime();
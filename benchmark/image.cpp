@@ -0,0 +1,156 @@
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "image.hpp"
+#include "perf_counters.hpp"
+
+namespace {
+    constexpr std::size_t pixel_count = IMAGE_WIDTH * IMAGE_HEIGHT;
+
+    const std::vector<std::uint32_t>& pixels()
+    {
+        static const auto result = [] {
+            std::mt19937 gen(42);
+            std::uniform_int_distribution<std::uint32_t> dist;
+
+            std::vector<std::uint32_t> pixels(pixel_count);
+            for (auto& pixel : pixels)
+                pixel = dist(gen);
+
+            std::vector<std::uint32_t> premultiplied(pixel_count);
+            scalar_premultiply(pixels.data(), pixel_count, premultiplied.data());
+            return premultiplied;
+        }();
+        return result;
+    }
+
+    // Items are source pixels, so items_per_second reads as pixels/s.
+    template <typename F>
+    void run(benchmark::State& state, F func)
+    {
+        perf_counters counters;
+        for (auto _ : state) {
+            func();
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+
+        state.SetItemsProcessed(state.iterations() * pixel_count);
+        state.SetBytesProcessed(state.iterations() * pixel_count * sizeof(std::uint32_t));
+    }
+
+    // The kind selects the scalar loop (0) or the pure_simd kernel with
+    // VectorSize lanes.
+    template <std::size_t VectorSize>
+    void BM_image_blend(benchmark::State& state)
+    {
+        std::vector<std::uint32_t> dst(pixels().rbegin(), pixels().rend());
+        run(state, [&] {
+            if constexpr (VectorSize == 0)
+                scalar_blend(pixels().data(), pixel_count, dst.data());
+            else
+                pure_simd_blend<VectorSize>(pixels().data(), pixel_count, dst.data());
+        });
+    }
+
+    template <std::size_t VectorSize>
+    void BM_image_premultiply(benchmark::State& state)
+    {
+        std::vector<std::uint32_t> dst(pixel_count);
+        run(state, [&] {
+            if constexpr (VectorSize == 0)
+                scalar_premultiply(pixels().data(), pixel_count, dst.data());
+            else
+                pure_simd_premultiply<VectorSize>(pixels().data(), pixel_count, dst.data());
+        });
+    }
+
+    template <std::size_t VectorSize>
+    void BM_image_rgba_to_gray(benchmark::State& state)
+    {
+        std::vector<std::uint8_t> gray(pixel_count);
+        run(state, [&] {
+            if constexpr (VectorSize == 0)
+                scalar_rgba_to_gray(pixels().data(), pixel_count, gray.data());
+            else
+                pure_simd_rgba_to_gray<VectorSize>(pixels().data(), pixel_count, gray.data());
+        });
+    }
+
+    template <std::size_t VectorSize>
+    void BM_image_rgba_to_yuv(benchmark::State& state)
+    {
+        std::vector<std::uint8_t> y(pixel_count), u(pixel_count), v(pixel_count);
+        run(state, [&] {
+            if constexpr (VectorSize == 0)
+                scalar_rgba_to_yuv(pixels().data(), pixel_count, y.data(), u.data(), v.data());
+            else
+                pure_simd_rgba_to_yuv<VectorSize>(pixels().data(), pixel_count, y.data(), u.data(), v.data());
+        });
+    }
+
+    template <std::size_t VectorSize>
+    void BM_image_yuv_to_rgba(benchmark::State& state)
+    {
+        std::vector<std::uint8_t> y(pixel_count), u(pixel_count), v(pixel_count);
+        scalar_rgba_to_yuv(pixels().data(), pixel_count, y.data(), u.data(), v.data());
+
+        std::vector<std::uint32_t> dst(pixel_count);
+        run(state, [&] {
+            if constexpr (VectorSize == 0)
+                scalar_yuv_to_rgba(y.data(), u.data(), v.data(), pixel_count, dst.data());
+            else
+                pure_simd_yuv_to_rgba<VectorSize>(y.data(), u.data(), v.data(), pixel_count, dst.data());
+        });
+    }
+
+    // Downscales to 60% of the size, as for a thumbnail.
+    template <std::size_t VectorSize>
+    void BM_image_resize_bilinear(benchmark::State& state)
+    {
+        constexpr std::size_t width = IMAGE_WIDTH * 3 / 5;
+        constexpr std::size_t height = IMAGE_HEIGHT * 3 / 5;
+
+        std::vector<std::uint32_t> dst(width * height);
+        run(state, [&] {
+            if constexpr (VectorSize == 0)
+                scalar_resize_bilinear(pixels().data(), IMAGE_WIDTH, IMAGE_HEIGHT, dst.data(), width, height);
+            else
+                pure_simd_resize_bilinear<VectorSize>(pixels().data(), IMAGE_WIDTH, IMAGE_HEIGHT, dst.data(), width, height);
+        });
+    }
+
+    // The conversions around the kernels for 3-byte RGB images.
+    void BM_image_rgb_to_rgba(benchmark::State& state)
+    {
+        std::vector<std::uint8_t> rgb(3 * pixel_count);
+        rgba_to_rgb(pixels().data(), pixel_count, rgb.data());
+
+        std::vector<std::uint32_t> dst(pixel_count);
+        run(state, [&] { rgb_to_rgba(rgb.data(), pixel_count, dst.data()); });
+    }
+
+    void BM_image_rgba_to_rgb(benchmark::State& state)
+    {
+        std::vector<std::uint8_t> rgb(3 * pixel_count);
+        run(state, [&] { rgba_to_rgb(pixels().data(), pixel_count, rgb.data()); });
+    }
+}
+
+#define BENCHMARK_IMAGE_KERNEL(name)         \
+    BENCHMARK_TEMPLATE(BM_image_##name, 0);  \
+    BENCHMARK_TEMPLATE(BM_image_##name, 8);  \
+    BENCHMARK_TEMPLATE(BM_image_##name, 16); \
+    BENCHMARK_TEMPLATE(BM_image_##name, 32)
+
+BENCHMARK_IMAGE_KERNEL(blend);
+BENCHMARK_IMAGE_KERNEL(premultiply);
+BENCHMARK_IMAGE_KERNEL(rgba_to_gray);
+BENCHMARK_IMAGE_KERNEL(rgba_to_yuv);
+BENCHMARK_IMAGE_KERNEL(yuv_to_rgba);
+BENCHMARK_IMAGE_KERNEL(resize_bilinear);
+BENCHMARK(BM_image_rgb_to_rgba);
+BENCHMARK(BM_image_rgba_to_rgb);
@@ -0,0 +1,65 @@
+#include <algorithm>
+#include <numeric>
+
+#include "benchmark/benchmark.h"
+
+#include "mandelbrot.hpp"
+#include "perf_counters.hpp"
+
+namespace {
+    // Reports pixels and the iterations spent on them, the work actually done.
+    void set_processed(benchmark::State& state, const std::vector<int>& buffer)
+    {
+        auto iterations = std::accumulate(buffer.begin(), buffer.end(), std::size_t {});
+
+        state.SetItemsProcessed(state.iterations() * MANDELBROT_WIDTH * MANDELBROT_HEIGHT);
+        state.SetBytesProcessed(state.iterations() * MANDELBROT_WIDTH * MANDELBROT_HEIGHT * sizeof(int));
+        state.counters["escape_iterations"] = benchmark::Counter(
+            static_cast<double>(state.iterations() * iterations), benchmark::Counter::kIsRate);
+    }
+}
+
+void BM_mandelbrot_scalar_mandelbrot(benchmark::State& state)
+{
+    std::vector<int> buffer(MANDELBROT_WIDTH * MANDELBROT_HEIGHT, 0);
+
+    perf_counters counters;
+    for (auto _ : state) {
+        scalar_mandelbrot(buffer.data());
+        benchmark::ClobberMemory();
+    }
+    counters.report_to(state);
+    set_processed(state, buffer);
+}
+BENCHMARK(BM_mandelbrot_scalar_mandelbrot)->Unit(benchmark::kMillisecond);
+
+#define BENCHMARK_FOR(func_name, size)                                   \
+    void BM_mandelbrot_##func_name##_##size(benchmark::State& state)     \
+    {                                                                    \
+        std::vector<int> buffer(MANDELBROT_WIDTH* MANDELBROT_HEIGHT, 0); \
+                                                                         \
+        perf_counters counters;                                          \
+        for (auto _ : state) {                                           \
+            func_name<size>(buffer.data());                              \
+            benchmark::ClobberMemory();                                  \
+        }                                                                \
+        counters.report_to(state);                                       \
+        set_processed(state, buffer);                                    \
+    }                                                                    \
+    BENCHMARK(BM_mandelbrot_##func_name##_##size)->Unit(benchmark::kMillisecond)
+
+BENCHMARK_FOR(pure_simd_mandelbrot, 4);
+
+BENCHMARK_FOR(pure_simd_mandelbrot, 8);
+
+BENCHMARK_FOR(pure_simd_mandelbrot, 16);
+
+BENCHMARK_FOR(pure_simd_mandelbrot, 32);
+
+BENCHMARK_FOR(pure_simd_mandelbrot_persistent, 4);
+
+BENCHMARK_FOR(pure_simd_mandelbrot_persistent, 8);
+
+BENCHMARK_FOR(pure_simd_mandelbrot_persistent, 16);
+
+BENCHMARK_FOR(pure_simd_mandelbrot_persistent, 32);
@@ -0,0 +1,145 @@
+#include "perf_counters.hpp"
+
+#if defined(PURE_SIMD_PERF_COUNTERS) && defined(__linux__)
+
+#include <cstring>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+    constexpr std::uint64_t cache_event(std::uint64_t cache, std::uint64_t op, std::uint64_t result)
+    {
+        return cache | (op << 8) | (result << 16);
+    }
+
+    // FP_ARITH_INST_RETIRED (event 0xC7), the umask selects the vector width.
+    constexpr std::uint64_t fp_arith_event(std::uint64_t umask)
+    {
+        return 0xC7 | (umask << 8);
+    }
+
+    struct event_config {
+        std::uint32_t type;
+        std::uint64_t config;
+        const char* name;
+    };
+
+    const std::array<event_config, perf_counters::event_count>& event_configs()
+    {
+        static const std::array<event_config, perf_counters::event_count> configs { {
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, "cycles" },
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, "instructions" },
+            { PERF_TYPE_HW_CACHE, cache_event(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS), "L1D_misses" },
+            { PERF_TYPE_HW_CACHE, cache_event(PERF_COUNT_HW_CACHE_LL, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS), "LLC_misses" },
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, "branch_misses" },
+            { PERF_TYPE_RAW, fp_arith_event(0x03), "fp_scalar" },
+            { PERF_TYPE_RAW, fp_arith_event(0x0C), "fp_128b" },
+            { PERF_TYPE_RAW, fp_arith_event(0x30), "fp_256b" },
+            { PERF_TYPE_RAW, fp_arith_event(0xC0), "fp_512b" },
+        } };
+        return configs;
+    }
+
+    int open_event(const event_config& event)
+    {
+        // The raw FP events are only meaningful on Intel cores.
+        if (event.type == PERF_TYPE_RAW && !__builtin_cpu_is("intel"))
+            return -1;
+
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = event.type;
+        attr.config = event.config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+}
+
+perf_counters::perf_counters()
+{
+    values_.fill(0.0);
+
+    for (int i = 0; i < event_count; ++i)
+        fds_[i] = open_event(event_configs()[i]);
+
+    for (int fd : fds_) {
+        if (fd >= 0) {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+}
+
+perf_counters::~perf_counters()
+{
+    for (int fd : fds_) {
+        if (fd >= 0)
+            close(fd);
+    }
+}
+
+void perf_counters::stop()
+{
+    if (stopped_)
+        return;
+
+    stopped_ = true;
+
+    for (int fd : fds_) {
+        if (fd >= 0)
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+
+    for (int i = 0; i < event_count; ++i) {
+        if (fds_[i] < 0)
+            continue;
+
+        // { value, time_enabled, time_running }
+        std::uint64_t data[3] {};
+        if (read(fds_[i], data, sizeof(data)) != sizeof(data) || data[2] == 0) {
+            close(fds_[i]);
+            fds_[i] = -1;
+            continue;
+        }
+
+        // Scale up when the kernel multiplexed the counter.
+        values_[i] = static_cast<double>(data[0]) * data[1] / data[2];
+    }
+}
+
+void perf_counters::report_to(benchmark::State& state)
+{
+    stop();
+
+    for (int i = 0; i < event_count; ++i) {
+        if (fds_[i] >= 0)
+            state.counters[event_configs()[i].name] = benchmark::Counter(values_[i], benchmark::Counter::kAvgIterations);
+    }
+
+    if (fds_[cycles] >= 0 && fds_[instructions] >= 0 && values_[cycles] > 0)
+        state.counters["IPC"] = values_[instructions] / values_[cycles];
+}
+
+#else
+
+perf_counters::perf_counters()
+{
+    fds_.fill(-1);
+    values_.fill(0.0);
+}
+
+perf_counters::~perf_counters() {}
+
+void perf_counters::stop() { stopped_ = true; }
+
+void perf_counters::report_to(benchmark::State&) { stop(); }
+
+#endif
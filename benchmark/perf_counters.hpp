@@ -0,0 +1,59 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <array>
+#include <cstdint>
+
+#include "benchmark/benchmark.h"
+
+// Hardware performance counters reported as benchmark user counters.
+//
+// The collector is only compiled in when PURE_SIMD_PERF_COUNTERS is defined
+// (see the option of the same name in CMakeLists.txt) and the target is Linux.
+// Events the kernel or the CPU refuses to open are silently left out, so the
+// benchmarks keep running under containers and restrictive perf_event_paranoid
+// settings.
+//
+// Usage:
+//
+//     perf_counters counters;
+//     for (auto _ : state) { ... }
+//     counters.report_to(state);
+class perf_counters {
+public:
+    enum event {
+        cycles,
+        instructions,
+        l1d_misses,
+        llc_misses,
+        branch_misses,
+        // FP_ARITH_INST_RETIRED.* on Intel, counted as operations per width.
+        fp_scalar,
+        fp_128,
+        fp_256,
+        fp_512,
+        event_count
+    };
+
+    perf_counters();
+
+    perf_counters(const perf_counters&) = delete;
+
+    perf_counters& operator=(const perf_counters&) = delete;
+
+    ~perf_counters();
+
+    // Stops counting and adds the per-iteration averages to `state.counters`.
+    void report_to(benchmark::State& state);
+
+private:
+    void stop();
+
+    std::array<int, event_count> fds_;
+
+    std::array<double, event_count> values_;
+
+    bool stopped_ = false;
+};
+
+#endif /* PERF_COUNTERS_H */
@@ -0,0 +1,157 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "perf_counters.hpp"
+#include "pure_simd.hpp"
+
+namespace {
+    constexpr std::size_t sample_count = 1 << 16;
+
+    std::vector<float> random_samples(std::size_t n)
+    {
+        std::mt19937_64 gen(42);
+        std::uniform_real_distribution<float> dist(0.0f, 4.0f);
+
+        std::vector<float> xs(n);
+        for (auto& x : xs)
+            x = dist(gen);
+        return xs;
+    }
+
+    std::vector<float> sine_table(std::size_t size)
+    {
+        std::vector<float> table(size);
+        for (std::size_t i = 0; i < size; ++i)
+            table[i] = std::sin(4.0f * i / (size - 1));
+        return table;
+    }
+
+    // 64 cubic segments, random enough that nothing folds.
+    std::vector<float> cubic_segments()
+    {
+        std::mt19937_64 gen(7);
+        std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+        std::vector<float> coefficients(64 * 4);
+        for (auto& c : coefficients)
+            c = dist(gen);
+        return coefficients;
+    }
+
+    // The piecewise curve as a scalar loop would apply it: the segment by a
+    // search among its breakpoints, then the polynomial in the segment.
+    float scalar_piecewise(const std::vector<float>& breakpoints, const float* coefficients, float x)
+    {
+        auto i = std::upper_bound(breakpoints.begin() + 1, breakpoints.end() - 1, x) - breakpoints.begin() - 1;
+        float u = (x - breakpoints[i]) / (breakpoints[i + 1] - breakpoints[i]);
+        const float* c = coefficients + 4 * i;
+        return c[0] + u * (c[1] + u * (c[2] + u * c[3]));
+    }
+
+    template <typename F>
+    void run_calibration(benchmark::State& state, F apply)
+    {
+        auto xs = random_samples(sample_count);
+        std::vector<float> out(sample_count);
+
+        perf_counters counters;
+        for (auto _ : state) {
+            apply(xs.data(), sample_count, out.data());
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+        state.SetItemsProcessed(state.iterations() * sample_count);
+    }
+
+    // A degree-7 polynomial, the odd Taylor terms of sin.
+    void BM_polynomial_scalar_horner(benchmark::State& state)
+    {
+        run_calibration(state, [](const float* xs, std::size_t n, float* out) {
+            for (std::size_t i = 0; i < n; ++i) {
+                float x = xs[i];
+                out[i] = x * (1.0f + x * x * (-1.0f / 6 + x * x * (1.0f / 120 + x * x * (-1.0f / 5040))));
+            }
+        });
+    }
+
+    template <std::size_t VectorSize>
+    void BM_polynomial_horner(benchmark::State& state)
+    {
+        run_calibration(state, [](const float* xs, std::size_t n, float* out) {
+            pure_simd::calibrate<VectorSize>(xs, n, out, [](auto x) {
+                return pure_simd::horner(x, 0.0f, 1.0f, 0.0f, -1.0f / 6, 0.0f, 1.0f / 120, 0.0f, -1.0f / 5040);
+            });
+        });
+    }
+
+    template <std::size_t VectorSize>
+    void BM_polynomial_estrin(benchmark::State& state)
+    {
+        run_calibration(state, [](const float* xs, std::size_t n, float* out) {
+            pure_simd::calibrate<VectorSize>(xs, n, out, [](auto x) {
+                return pure_simd::estrin(x, 0.0f, 1.0f, 0.0f, -1.0f / 6, 0.0f, 1.0f / 120, 0.0f, -1.0f / 5040);
+            });
+        });
+    }
+
+    // The first argument is the number of table entries.
+    void BM_polynomial_scalar_lut(benchmark::State& state)
+    {
+        auto table = sine_table(state.range(0));
+        run_calibration(state, [&](const float* xs, std::size_t n, float* out) {
+            for (std::size_t i = 0; i < n; ++i) {
+                float t = std::clamp(xs[i] * ((table.size() - 1) / 4.0f), 0.0f, table.size() - 1.0f);
+                auto j = std::min(static_cast<std::size_t>(t), table.size() - 2);
+                out[i] = table[j] + (t - j) * (table[j + 1] - table[j]);
+            }
+        });
+    }
+
+    template <std::size_t VectorSize, pure_simd::interpolation Mode>
+    void BM_polynomial_lut(benchmark::State& state)
+    {
+        auto table = sine_table(state.range(0));
+        run_calibration(state, [&](const float* xs, std::size_t n, float* out) {
+            pure_simd::calibrate<VectorSize>(xs, n, out, [&](auto x) {
+                return pure_simd::lut_interpolate<Mode>(table.data(), table.size(), 0.0f, 4.0f, x);
+            });
+        });
+    }
+
+    void BM_polynomial_scalar_piecewise(benchmark::State& state)
+    {
+        auto coefficients = cubic_segments();
+        std::vector<float> breakpoints(65);
+        for (std::size_t i = 0; i < breakpoints.size(); ++i)
+            breakpoints[i] = 4.0f * i / 64;
+
+        run_calibration(state, [&](const float* xs, std::size_t n, float* out) {
+            for (std::size_t i = 0; i < n; ++i)
+                out[i] = scalar_piecewise(breakpoints, coefficients.data(), xs[i]);
+        });
+    }
+
+    template <std::size_t VectorSize>
+    void BM_polynomial_piecewise(benchmark::State& state)
+    {
+        auto coefficients = cubic_segments();
+        pure_simd::piecewise_polynomial<3, float> curve { coefficients.data(), 64, 0.0f, 4.0f };
+        run_calibration(state, [&](const float* xs, std::size_t n, float* out) {
+            pure_simd::calibrate<VectorSize>(xs, n, out, curve);
+        });
+    }
+}
+
+BENCHMARK(BM_polynomial_scalar_horner);
+BENCHMARK_TEMPLATE(BM_polynomial_horner, 16);
+BENCHMARK_TEMPLATE(BM_polynomial_estrin, 16);
+BENCHMARK(BM_polynomial_scalar_lut)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_polynomial_lut, 16, pure_simd::interpolation::linear)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_polynomial_lut, 16, pure_simd::interpolation::cubic)->Arg(1024);
+BENCHMARK(BM_polynomial_scalar_piecewise);
+BENCHMARK_TEMPLATE(BM_polynomial_piecewise, 8);
+BENCHMARK_TEMPLATE(BM_polynomial_piecewise, 16);
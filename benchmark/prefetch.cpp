@@ -0,0 +1,98 @@
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "perf_counters.hpp"
+#include "pure_simd.hpp"
+
+namespace {
+    // 256 MiB of floats, far beyond the last-level cache.
+    constexpr std::size_t table_size = std::size_t(64) << 20;
+
+    constexpr std::size_t output_count = std::size_t(1) << 20;
+
+    const std::vector<float>& table()
+    {
+        static const std::vector<float> result(table_size, 1.0f);
+        return result;
+    }
+
+    const std::vector<std::uint32_t>& random_indices()
+    {
+        static const auto result = [] {
+            std::mt19937 gen(42);
+            std::uniform_int_distribution<std::uint32_t> dist(0, table_size - 1);
+
+            std::vector<std::uint32_t> indices(output_count);
+            for (auto& index : indices)
+                index = dist(gen);
+            return indices;
+        }();
+        return result;
+    }
+
+    // The first argument is the distance in vectors, -1 selects prefetch_auto.
+    pure_simd::prefetch_options options_of(benchmark::State& state)
+    {
+        if (state.range(0) < 0)
+            return pure_simd::prefetch_auto();
+        return pure_simd::prefetch_vectors(state.range(0));
+    }
+
+    void set_processed(benchmark::State& state)
+    {
+        state.SetItemsProcessed(state.iterations() * output_count);
+        state.SetBytesProcessed(state.iterations() * output_count * sizeof(float));
+    }
+
+    template <std::size_t VectorSize>
+    void BM_prefetch_gather(benchmark::State& state)
+    {
+        const auto options = options_of(state);
+        std::vector<float> dst(output_count);
+
+        perf_counters counters;
+        for (auto _ : state) {
+            pure_simd::gather<VectorSize>(table().data(), random_indices().data(), output_count, dst.data(), options);
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+        set_processed(state);
+    }
+
+    // Strides of 61 floats skip a few lines, which defeats the adjacent-line
+    // prefetcher without lining up with the page size.
+    template <std::size_t VectorSize>
+    void BM_prefetch_gather_strided(benchmark::State& state)
+    {
+        const auto options = options_of(state);
+        std::vector<float> dst(output_count);
+
+        perf_counters counters;
+        for (auto _ : state) {
+            pure_simd::gather_strided<VectorSize>(table().data(), 61, output_count, dst.data(), options);
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+        set_processed(state);
+    }
+
+    template <std::size_t VectorSize>
+    void BM_prefetch_accumulate(benchmark::State& state)
+    {
+        const auto options = options_of(state);
+
+        perf_counters counters;
+        for (auto _ : state)
+            benchmark::DoNotOptimize(pure_simd::accumulate<VectorSize>(table().data(), table_size, 0.0f, options));
+        counters.report_to(state);
+
+        state.SetItemsProcessed(state.iterations() * table_size);
+        state.SetBytesProcessed(state.iterations() * table_size * sizeof(float));
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_prefetch_gather, 8)->Arg(0)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Arg(16)->Arg(32)->Arg(-1);
+BENCHMARK_TEMPLATE(BM_prefetch_gather_strided, 8)->Arg(0)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Arg(16)->Arg(32)->Arg(-1);
+BENCHMARK_TEMPLATE(BM_prefetch_accumulate, 16)->Arg(0)->Arg(4)->Arg(16)->Arg(64)->Arg(-1)->Unit(benchmark::kMillisecond);
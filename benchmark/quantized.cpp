@@ -0,0 +1,96 @@
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "perf_counters.hpp"
+#include "pure_simd.hpp"
+
+namespace {
+    template <typename T>
+    std::vector<T> random_values(std::size_t n, std::uint64_t seed)
+    {
+        std::mt19937_64 gen(seed);
+
+        std::vector<T> xs(n);
+        for (auto& x : xs)
+            x = static_cast<T>(static_cast<std::int8_t>(gen()));
+        return xs;
+    }
+
+    // The first argument is the length of the vectors.
+    void BM_quantized_dot_float(benchmark::State& state)
+    {
+        std::size_t n = state.range(0);
+        auto a = random_values<float>(n, 1);
+        auto b = random_values<float>(n, 2);
+
+        perf_counters counters;
+        for (auto _ : state) {
+            auto sums = pure_simd::inner_product<16>(a.data(), n, b.data(), 0.0f);
+            benchmark::DoNotOptimize(pure_simd::sum(sums, 0.0f));
+        }
+        counters.report_to(state);
+        state.SetItemsProcessed(state.iterations() * n);
+    }
+
+    template <typename A, typename B>
+    void BM_quantized_dot(benchmark::State& state)
+    {
+        std::size_t n = state.range(0);
+        auto a = random_values<A>(n, 1);
+        auto b = random_values<B>(n, 2);
+
+        perf_counters counters;
+        for (auto _ : state)
+            benchmark::DoNotOptimize(pure_simd::quantized_dot(a.data(), b.data(), n));
+        counters.report_to(state);
+        state.SetItemsProcessed(state.iterations() * n);
+    }
+
+    // The arguments are the rows and the columns of the matrix.
+    void BM_quantized_gemv_float(benchmark::State& state)
+    {
+        std::size_t rows = state.range(0);
+        std::size_t cols = state.range(1);
+        auto matrix = random_values<float>(rows * cols, 1);
+        auto x = random_values<float>(cols, 2);
+        std::vector<float> out(rows);
+
+        perf_counters counters;
+        for (auto _ : state) {
+            for (std::size_t r = 0; r < rows; ++r)
+                out[r] = pure_simd::sum(pure_simd::inner_product<16>(matrix.data() + r * cols, cols, x.data(), 0.0f), 0.0f);
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+        state.SetItemsProcessed(state.iterations() * rows * cols);
+    }
+
+    template <typename A, typename B>
+    void BM_quantized_gemv(benchmark::State& state)
+    {
+        std::size_t rows = state.range(0);
+        std::size_t cols = state.range(1);
+        auto matrix = random_values<A>(rows * cols, 1);
+        auto x = random_values<B>(cols, 2);
+        std::vector<float> scales(rows, 0.01f);
+        std::vector<float> out(rows);
+
+        perf_counters counters;
+        for (auto _ : state) {
+            pure_simd::quantized_gemv(matrix.data(), rows, cols, x.data(), scales.data(), out.data());
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+        state.SetItemsProcessed(state.iterations() * rows * cols);
+    }
+}
+
+BENCHMARK(BM_quantized_dot_float)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_quantized_dot, std::int8_t, std::int8_t)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_quantized_dot, std::uint8_t, std::int8_t)->Arg(4096);
+BENCHMARK(BM_quantized_gemv_float)->Args({ 256, 1024 })->Args({ 1024, 4096 });
+BENCHMARK_TEMPLATE(BM_quantized_gemv, std::int8_t, std::int8_t)->Args({ 256, 1024 })->Args({ 1024, 4096 });
+BENCHMARK_TEMPLATE(BM_quantized_gemv, std::int8_t, std::uint8_t)->Args({ 256, 1024 })->Args({ 1024, 4096 });
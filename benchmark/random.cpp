@@ -0,0 +1,96 @@
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "perf_counters.hpp"
+#include "pure_simd.hpp"
+
+namespace {
+    // 1 MiB of floats, which stays in L2, so the generators are the bottleneck.
+    constexpr std::size_t element_count = std::size_t(1) << 18;
+
+    template <typename T>
+    void set_processed(benchmark::State& state)
+    {
+        state.SetItemsProcessed(state.iterations() * element_count);
+        state.SetBytesProcessed(state.iterations() * element_count * sizeof(T));
+    }
+
+    // The <random> engines, one value at a time.
+    template <typename Engine, typename Distribution>
+    void BM_random_std(benchmark::State& state)
+    {
+        using T = typename Distribution::result_type;
+
+        Engine gen(42);
+        Distribution dist;
+        std::vector<T> xs(element_count);
+
+        perf_counters counters;
+        for (auto _ : state) {
+            for (auto& x : xs)
+                x = dist(gen);
+            benchmark::DoNotOptimize(xs.data());
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+        set_processed<T>(state);
+    }
+
+    template <typename Engine, typename Distribution>
+    void BM_random_pure_simd(benchmark::State& state)
+    {
+        using T = std::remove_cv_t<std::remove_reference_t<decltype(Distribution {}(std::declval<Engine&>())[0])>>;
+
+        Engine gen(42);
+        std::vector<T> xs(element_count);
+
+        perf_counters counters;
+        for (auto _ : state) {
+            pure_simd::fill_random(xs.data(), element_count, gen, Distribution {});
+            benchmark::DoNotOptimize(xs.data());
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+        set_processed<T>(state);
+    }
+
+    // 64 MiB of floats split among threads by counter.
+    template <std::size_t VectorSize>
+    void BM_random_pure_simd_threads(benchmark::State& state)
+    {
+        const std::size_t n = std::size_t(16) << 20;
+        const std::size_t threads = state.range(0);
+
+        pure_simd::philox<VectorSize> gen(42);
+        std::vector<float> xs(n);
+
+        perf_counters counters;
+        for (auto _ : state) {
+            pure_simd::fill_random(xs.data(), n, gen, pure_simd::normal<float> {}, threads);
+            benchmark::DoNotOptimize(xs.data());
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+
+        state.SetItemsProcessed(state.iterations() * n);
+        state.SetBytesProcessed(state.iterations() * n * sizeof(float));
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_random_std, std::mt19937, std::uniform_int_distribution<std::uint32_t>);
+BENCHMARK_TEMPLATE(BM_random_std, std::mt19937, std::uniform_real_distribution<float>);
+BENCHMARK_TEMPLATE(BM_random_std, std::mt19937_64, std::uniform_real_distribution<double>);
+BENCHMARK_TEMPLATE(BM_random_std, std::mt19937, std::normal_distribution<float>);
+BENCHMARK_TEMPLATE(BM_random_std, std::mt19937_64, std::normal_distribution<double>);
+
+BENCHMARK_TEMPLATE(BM_random_pure_simd, pure_simd::philox<16>, pure_simd::uniform_bits<std::uint32_t>);
+BENCHMARK_TEMPLATE(BM_random_pure_simd, pure_simd::philox<32>, pure_simd::uniform_bits<std::uint32_t>);
+BENCHMARK_TEMPLATE(BM_random_pure_simd, pure_simd::xoshiro256pp<4>, pure_simd::uniform_bits<std::uint64_t>);
+BENCHMARK_TEMPLATE(BM_random_pure_simd, pure_simd::xoshiro256pp<8>, pure_simd::uniform_bits<std::uint64_t>);
+BENCHMARK_TEMPLATE(BM_random_pure_simd, pure_simd::philox<16>, pure_simd::uniform_real<float>);
+BENCHMARK_TEMPLATE(BM_random_pure_simd, pure_simd::xoshiro256pp<8>, pure_simd::uniform_real<double>);
+BENCHMARK_TEMPLATE(BM_random_pure_simd, pure_simd::philox<16>, pure_simd::normal<float>);
+BENCHMARK_TEMPLATE(BM_random_pure_simd, pure_simd::xoshiro256pp<8>, pure_simd::normal<double>);
+BENCHMARK_TEMPLATE(BM_random_pure_simd_threads, 16)->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
@@ -0,0 +1,102 @@
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "perf_counters.hpp"
+#include "pure_simd.hpp"
+
+namespace {
+    constexpr std::size_t value_count = 1 << 20;
+
+    const std::vector<float>& values()
+    {
+        static const std::vector<float> xs = [] {
+            std::mt19937 gen(42);
+            std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+            std::vector<float> xs(value_count);
+            for (auto& x : xs)
+                x = dist(gen);
+            return xs;
+        }();
+        return xs;
+    }
+
+    void set_processed(benchmark::State& state, std::size_t sources = 1)
+    {
+        state.SetItemsProcessed(state.iterations() * value_count);
+        state.SetBytesProcessed(state.iterations() * value_count * sources * sizeof(float));
+    }
+
+    void BM_reduce_std_accumulate(benchmark::State& state)
+    {
+        const auto& xs = values();
+
+        perf_counters counters;
+        for (auto _ : state)
+            benchmark::DoNotOptimize(std::accumulate(xs.begin(), xs.end(), 0.0f));
+        counters.report_to(state);
+        set_processed(state);
+    }
+
+    // The vector of partial sums depends on VectorSize.
+    template <std::size_t VectorSize, typename T>
+    void BM_reduce_accumulate(benchmark::State& state)
+    {
+        const auto& xs = values();
+
+        perf_counters counters;
+        for (auto _ : state)
+            benchmark::DoNotOptimize(pure_simd::sum(pure_simd::accumulate<VectorSize>(xs.data(), xs.size(), T {}), T {}));
+        counters.report_to(state);
+        set_processed(state);
+    }
+
+#define DEFINE_REDUCE_BENCHMARK_FOR(mode)                                                                             \
+    template <std::size_t VectorSize>                                                                                 \
+    void BM_reduce_accumulate_##mode(benchmark::State& state)                                                         \
+    {                                                                                                                 \
+        const auto& xs = values();                                                                                    \
+                                                                                                                      \
+        perf_counters counters;                                                                                       \
+        for (auto _ : state)                                                                                          \
+            benchmark::DoNotOptimize(pure_simd::accumulate<VectorSize>(xs.data(), xs.size(), 0.0f, pure_simd::mode)); \
+        counters.report_to(state);                                                                                    \
+        set_processed(state);                                                                                         \
+    }                                                                                                                 \
+                                                                                                                      \
+    template <std::size_t VectorSize>                                                                                 \
+    void BM_reduce_inner_product_##mode(benchmark::State& state)                                                      \
+    {                                                                                                                 \
+        const auto& xs = values();                                                                                    \
+                                                                                                                      \
+        perf_counters counters;                                                                                       \
+        for (auto _ : state)                                                                                          \
+            benchmark::DoNotOptimize(                                                                                 \
+                pure_simd::inner_product<VectorSize>(xs.data(), xs.size(), xs.data(), 0.0f, pure_simd::mode));        \
+        counters.report_to(state);                                                                                    \
+        set_processed(state, 2);                                                                                      \
+    }
+
+    DEFINE_REDUCE_BENCHMARK_FOR(pairwise)
+    DEFINE_REDUCE_BENCHMARK_FOR(kahan)
+    DEFINE_REDUCE_BENCHMARK_FOR(neumaier)
+}
+
+BENCHMARK(BM_reduce_std_accumulate);
+BENCHMARK_TEMPLATE(BM_reduce_accumulate, 16, float);
+BENCHMARK_TEMPLATE(BM_reduce_accumulate, 8, double);
+BENCHMARK_TEMPLATE(BM_reduce_accumulate, 16, double);
+
+BENCHMARK_TEMPLATE(BM_reduce_accumulate_pairwise, 8);
+BENCHMARK_TEMPLATE(BM_reduce_accumulate_pairwise, 16);
+BENCHMARK_TEMPLATE(BM_reduce_accumulate_kahan, 8);
+BENCHMARK_TEMPLATE(BM_reduce_accumulate_kahan, 16);
+BENCHMARK_TEMPLATE(BM_reduce_accumulate_neumaier, 8);
+BENCHMARK_TEMPLATE(BM_reduce_accumulate_neumaier, 16);
+
+BENCHMARK_TEMPLATE(BM_reduce_inner_product_pairwise, 8);
+BENCHMARK_TEMPLATE(BM_reduce_inner_product_kahan, 8);
+BENCHMARK_TEMPLATE(BM_reduce_inner_product_neumaier, 8);
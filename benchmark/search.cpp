@@ -0,0 +1,93 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "perf_counters.hpp"
+#include "pure_simd.hpp"
+
+namespace {
+    constexpr std::size_t query_count = std::size_t(1) << 14;
+
+    // Timestamps in microseconds, as in a time-series index.
+    std::vector<std::int64_t> random_timestamps(std::size_t n, std::uint64_t seed)
+    {
+        std::mt19937_64 gen(seed);
+        std::uniform_int_distribution<std::int64_t> dist(0, std::int64_t { 1 } << 45);
+
+        std::vector<std::int64_t> xs(n);
+        for (auto& x : xs)
+            x = dist(gen);
+        return xs;
+    }
+
+    // The first argument is the number of sorted values.
+    struct search_data {
+        explicit search_data(std::size_t n)
+            : sorted(random_timestamps(n, 42))
+            , queries(random_timestamps(query_count, 7))
+            , bounds(query_count)
+        {
+            std::sort(sorted.begin(), sorted.end());
+        }
+
+        std::vector<std::int64_t> sorted;
+        std::vector<std::int64_t> queries;
+        std::vector<std::size_t> bounds;
+    };
+
+    void BM_search_std_lower_bound(benchmark::State& state)
+    {
+        search_data data(state.range(0));
+
+        perf_counters counters;
+        for (auto _ : state) {
+            for (std::size_t i = 0; i < query_count; ++i)
+                data.bounds[i] = std::lower_bound(data.sorted.begin(), data.sorted.end(), data.queries[i]) - data.sorted.begin();
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+        state.SetItemsProcessed(state.iterations() * query_count);
+    }
+
+    template <std::size_t VectorSize>
+    void BM_search_lower_bound_batch(benchmark::State& state)
+    {
+        search_data data(state.range(0));
+
+        perf_counters counters;
+        for (auto _ : state) {
+            pure_simd::lower_bound_batch<VectorSize>(data.sorted.data(), data.sorted.size(), data.queries.data(), query_count, data.bounds.data());
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+        state.SetItemsProcessed(state.iterations() * query_count);
+    }
+
+    template <std::size_t VectorSize>
+    void BM_search_eytzinger(benchmark::State& state)
+    {
+        search_data data(state.range(0));
+
+        // The tree starts at a cache line.
+        std::vector<std::int64_t> storage(pure_simd::eytzinger_size(data.sorted.size()) + 8);
+        auto* tree = storage.data() + (64 - reinterpret_cast<std::uintptr_t>(storage.data()) % 64) % 64 / sizeof(std::int64_t);
+        pure_simd::eytzinger_layout(data.sorted.data(), data.sorted.size(), tree);
+
+        perf_counters counters;
+        for (auto _ : state) {
+            pure_simd::eytzinger_lower_bound_batch<VectorSize>(tree, data.sorted.size(), data.queries.data(), query_count, data.bounds.data());
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+        state.SetItemsProcessed(state.iterations() * query_count);
+    }
+}
+
+BENCHMARK(BM_search_std_lower_bound)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 22);
+BENCHMARK_TEMPLATE(BM_search_lower_bound_batch, 8)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 22);
+BENCHMARK_TEMPLATE(BM_search_lower_bound_batch, 16)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 22);
+BENCHMARK_TEMPLATE(BM_search_eytzinger, 8)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 22);
+BENCHMARK_TEMPLATE(BM_search_eytzinger, 16)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 22);
@@ -1,15 +1,27 @@
 #include "benchmark/benchmark.h"
 
+#include "perf_counters.hpp"
 #include "shader.hpp"
 
+namespace {
+    void set_processed(benchmark::State& state)
+    {
+        state.SetItemsProcessed(state.iterations() * SCRWIDTH * SCRHEIGHT);
+        state.SetBytesProcessed(state.iterations() * SCRWIDTH * SCRHEIGHT * sizeof(int));
+    }
+}
+
 void BM_shader_scalar_shader(benchmark::State& state)
 {
     std::vector<int> buffer(SCRWIDTH * SCRHEIGHT, 0);
 
+    perf_counters counters;
     for (auto _ : state) {
         scalar_shader(2, buffer.data());
         benchmark::ClobberMemory();
     }
+    counters.report_to(state);
+    set_processed(state);
 }
 BENCHMARK(BM_shader_scalar_shader)->Unit(benchmark::kMillisecond);
 
@@ -18,10 +30,13 @@ BENCHMARK(BM_shader_scalar_shader)->Unit(benchmark::kMillisecond);
     {                                                            \
         std::vector<int> buffer(SCRWIDTH* SCRHEIGHT, 0);         \
                                                                  \
+        perf_counters counters;                                  \
         for (auto _ : state) {                                   \
             func_name<size>(2, buffer.data());                   \
             benchmark::ClobberMemory();                          \
         }                                                        \
+        counters.report_to(state);                               \
+        set_processed(state);                                    \
     }                                                            \
     BENCHMARK(BM_shader_##func_name##_##size)->Unit(benchmark::kMillisecond)
 
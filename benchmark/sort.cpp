@@ -0,0 +1,105 @@
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+#include "benchmark/benchmark.h"
+
+#include "perf_counters.hpp"
+#include "pure_simd.hpp"
+
+namespace {
+    std::vector<std::uint32_t> random_keys(std::size_t n)
+    {
+        std::mt19937 gen(n);
+        std::uniform_int_distribution<std::uint32_t> dis;
+        std::vector<std::uint32_t> keys(n);
+        std::generate(keys.begin(), keys.end(), [&] {
+            return dis(gen);
+        });
+        return keys;
+    }
+
+    void set_processed(benchmark::State& state, std::size_t bytes_per_item)
+    {
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+        state.SetBytesProcessed(state.iterations() * state.range(0) * bytes_per_item);
+    }
+
+    void BM_sort_std_sort(benchmark::State& state)
+    {
+        const auto source = random_keys(state.range(0));
+        auto keys = source;
+
+        perf_counters counters;
+        for (auto _ : state) {
+            std::copy(source.begin(), source.end(), keys.begin());
+            std::sort(keys.begin(), keys.end());
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+        set_processed(state, sizeof(std::uint32_t));
+    }
+
+    template <std::size_t VectorSize>
+    void BM_sort_pure_simd_sort(benchmark::State& state)
+    {
+        const auto source = random_keys(state.range(0));
+        auto keys = source;
+
+        perf_counters counters;
+        for (auto _ : state) {
+            std::copy(source.begin(), source.end(), keys.begin());
+            pure_simd::sort<VectorSize>(keys.data(), keys.size());
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+        set_processed(state, sizeof(std::uint32_t));
+    }
+
+    void BM_sort_std_sort_with_payload(benchmark::State& state)
+    {
+        const auto source = random_keys(state.range(0));
+        std::vector<std::pair<std::uint32_t, std::uint32_t>> pairs(source.size());
+
+        perf_counters counters;
+        for (auto _ : state) {
+            for (std::size_t i = 0; i < source.size(); ++i)
+                pairs[i] = { source[i], static_cast<std::uint32_t>(i) };
+
+            std::sort(pairs.begin(), pairs.end(), [](auto a, auto b) { return a.first < b.first; });
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+        set_processed(state, 2 * sizeof(std::uint32_t));
+    }
+
+    template <std::size_t VectorSize>
+    void BM_sort_pure_simd_sort_with_payload(benchmark::State& state)
+    {
+        const auto source = random_keys(state.range(0));
+        auto keys = source;
+        std::vector<std::uint32_t> payloads(source.size());
+
+        perf_counters counters;
+        for (auto _ : state) {
+            std::copy(source.begin(), source.end(), keys.begin());
+            std::iota(payloads.begin(), payloads.end(), 0);
+
+            pure_simd::sort<VectorSize>(keys.data(), keys.size(), payloads.data());
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+        set_processed(state, 2 * sizeof(std::uint32_t));
+    }
+}
+
+#define SORT_SIZES RangeMultiplier(4)->Range(1 << 8, 1 << 14)
+
+BENCHMARK(BM_sort_std_sort)->SORT_SIZES;
+BENCHMARK_TEMPLATE(BM_sort_pure_simd_sort, 8)->SORT_SIZES;
+BENCHMARK_TEMPLATE(BM_sort_pure_simd_sort, 16)->SORT_SIZES;
+BENCHMARK_TEMPLATE(BM_sort_pure_simd_sort, 32)->SORT_SIZES;
+
+BENCHMARK(BM_sort_std_sort_with_payload)->SORT_SIZES;
+BENCHMARK_TEMPLATE(BM_sort_pure_simd_sort_with_payload, 8)->SORT_SIZES;
+BENCHMARK_TEMPLATE(BM_sort_pure_simd_sort_with_payload, 16)->SORT_SIZES;
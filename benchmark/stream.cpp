@@ -0,0 +1,78 @@
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "perf_counters.hpp"
+#include "pure_simd_stream.hpp"
+
+namespace {
+    // 256 MiB of floats; the file mostly stays in the page cache between
+    // iterations, so this measures the overhead of streaming, not the disk.
+    constexpr std::size_t sample_count = std::size_t(64) << 20;
+
+    const std::string& column_file()
+    {
+        static const auto path = [] {
+            auto path = (std::filesystem::temp_directory_path() / "pure_simd_benchmark_stream").string();
+
+            std::mt19937 gen(42);
+            std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+            std::vector<float> xs(sample_count);
+            for (auto& x : xs)
+                x = dist(gen);
+
+            std::ofstream out(path, std::ios::binary);
+            out.write(reinterpret_cast<const char*>(xs.data()), xs.size() * sizeof(float));
+            std::atexit([] { std::remove(column_file().c_str()); });
+            return path;
+        }();
+        return path;
+    }
+
+    void set_processed(benchmark::State& state)
+    {
+        state.SetItemsProcessed(state.iterations() * sample_count);
+        state.SetBytesProcessed(state.iterations() * sample_count * sizeof(float));
+    }
+
+    // Reads the whole file into memory first, as the batch jobs do today.
+    template <std::size_t VectorSize>
+    void BM_stream_read_then_accumulate(benchmark::State& state)
+    {
+        const auto& path = column_file();
+
+        perf_counters counters;
+        for (auto _ : state) {
+            std::vector<float> xs(sample_count);
+            std::ifstream in(path, std::ios::binary);
+            in.read(reinterpret_cast<char*>(xs.data()), xs.size() * sizeof(float));
+
+            benchmark::DoNotOptimize(pure_simd::accumulate<VectorSize>(xs.data(), xs.size(), 0.0f));
+        }
+        counters.report_to(state);
+        set_processed(state);
+    }
+
+    // The first argument is the chunk size in MiB, the second one enables
+    // the read-ahead thread.
+    template <std::size_t VectorSize>
+    void BM_stream_accumulate(benchmark::State& state)
+    {
+        const auto& path = column_file();
+        pure_simd::stream_options options { static_cast<std::size_t>(state.range(0)) << 20, state.range(1) != 0 };
+
+        perf_counters counters;
+        for (auto _ : state)
+            benchmark::DoNotOptimize(pure_simd::stream_accumulate<VectorSize, float>(path, 0.0f, options));
+        counters.report_to(state);
+        set_processed(state);
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_stream_read_then_accumulate, 16)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_stream_accumulate, 16)->Args({ 4, 0 })->Args({ 64, 0 })->Args({ 64, 1 })->Unit(benchmark::kMillisecond);
@@ -2,6 +2,7 @@
 
 #include "benchmark/benchmark.h"
 
+#include "perf_counters.hpp"
 #include "sum.hpp"
 
 #define N 250000
@@ -108,6 +109,24 @@ namespace {
                 return random_vector_float<double>();
             });
         }
+
+        // Every call reads its source and reads and writes the target.
+        template <typename Target>
+        void set_processed(benchmark::State& state)
+        {
+            const std::size_t calls = bitValues.size() + byteValues.size() + wordValues.size()
+                + longValues.size() + floatValues.size() + doubleValues.size();
+
+            const std::size_t source_bytes = bitValues.size() * (N / 8)
+                + byteValues.size() * N * sizeof(std::uint8_t)
+                + wordValues.size() * N * sizeof(std::uint16_t)
+                + longValues.size() * N * sizeof(std::uint32_t)
+                + floatValues.size() * N * sizeof(float)
+                + doubleValues.size() * N * sizeof(double);
+
+            state.SetItemsProcessed(state.iterations() * calls * N);
+            state.SetBytesProcessed(state.iterations() * (source_bytes + calls * N * 2 * sizeof(Target)));
+        }
     }
 
 #define DEFINE_BENCHMARK_FOR(func_name)                                 \
@@ -119,6 +138,7 @@ namespace {
             init(100);                                                  \
         }                                                               \
                                                                         \
+        perf_counters counters;                                         \
         for (auto _ : state) {                                          \
             std::vector<Target> sum(N);                                 \
                                                                         \
@@ -144,6 +164,8 @@ namespace {
                                                                         \
             benchmark::DoNotOptimize(result);                           \
         }                                                               \
+        counters.report_to(state);                                      \
+        set_processed<Target>(state);                                   \
     }
 
 #define BENCHMARK_FOR(func_name, target) \
@@ -0,0 +1,88 @@
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "perf_counters.hpp"
+#include "pure_simd.hpp"
+
+namespace {
+    // 4 MiB per stream, so that every pass goes to memory.
+    constexpr std::size_t element_count = std::size_t(1) << 20;
+
+    struct streams {
+        streams()
+        {
+            std::mt19937 gen(42);
+            std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+            for (auto* xs : { &a, &x, &b, &y, &c, &z })
+                for (auto& v : *xs)
+                    v = dist(gen);
+        }
+
+        std::vector<float> a = std::vector<float>(element_count), x = a, b = a, y = a, c = a, z = a, out = a;
+    };
+
+    void set_processed(benchmark::State& state)
+    {
+        state.SetItemsProcessed(state.iterations() * element_count);
+        state.SetBytesProcessed(state.iterations() * element_count * 7 * sizeof(float));
+    }
+
+    void BM_transform_scalar(benchmark::State& state)
+    {
+        streams s;
+
+        perf_counters counters;
+        for (auto _ : state) {
+            for (std::size_t i = 0; i < element_count; ++i)
+                s.out[i] = s.a[i] * s.x[i] + s.b[i] * s.y[i] + s.c[i] * s.z[i];
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+        set_processed(state);
+    }
+
+    // out = a*x + b*y + c*z with the two-source transform needs three passes.
+    template <std::size_t VectorSize>
+    void BM_transform_passes(benchmark::State& state)
+    {
+        streams s;
+        std::vector<float> tmp(element_count);
+
+        perf_counters counters;
+        for (auto _ : state) {
+            auto multiply = [](float p, float q) { return p * q; };
+            pure_simd::transform<VectorSize>(s.a.data(), element_count, s.x.data(), s.out.data(), multiply);
+            pure_simd::transform<VectorSize>(s.b.data(), element_count, s.y.data(), tmp.data(), multiply);
+            pure_simd::transform<VectorSize>(s.out.data(), element_count, tmp.data(), s.out.data(), std::plus<>());
+            pure_simd::transform<VectorSize>(s.c.data(), element_count, s.z.data(), tmp.data(), multiply);
+            pure_simd::transform<VectorSize>(s.out.data(), element_count, tmp.data(), s.out.data(), std::plus<>());
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+        set_processed(state);
+    }
+
+    template <std::size_t VectorSize>
+    void BM_transform_fused(benchmark::State& state)
+    {
+        streams s;
+
+        perf_counters counters;
+        for (auto _ : state) {
+            pure_simd::transform<VectorSize>(
+                s.out.data(), element_count,
+                [](float a, float x, float b, float y, float c, float z) { return a * x + b * y + c * z; },
+                s.a.data(), s.x.data(), s.b.data(), s.y.data(), s.c.data(), s.z.data());
+            benchmark::ClobberMemory();
+        }
+        counters.report_to(state);
+        set_processed(state);
+    }
+}
+
+BENCHMARK(BM_transform_scalar);
+BENCHMARK_TEMPLATE(BM_transform_passes, 8);
+BENCHMARK_TEMPLATE(BM_transform_fused, 8);
+BENCHMARK_TEMPLATE(BM_transform_fused, 16);
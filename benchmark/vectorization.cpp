@@ -0,0 +1,254 @@
+// Kernels disassembled by scripts/verify_vectorization.sh.
+//
+// Every kernel is named pure_simd_kernel_<expectation>__<operation>__<type>__<size>,
+// where <expectation> is `vector` if the kernel has to contain vector arithmetic
+// and `any` if it is only reported. Kernels are flattened so that the code of
+// an algorithm lands in the kernel instead of an out-of-line clone.
+
+#include <cstdint>
+
+#include "pure_simd.hpp"
+
+namespace psd = pure_simd;
+
+using std::int16_t;
+using std::int32_t;
+using std::int64_t;
+using std::uint16_t;
+using std::uint32_t;
+using std::uint64_t;
+using std::uint8_t;
+
+using psd::q15;
+
+#define KERNEL extern "C" __attribute__((flatten))
+
+#define KERNEL_NAME(expect, name, T, N) \
+    pure_simd_kernel_##expect##__##name##__##T##__##N
+
+#define DEFINE_BINARY_KERNEL(expect, name, op, T, N)                             \
+    KERNEL void KERNEL_NAME(expect, name, T, N)(const T* xs, const T* ys, T* zs) \
+    {                                                                            \
+        using V = psd::vector<T, N>;                                             \
+        psd::store_to(psd::load_from<V>(xs) op psd::load_from<V>(ys), zs);       \
+    }
+
+#define DEFINE_FUNCTION_KERNEL(expect, name, func, T, N)                            \
+    KERNEL void KERNEL_NAME(expect, name, T, N)(const T* xs, const T* ys, T* zs)    \
+    {                                                                               \
+        using V = psd::vector<T, N>;                                                \
+        psd::store_to(psd::func(psd::load_from<V>(xs), psd::load_from<V>(ys)), zs); \
+    }
+
+#define DEFINE_UNARY_FUNCTION_KERNEL(expect, name, func, T, N)        \
+    KERNEL void KERNEL_NAME(expect, name, T, N)(const T* xs, T* ys)   \
+    {                                                                 \
+        using V = psd::vector<T, N>;                                  \
+        psd::store_to(psd::func(psd::load_from<V>(xs)), ys);          \
+    }
+
+#define DEFINE_MULTIPLY_ADD_KERNEL(expect, T, N)                                                \
+    KERNEL void KERNEL_NAME(expect, multiply_add, T, N)(const T* xs, const T* ys, T* zs)        \
+    {                                                                                           \
+        using V = psd::vector<T, N>;                                                            \
+        auto as = psd::load_from<V>(xs);                                                        \
+        psd::store_to(psd::multiply_add(as, psd::load_from<V>(ys), psd::load_from<V>(zs)), zs); \
+    }
+
+#define DEFINE_CAST_KERNEL(expect, T, U, N)                                \
+    KERNEL void KERNEL_NAME(expect, cast_to_##U, T, N)(const T* xs, U* ys) \
+    {                                                                      \
+        using V = psd::vector<T, N>;                                       \
+        psd::store_to(psd::cast_to<U>(psd::load_from<V>(xs)), ys);         \
+    }
+
+#define DEFINE_SUM_KERNEL(expect, T, N)                               \
+    KERNEL T KERNEL_NAME(expect, sum, T, N)(const T* xs)              \
+    {                                                                 \
+        return psd::sum(psd::load_from<psd::vector<T, N>>(xs), T {}); \
+    }
+
+#define DEFINE_TRANSFORM_KERNEL(expect, T, N)                                           \
+    KERNEL void KERNEL_NAME(expect, transform, T, N)(const T* xs, std::size_t n, T* ys) \
+    {                                                                                   \
+        psd::transform<N>(xs, n, ys, [](auto a) { return a * a + a; });                 \
+    }
+
+#define DEFINE_ACCUMULATE_KERNEL(expect, T, Acc, N)                              \
+    KERNEL Acc KERNEL_NAME(expect, accumulate, T, N)(const T* xs, std::size_t n) \
+    {                                                                            \
+        return psd::sum(psd::accumulate<N>(xs, n, Acc {}), Acc {});              \
+    }
+
+#define DEFINE_INNER_PRODUCT_KERNEL(expect, T, Acc, N)                                           \
+    KERNEL Acc KERNEL_NAME(expect, inner_product, T, N)(const T* xs, std::size_t n, const T* ys) \
+    {                                                                                            \
+        return psd::sum(psd::inner_product<N>(xs, n, ys, Acc {}), Acc {});                       \
+    }
+
+#define DEFINE_SORT_COLUMNS_KERNEL(expect, T, N)               \
+    KERNEL void KERNEL_NAME(expect, sort_columns, T, N)(T* xs) \
+    {                                                          \
+        using V = psd::vector<T, N>;                           \
+        std::array<V, N> columns;                              \
+        for (std::size_t i = 0; i < N; ++i)                    \
+            columns[i] = psd::load_from<V>(xs + i * N);        \
+        columns = psd::sort_columns(columns);                  \
+        for (std::size_t i = 0; i < N; ++i)                    \
+            psd::store_to(columns[i], xs + i * N);             \
+    }
+
+#define DEFINE_SEARCH_KERNELS(expect, T, N)                                              \
+    KERNEL std::size_t KERNEL_NAME(expect, find, T, N)(const T* xs, std::size_t n, T x)  \
+    {                                                                                    \
+        return psd::find<N>(xs, n, x);                                                   \
+    }                                                                                    \
+    KERNEL std::size_t KERNEL_NAME(expect, count, T, N)(const T* xs, std::size_t n, T x) \
+    {                                                                                    \
+        return psd::count<N>(xs, n, x);                                                  \
+    }
+
+#define DEFINE_REDUCE_KERNELS(expect, T, N)                                                             \
+    KERNEL T KERNEL_NAME(expect, accumulate_kahan, T, N)(const T* xs, std::size_t n)                    \
+    {                                                                                                   \
+        return psd::accumulate<N>(xs, n, T {}, psd::kahan);                                             \
+    }                                                                                                   \
+    KERNEL T KERNEL_NAME(expect, inner_product_neumaier, T, N)(const T* xs, std::size_t n, const T* ys) \
+    {                                                                                                   \
+        return psd::inner_product<N>(xs, n, ys, T {}, psd::neumaier);                                   \
+    }
+
+// byteswap is a byte shuffle, which is not counted as arithmetic, so it is
+// only reported.
+#define DEFINE_BIT_KERNELS(expect, T, N)                                                     \
+    DEFINE_UNARY_FUNCTION_KERNEL(expect, popcount, popcount, T, N)                           \
+    DEFINE_UNARY_FUNCTION_KERNEL(expect, countl_zero, countl_zero, T, N)                     \
+    DEFINE_UNARY_FUNCTION_KERNEL(expect, countr_zero, countr_zero, T, N)                     \
+    DEFINE_UNARY_FUNCTION_KERNEL(any, byteswap, byteswap, T, N)                              \
+    KERNEL void KERNEL_NAME(expect, rotl, T, N)(const T* xs, T* ys)                          \
+    {                                                                                        \
+        psd::store_to(psd::rotl(psd::load_from<psd::vector<T, N>>(xs), 7), ys);              \
+    }                                                                                        \
+    KERNEL void KERNEL_NAME(any, byteswap_copy, T, N)(const T* xs, std::size_t n, T* ys)     \
+    {                                                                                        \
+        psd::byteswap_copy<N>(xs, n, ys);                                                    \
+    }
+
+#define DEFINE_FIXED_KERNELS(expect, T, N)                                    \
+    DEFINE_BINARY_KERNEL(expect, add, +, T, N)                                \
+    DEFINE_BINARY_KERNEL(expect, sub, -, T, N)                                \
+    DEFINE_BINARY_KERNEL(expect, mul, *, T, N)                                \
+    KERNEL void KERNEL_NAME(expect, to_float, T, N)(const T* xs, float* ys)   \
+    {                                                                         \
+        psd::store_to(psd::load_from<psd::vector<float, N>>(xs), ys);         \
+    }                                                                         \
+    KERNEL void KERNEL_NAME(expect, from_float, T, N)(const float* xs, T* ys) \
+    {                                                                         \
+        psd::store_to(psd::load_from<psd::vector<float, N>>(xs), ys);         \
+    }
+
+#define DEFINE_CHECKSUM_KERNELS(expect, N)                                                          \
+    KERNEL uint32_t KERNEL_NAME(expect, adler32, uint8_t, N)(const uint8_t* xs, std::size_t n)      \
+    {                                                                                               \
+        return psd::adler32<N>(xs, n);                                                              \
+    }                                                                                               \
+    KERNEL uint64_t KERNEL_NAME(expect, fletcher64, uint32_t, N)(const uint32_t* xs, std::size_t n) \
+    {                                                                                               \
+        return psd::fletcher64<N>(xs, n);                                                           \
+    }
+
+// Interleaved scalar code: one cmp/cmov chain per query.
+#define DEFINE_LOWER_BOUND_KERNELS(expect, T, N)                                                                       \
+    KERNEL void KERNEL_NAME(expect, lower_bound_batch, T, N)(const T* xs, std::size_t n, const T* ys, std::size_t* zs) \
+    {                                                                                                                  \
+        psd::lower_bound_batch<N>(xs, n, ys, N, zs);                                                                   \
+    }                                                                                                                  \
+    KERNEL void KERNEL_NAME(expect, eytzinger, T, N)(const T* xs, std::size_t n, const T* ys, std::size_t* zs)         \
+    {                                                                                                                  \
+        psd::eytzinger_lower_bound_batch<N>(xs, n, ys, N, zs);                                                         \
+    }
+
+// Accumulations of narrow integers use `Acc` to avoid integer promotion.
+#define DEFINE_KERNELS_FOR(expect, T, Acc, N)   \
+    DEFINE_BINARY_KERNEL(expect, add, +, T, N)  \
+    DEFINE_BINARY_KERNEL(expect, sub, -, T, N)  \
+    DEFINE_BINARY_KERNEL(expect, mul, *, T, N)  \
+    DEFINE_MULTIPLY_ADD_KERNEL(expect, T, N)    \
+    DEFINE_TRANSFORM_KERNEL(expect, T, N)       \
+    DEFINE_ACCUMULATE_KERNEL(expect, T, Acc, N) \
+    DEFINE_INNER_PRODUCT_KERNEL(expect, T, Acc, N)
+
+#define DEFINE_INTEGER_KERNELS_FOR(expect, T, Acc, N) \
+    DEFINE_KERNELS_FOR(expect, T, Acc, N)             \
+    DEFINE_FUNCTION_KERNEL(expect, min, min, T, N)    \
+    DEFINE_FUNCTION_KERNEL(expect, max, max, T, N)    \
+    DEFINE_BINARY_KERNEL(expect, and, &, T, N)        \
+    DEFINE_BINARY_KERNEL(expect, xor, ^, T, N)
+
+// std::min/std::max on floating-point lanes are not SLP-vectorized by gcc
+// (it emits one minss/maxss per lane), so they are only reported.
+#define DEFINE_FLOATING_POINT_KERNELS_FOR(expect, T, N) \
+    DEFINE_KERNELS_FOR(expect, T, T, N)                 \
+    DEFINE_FUNCTION_KERNEL(any, min, min, T, N)         \
+    DEFINE_FUNCTION_KERNEL(any, max, max, T, N)
+
+DEFINE_INTEGER_KERNELS_FOR(vector, int32_t, int32_t, 4)
+DEFINE_INTEGER_KERNELS_FOR(vector, int32_t, int32_t, 8)
+DEFINE_INTEGER_KERNELS_FOR(vector, int32_t, int32_t, 16)
+DEFINE_INTEGER_KERNELS_FOR(vector, int32_t, int32_t, 32)
+
+DEFINE_INTEGER_KERNELS_FOR(vector, int16_t, int32_t, 8)
+DEFINE_INTEGER_KERNELS_FOR(vector, int16_t, int32_t, 16)
+DEFINE_INTEGER_KERNELS_FOR(vector, int16_t, int32_t, 32)
+
+DEFINE_INTEGER_KERNELS_FOR(vector, uint8_t, int32_t, 16)
+DEFINE_INTEGER_KERNELS_FOR(vector, uint8_t, int32_t, 32)
+DEFINE_INTEGER_KERNELS_FOR(vector, uint8_t, int32_t, 64)
+
+DEFINE_INTEGER_KERNELS_FOR(any, int64_t, int64_t, 4)
+DEFINE_INTEGER_KERNELS_FOR(any, int64_t, int64_t, 8)
+
+DEFINE_FLOATING_POINT_KERNELS_FOR(vector, float, 4)
+DEFINE_FLOATING_POINT_KERNELS_FOR(vector, float, 8)
+DEFINE_FLOATING_POINT_KERNELS_FOR(vector, float, 16)
+DEFINE_FLOATING_POINT_KERNELS_FOR(vector, float, 32)
+
+DEFINE_FLOATING_POINT_KERNELS_FOR(vector, double, 2)
+DEFINE_FLOATING_POINT_KERNELS_FOR(vector, double, 4)
+DEFINE_FLOATING_POINT_KERNELS_FOR(vector, double, 8)
+DEFINE_FLOATING_POINT_KERNELS_FOR(vector, double, 16)
+
+DEFINE_CAST_KERNEL(vector, int32_t, float, 8)
+DEFINE_CAST_KERNEL(vector, int32_t, float, 16)
+DEFINE_CAST_KERNEL(vector, float, int32_t, 8)
+DEFINE_CAST_KERNEL(vector, float, int32_t, 16)
+DEFINE_CAST_KERNEL(any, uint8_t, float, 16)
+DEFINE_CAST_KERNEL(any, float, double, 8)
+
+DEFINE_SORT_COLUMNS_KERNEL(vector, int32_t, 8)
+DEFINE_SORT_COLUMNS_KERNEL(vector, int32_t, 16)
+DEFINE_SORT_COLUMNS_KERNEL(vector, int16_t, 16)
+
+DEFINE_SEARCH_KERNELS(vector, uint8_t, 32)
+DEFINE_SEARCH_KERNELS(vector, uint8_t, 64)
+DEFINE_SEARCH_KERNELS(vector, int32_t, 16)
+
+DEFINE_BIT_KERNELS(vector, uint16_t, 32)
+DEFINE_BIT_KERNELS(vector, uint32_t, 16)
+DEFINE_BIT_KERNELS(vector, uint64_t, 8)
+
+DEFINE_FIXED_KERNELS(vector, q15, 16)
+DEFINE_FIXED_KERNELS(vector, q15, 32)
+
+DEFINE_LOWER_BOUND_KERNELS(any, int64_t, 8)
+DEFINE_LOWER_BOUND_KERNELS(any, int32_t, 16)
+
+DEFINE_CHECKSUM_KERNELS(vector, 16)
+DEFINE_CHECKSUM_KERNELS(vector, 64)
+
+DEFINE_REDUCE_KERNELS(vector, float, 8)
+DEFINE_REDUCE_KERNELS(vector, double, 8)
+
+DEFINE_SUM_KERNEL(any, int32_t, 8)
+DEFINE_SUM_KERNEL(any, float, 8)
+DEFINE_SUM_KERNEL(any, double, 4)
@@ -0,0 +1,299 @@
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "image.hpp"
+#include "pure_simd.hpp"
+
+namespace {
+    using std::uint32_t;
+    using std::uint8_t;
+
+    constexpr uint32_t low_channels = 0x00ff00ff;
+
+    // Returns round(c * w / 255) for both channels of a 0x00cc00cc pair.
+    inline uint32_t multiply_pair(uint32_t pair, uint32_t w)
+    {
+        uint32_t t = pair * w + 0x00800080;
+        return ((t + ((t >> 8) & low_channels)) >> 8) & low_channels;
+    }
+
+    // Interpolates both channels of two pairs with a weight in [0, 256].
+    inline uint32_t lerp_pair(uint32_t a, uint32_t b, uint32_t w)
+    {
+        return ((a * (256 - w) + b * w + 0x00800080) >> 8) & low_channels;
+    }
+
+    // The per-pixel kernels are lambdas, so transform and unroll call them
+    // directly and gcc inlines them into every lane.
+    const auto blend_pixel = [](uint32_t src, uint32_t dst) -> uint32_t {
+        uint32_t inverse_alpha = 255 - (src >> 24);
+        uint32_t rb = multiply_pair(dst & low_channels, inverse_alpha);
+        uint32_t ga = multiply_pair((dst >> 8) & low_channels, inverse_alpha);
+        return src + (rb | (ga << 8));
+    };
+
+    const auto premultiply_pixel = [](uint32_t pixel) -> uint32_t {
+        uint32_t alpha = pixel >> 24;
+        uint32_t rb = multiply_pair(pixel & low_channels, alpha);
+        // Pairing green with 255 keeps alpha unchanged.
+        uint32_t ga = multiply_pair(((pixel >> 8) & 0xff) | 0x00ff0000, alpha);
+        return rb | (ga << 8);
+    };
+
+    const auto lerp_pixel = [](uint32_t a, uint32_t b, uint32_t w) -> uint32_t {
+        uint32_t rb = lerp_pair(a & low_channels, b & low_channels, w);
+        uint32_t ga = lerp_pair((a >> 8) & low_channels, (b >> 8) & low_channels, w);
+        return rb | (ga << 8);
+    };
+
+    inline int red(uint32_t pixel) { return pixel & 0xff; }
+
+    inline int green(uint32_t pixel) { return (pixel >> 8) & 0xff; }
+
+    inline int blue(uint32_t pixel) { return (pixel >> 16) & 0xff; }
+
+    const auto gray_pixel = [](uint32_t pixel) -> uint8_t {
+        return static_cast<uint8_t>((77 * red(pixel) + 150 * green(pixel) + 29 * blue(pixel) + 128) >> 8);
+    };
+
+    // The offsets of 128.5 * 256 keep the sums positive and rounded, the
+    // maximum of 256 is clipped.
+    const auto u_pixel = [](uint32_t pixel) -> uint8_t {
+        return static_cast<uint8_t>(std::min((-43 * red(pixel) - 85 * green(pixel) + 128 * blue(pixel) + 32896) >> 8, 255));
+    };
+
+    const auto v_pixel = [](uint32_t pixel) -> uint8_t {
+        return static_cast<uint8_t>(std::min((128 * red(pixel) - 107 * green(pixel) - 21 * blue(pixel) + 32896) >> 8, 255));
+    };
+
+    inline uint32_t rgba_pixel(int y, int u, int v)
+    {
+        int c = u - 128;
+        int e = v - 128;
+
+        auto clip = [](int x) { return static_cast<uint32_t>(std::clamp(x, 0, 255)); };
+        uint32_t r = clip(y + ((359 * e + 128) >> 8));
+        uint32_t g = clip(y - ((88 * c + 183 * e + 128) >> 8));
+        uint32_t b = clip(y + ((454 * c + 128) >> 8));
+        return r | (g << 8) | (b << 16) | 0xff000000;
+    }
+
+    // Source positions of the pixel centers in 8.8 fixed point.
+    struct sample {
+        uint32_t first;
+        uint32_t second;
+        uint32_t weight;
+    };
+
+    std::vector<sample> samples(std::size_t src_size, std::size_t dst_size)
+    {
+        std::vector<sample> result(dst_size);
+        for (std::size_t i = 0; i < dst_size; ++i) {
+            auto pos = static_cast<std::int64_t>((2 * i + 1) * src_size * 256 / (2 * dst_size)) - 128;
+            pos = std::clamp<std::int64_t>(pos, 0, static_cast<std::int64_t>(src_size - 1) * 256);
+
+            auto first = static_cast<uint32_t>(pos >> 8);
+            result[i] = { first, std::min(first + 1, static_cast<uint32_t>(src_size - 1)), static_cast<uint32_t>(pos & 0xff) };
+        }
+        return result;
+    }
+}
+
+void rgb_to_rgba(const uint8_t* rgb, std::size_t n, uint32_t* dst)
+{
+    for (std::size_t i = 0; i < n; ++i, rgb += 3)
+        dst[i] = rgb[0] | (rgb[1] << 8) | (rgb[2] << 16) | 0xff000000u;
+}
+
+void rgba_to_rgb(const uint32_t* src, std::size_t n, uint8_t* rgb)
+{
+    for (std::size_t i = 0; i < n; ++i, rgb += 3) {
+        rgb[0] = static_cast<uint8_t>(src[i]);
+        rgb[1] = static_cast<uint8_t>(src[i] >> 8);
+        rgb[2] = static_cast<uint8_t>(src[i] >> 16);
+    }
+}
+
+void scalar_blend(const uint32_t* src, std::size_t n, uint32_t* dst)
+{
+    for (std::size_t i = 0; i < n; ++i)
+        dst[i] = blend_pixel(src[i], dst[i]);
+}
+
+void scalar_premultiply(const uint32_t* src, std::size_t n, uint32_t* dst)
+{
+    for (std::size_t i = 0; i < n; ++i)
+        dst[i] = premultiply_pixel(src[i]);
+}
+
+void scalar_rgba_to_gray(const uint32_t* src, std::size_t n, uint8_t* gray)
+{
+    for (std::size_t i = 0; i < n; ++i)
+        gray[i] = gray_pixel(src[i]);
+}
+
+void scalar_rgba_to_yuv(const uint32_t* src, std::size_t n, uint8_t* y, uint8_t* u, uint8_t* v)
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        y[i] = gray_pixel(src[i]);
+        u[i] = u_pixel(src[i]);
+        v[i] = v_pixel(src[i]);
+    }
+}
+
+void scalar_yuv_to_rgba(const uint8_t* y, const uint8_t* u, const uint8_t* v, std::size_t n, uint32_t* dst)
+{
+    for (std::size_t i = 0; i < n; ++i)
+        dst[i] = rgba_pixel(y[i], u[i], v[i]);
+}
+
+void scalar_resize_bilinear(
+    const uint32_t* src, std::size_t src_width, std::size_t src_height,
+    uint32_t* dst, std::size_t dst_width, std::size_t dst_height)
+{
+    auto columns = samples(src_width, dst_width);
+    auto rows = samples(src_height, dst_height);
+
+    std::vector<uint32_t> row(src_width);
+    for (std::size_t y = 0; y < dst_height; ++y, dst += dst_width) {
+        const uint32_t* first = src + rows[y].first * src_width;
+        const uint32_t* second = src + rows[y].second * src_width;
+        for (std::size_t x = 0; x < src_width; ++x)
+            row[x] = lerp_pixel(first[x], second[x], rows[y].weight);
+
+        for (std::size_t x = 0; x < dst_width; ++x)
+            dst[x] = lerp_pixel(row[columns[x].first], row[columns[x].second], columns[x].weight);
+    }
+}
+
+template <std::size_t VectorSize>
+void pure_simd_blend(const uint32_t* src, std::size_t n, uint32_t* dst)
+{
+    pure_simd::transform<VectorSize>(src, n, dst, dst, blend_pixel);
+}
+
+template <std::size_t VectorSize>
+void pure_simd_premultiply(const uint32_t* src, std::size_t n, uint32_t* dst)
+{
+    pure_simd::transform<VectorSize>(src, n, dst, premultiply_pixel);
+}
+
+template <std::size_t VectorSize>
+void pure_simd_rgba_to_gray(const uint32_t* src, std::size_t n, uint8_t* gray)
+{
+    pure_simd::transform<VectorSize>(src, n, gray, gray_pixel);
+}
+
+template <std::size_t VectorSize>
+void pure_simd_rgba_to_yuv(const uint32_t* src, std::size_t n, uint8_t* y, uint8_t* u, uint8_t* v)
+{
+    namespace psd = pure_simd;
+
+    using pvec = psd::vector<uint32_t, VectorSize>;
+
+    std::size_t i = 0;
+    for (; i + VectorSize <= n; i += VectorSize) {
+        auto pixels = psd::load_from<pvec>(src + i);
+        psd::store_to(psd::unroll(pixels, gray_pixel), y + i);
+        psd::store_to(psd::unroll(pixels, u_pixel), u + i);
+        psd::store_to(psd::unroll(pixels, v_pixel), v + i);
+    }
+
+    scalar_rgba_to_yuv(src + i, n - i, y + i, u + i, v + i);
+}
+
+template <std::size_t VectorSize>
+void pure_simd_yuv_to_rgba(const uint8_t* y, const uint8_t* u, const uint8_t* v, std::size_t n, uint32_t* dst)
+{
+    namespace psd = pure_simd;
+
+    using bvec = psd::vector<uint8_t, VectorSize>;
+
+    using ivec = psd::vector<int, VectorSize>;
+
+    // The same math as rgba_pixel in vector operations: the widened planes
+    // keep every lane 32 bits wide, and unrolling rgba_pixel over 16 or more
+    // lanes exceeds gcc's inlining limits.
+    auto load = [](const uint8_t* src) { return psd::cast_to<int>(psd::load_from<bvec>(src)); };
+    auto constant = [](int x) { return psd::scalar<ivec>(x); };
+    auto clip = [](ivec xs) { return psd::clamp(xs, 0, 255); };
+
+    std::size_t i = 0;
+    for (; i + VectorSize <= n; i += VectorSize) {
+        auto ys = load(y + i);
+        auto cs = load(u + i) - constant(128);
+        auto es = load(v + i) - constant(128);
+
+        auto rs = clip(ys + ((constant(359) * es + constant(128)) >> constant(8)));
+        auto gs = clip(ys - ((constant(88) * cs + constant(183) * es + constant(128)) >> constant(8)));
+        auto bs = clip(ys + ((constant(454) * cs + constant(128)) >> constant(8)));
+        auto pixels = rs | (gs << constant(8)) | (bs << constant(16)) | constant(-0x1000000);
+        psd::store_to(psd::cast_to<uint32_t>(pixels), dst + i);
+    }
+
+    scalar_yuv_to_rgba(y + i, u + i, v + i, n - i, dst + i);
+}
+
+template <std::size_t VectorSize>
+void pure_simd_resize_bilinear(
+    const uint32_t* src, std::size_t src_width, std::size_t src_height,
+    uint32_t* dst, std::size_t dst_width, std::size_t dst_height)
+{
+    namespace psd = pure_simd;
+
+    using pvec = psd::vector<uint32_t, VectorSize>;
+
+    auto columns = samples(src_width, dst_width);
+    auto rows = samples(src_height, dst_height);
+
+    // Second is first + 1 except at the right border, where both are the
+    // last pixel. Repeating that pixel past the end of the row lets every
+    // output pixel read its two neighbours as one 64-bit gather, which
+    // halves the gathers that bound this loop.
+    std::vector<uint32_t> firsts(dst_width), weights(dst_width);
+    for (std::size_t x = 0; x < dst_width; ++x) {
+        firsts[x] = columns[x].first;
+        weights[x] = columns[x].weight;
+    }
+
+    std::vector<uint32_t> row(src_width + 1);
+    for (std::size_t y = 0; y < dst_height; ++y, dst += dst_width) {
+        const uint32_t weight = rows[y].weight;
+        psd::transform<VectorSize>(src + rows[y].first * src_width, src_width, src + rows[y].second * src_width, row.data(),
+            [weight](uint32_t a, uint32_t b) { return lerp_pixel(a, b, weight); });
+        row[src_width] = row[src_width - 1];
+
+        auto neighbours = [&row](uint32_t x) {
+            std::uint64_t pair;
+            std::memcpy(&pair, row.data() + x, sizeof(pair));
+            return pair;
+        };
+        auto lerp_neighbours = [](std::uint64_t pair, uint32_t w) {
+            return lerp_pixel(static_cast<uint32_t>(pair), static_cast<uint32_t>(pair >> 32), w);
+        };
+
+        std::size_t x = 0;
+        for (; x + VectorSize <= dst_width; x += VectorSize) {
+            auto pairs = psd::unroll(psd::load_from<pvec>(firsts.data() + x), neighbours);
+            psd::store_to(psd::unroll(pairs, psd::load_from<pvec>(weights.data() + x), lerp_neighbours), dst + x);
+        }
+
+        for (; x < dst_width; ++x)
+            dst[x] = lerp_neighbours(neighbours(firsts[x]), weights[x]);
+    }
+}
+
+#define INSTANTIATE_IMAGE_KERNELS(N)                                                                                            \
+    template void pure_simd_blend<N>(const uint32_t* src, std::size_t n, uint32_t* dst);                                        \
+    template void pure_simd_premultiply<N>(const uint32_t* src, std::size_t n, uint32_t* dst);                                  \
+    template void pure_simd_rgba_to_gray<N>(const uint32_t* src, std::size_t n, uint8_t* gray);                                 \
+    template void pure_simd_rgba_to_yuv<N>(const uint32_t* src, std::size_t n, uint8_t* y, uint8_t* u, uint8_t* v);             \
+    template void pure_simd_yuv_to_rgba<N>(const uint8_t* y, const uint8_t* u, const uint8_t* v, std::size_t n, uint32_t* dst); \
+    template void pure_simd_resize_bilinear<N>(                                                                                 \
+        const uint32_t* src, std::size_t src_width, std::size_t src_height,                                                     \
+        uint32_t* dst, std::size_t dst_width, std::size_t dst_height);
+
+INSTANTIATE_IMAGE_KERNELS(8)
+INSTANTIATE_IMAGE_KERNELS(16)
+INSTANTIATE_IMAGE_KERNELS(32)
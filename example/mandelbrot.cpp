@@ -0,0 +1,124 @@
+#include "pure_simd.hpp"
+#include "mandelbrot.hpp"
+
+namespace {
+    constexpr float x_min = -2.0f;
+    constexpr float y_min = -1.25f;
+    constexpr float x_step = 2.5f / MANDELBROT_WIDTH;
+    constexpr float y_step = 2.5f / MANDELBROT_HEIGHT;
+}
+
+void scalar_mandelbrot(int* iterations)
+{
+    for (std::size_t y = 0; y < MANDELBROT_HEIGHT; ++y) {
+        for (std::size_t x = 0; x < MANDELBROT_WIDTH; ++x) {
+            float cx = x_min + x * x_step;
+            float cy = y_min + y * y_step;
+            float zx = 0;
+            float zy = 0;
+
+            int n = 0;
+            while (n < MANDELBROT_MAX_ITERATIONS && zx * zx + zy * zy <= 4.0f) {
+                float t = zx * zx - zy * zy + cx;
+                zy = 2.0f * zx * zy + cy;
+                zx = t;
+                ++n;
+            }
+
+            iterations[x + y * MANDELBROT_WIDTH] = n;
+        }
+    }
+}
+
+template <std::size_t MaxVectorSize>
+void pure_simd_mandelbrot(int* iterations)
+{
+    namespace psd = pure_simd;
+
+    for (std::size_t y = 0; y < MANDELBROT_HEIGHT; ++y) {
+        psd::unroll_loop<MaxVectorSize>(std::size_t {}, MANDELBROT_WIDTH, [&](auto step, std::size_t x) {
+            constexpr std::size_t vector_size = decltype(step)::value;
+            using fvec = psd::vector<float, vector_size>;
+            using ivec = psd::vector<int, vector_size>;
+
+            auto cx = psd::unroll(psd::iota<fvec>(static_cast<float>(x), 1.0f), [](float i) { return x_min + i * x_step; });
+            auto cy = psd::scalar<fvec>(y_min + y * y_step);
+            auto zx = psd::scalar<fvec>(0.0f);
+            auto zy = psd::scalar<fvec>(0.0f);
+            auto n = psd::scalar<ivec>(0);
+
+            // Escaped lanes keep iterating, but their counters stay frozen.
+            psd::while_any(psd::scalar<ivec>(-1), [&](ivec active) {
+                auto t = zx * zx - zy * zy + cx;
+                zy = psd::scalar<fvec>(2.0f) * zx * zy + cy;
+                zx = t;
+                n = n - active;
+
+                return psd::unroll(zx * zx + zy * zy, n, [](float r, int n) {
+                    return -static_cast<int>((n < MANDELBROT_MAX_ITERATIONS) & (r <= 4.0f));
+                });
+            });
+
+            psd::store_to(n, iterations + x + y * MANDELBROT_WIDTH);
+        });
+    }
+}
+
+template <std::size_t VectorSize>
+void pure_simd_mandelbrot_persistent(int* iterations)
+{
+    namespace psd = pure_simd;
+
+    using fvec = psd::vector<float, VectorSize>;
+    using ivec = psd::vector<int, VectorSize>;
+
+    fvec cx {}, cy {}, zx {}, zy {};
+    ivec n {};
+
+    psd::masked_loop<VectorSize>(
+        MANDELBROT_WIDTH * MANDELBROT_HEIGHT,
+        [&](std::size_t lane, std::size_t pixel) {
+            cx[lane] = x_min + pixel % MANDELBROT_WIDTH * x_step;
+            cy[lane] = y_min + pixel / MANDELBROT_WIDTH * y_step;
+            zx[lane] = 0;
+            zy[lane] = 0;
+            n[lane] = 0;
+        },
+        [&](ivec) {
+            auto t = zx * zx - zy * zy + cx;
+            zy = psd::scalar<fvec>(2.0f) * zx * zy + cy;
+            zx = t;
+            n = n + psd::scalar<ivec>(1);
+
+            return psd::unroll(zx * zx + zy * zy, n, [](float r, int n) {
+                return -static_cast<int>((n < MANDELBROT_MAX_ITERATIONS) & (r <= 4.0f));
+            });
+        },
+        [&](std::size_t lane, std::size_t pixel) {
+            iterations[pixel] = n[lane];
+        });
+}
+
+template 
+void pure_simd_mandelbrot<4>(int* iterations);
+
+template 
+void pure_simd_mandelbrot<8>(int* iterations);
+
+template 
+void pure_simd_mandelbrot<16>(int* iterations);
+
+template 
+void pure_simd_mandelbrot<32>(int* iterations);
+
+template 
+void pure_simd_mandelbrot_persistent<4>(int* iterations);
+
+template 
+void pure_simd_mandelbrot_persistent<8>(int* iterations);
+
+template 
+void pure_simd_mandelbrot_persistent<16>(int* iterations);
+
+template 
+void pure_simd_mandelbrot_persistent<32>(int* iterations);
@@ -0,0 +1,45 @@
+#ifndef MANDELBROT_H
+#define MANDELBROT_H
+
+#include <cstddef>
+
+constexpr std::size_t MANDELBROT_WIDTH = 256;
+constexpr std::size_t MANDELBROT_HEIGHT = 256;
+constexpr int MANDELBROT_MAX_ITERATIONS = 256;
+
+// Writes the escape time of every pixel of [-2, 0.5] x [-1.25, 1.25].
+void scalar_mandelbrot(int* iterations);
+
+// Runs the pixels of a row in vectors until all of them escaped.
+template <std::size_t MaxVectorSize>
+void pure_simd_mandelbrot(int* iterations);
+
+// Refills the lanes of escaped pixels with new pixels.
+template <std::size_t VectorSize>
+void pure_simd_mandelbrot_persistent(int* iterations);
+
+extern template 
+void pure_simd_mandelbrot<4>(int* iterations);
+
+extern template 
+void pure_simd_mandelbrot<8>(int* iterations);
+
+extern template 
+void pure_simd_mandelbrot<16>(int* iterations);
+
+extern template 
+void pure_simd_mandelbrot<32>(int* iterations);
+
+extern template 
+void pure_simd_mandelbrot_persistent<4>(int* iterations);
+
+extern template 
+void pure_simd_mandelbrot_persistent<8>(int* iterations);
+
+extern template 
+void pure_simd_mandelbrot_persistent<16>(int* iterations);
+
+extern template 
+void pure_simd_mandelbrot_persistent<32>(int* iterations);
+
+#endif /* MANDELBROT_H */
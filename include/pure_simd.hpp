@@ -1,9 +1,47 @@
 #ifndef PURE_SIMD_H
 #define PURE_SIMD_H
 
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
 #include <climits>
-#include <functional>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// Keeps rare paths out of hot loops, which would not be inlined otherwise.
+#if defined(__GNUC__)
+#define PURE_SIMD_NOINLINE __attribute__((noinline))
+#else
+#define PURE_SIMD_NOINLINE
+#endif
+
+// Keeps a loop over the lanes rolled, for the loop vectorizer to widen.
+#if defined(__GNUC__)
+#define PURE_SIMD_NO_UNROLL _Pragma("GCC unroll 1")
+#else
+#define PURE_SIMD_NO_UNROLL
+#endif
+
+// The CRC32C instructions of SSE 4.2 and of the ARMv8 CRC extension.
+#if (defined(__SSE4_2__) && defined(__x86_64__)) || defined(__ARM_FEATURE_CRC32)
+#define PURE_SIMD_HAS_CRC32C 1
+#endif
+
+#if defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif
 
 namespace pure_simd {
 #if __AVX512BW__ | __AVX512CD__ | __AVX512DQ__ | __AVX512F__ | __AVX512VL__
@@ -103,7 +141,353 @@ namespace pure_simd {
 
     } // namespace trait
 
+    // Storage types: float16 and bfloat16.
+    //
+    // Half-precision storage that converts to and from float. load_from and
+    // store_to convert between them and vector<float, N>, and transform,
+    // accumulate and inner_product compute on float when their sources are
+    // stored in one of these types. With F16C, float16 holds a _Float16,
+    // which gcc converts eight lanes at a time; otherwise it falls back to
+    // bit manipulation. Conversions from float round to nearest even.
+    namespace detail {
+        inline float float_of_bits(std::uint32_t bits)
+        {
+            float x;
+            std::memcpy(&x, &bits, sizeof(x));
+            return x;
+        }
+
+        inline std::uint32_t bits_of_float(float x)
+        {
+            std::uint32_t bits;
+            std::memcpy(&bits, &x, sizeof(bits));
+            return bits;
+        }
+
+        inline float half_to_float(std::uint16_t half)
+        {
+            std::uint32_t sign = std::uint32_t(half & 0x8000) << 16;
+            std::uint32_t magnitude = std::uint32_t(half & 0x7fff) << 13;
+
+            // Rebiasing by a multiplication also normalizes the subnormals.
+            // NaNs come out quiet, as from the hardware conversion.
+            if (magnitude >= 0x7c00u << 13)
+                return float_of_bits(sign | magnitude | (magnitude > 0x7c00u << 13 ? 0x7fc00000 : 0x7f800000));
+            return float_of_bits(sign | bits_of_float(float_of_bits(magnitude) * 0x1p112f));
+        }
+
+        inline std::uint16_t float_to_half(float x)
+        {
+            std::uint32_t bits = bits_of_float(x);
+            std::uint32_t sign = bits & 0x80000000;
+            bits ^= sign;
+
+            std::uint32_t half;
+            if (bits >= (127u + 16) << 23) {
+                // Overflow to infinity, NaNs stay quiet NaNs.
+                half = bits > 0x7f800000 ? 0x7e00 : 0x7c00;
+            } else if (bits < (127u - 14) << 23) {
+                // Adding 0.5 lets the float unit round the subnormal mantissa.
+                half = bits_of_float(float_of_bits(bits) + 0.5f) - bits_of_float(0.5f);
+            } else {
+                std::uint32_t odd = (bits >> 13) & 1;
+                half = (bits + ((15u - 127) << 23) + 0xfff + odd) >> 13;
+            }
+            return static_cast<std::uint16_t>(half | (sign >> 16));
+        }
+
+    } // namespace detail
+
+#if (defined(__F16C__) || defined(__aarch64__)) && defined(__FLT16_MAX__)
+    struct float16 {
+        float16() = default;
+
+        constexpr float16(float x)
+            : value { static_cast<_Float16>(x) }
+        {
+        }
+
+        constexpr operator float() const { return value; }
+
+        static float16 from_bits(std::uint16_t bits)
+        {
+            float16 x;
+            std::memcpy(&x.value, &bits, sizeof(bits));
+            return x;
+        }
+
+        std::uint16_t bits() const
+        {
+            std::uint16_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+
+        _Float16 value;
+    };
+#else
+    struct float16 {
+        float16() = default;
+
+        float16(float x)
+            : bits_ { detail::float_to_half(x) }
+        {
+        }
+
+        operator float() const { return detail::half_to_float(bits_); }
+
+        static float16 from_bits(std::uint16_t bits)
+        {
+            float16 x;
+            x.bits_ = bits;
+            return x;
+        }
+
+        std::uint16_t bits() const { return bits_; }
+
+    private:
+        std::uint16_t bits_;
+    };
+#endif
+
+    // The upper half of a float.
+    struct bfloat16 {
+        bfloat16() = default;
+
+        bfloat16(float x)
+        {
+            std::uint32_t bits = detail::bits_of_float(x);
+            if ((bits & 0x7fffffff) > 0x7f800000)
+                bits_ = static_cast<std::uint16_t>((bits >> 16) | 0x40);
+            else
+                bits_ = static_cast<std::uint16_t>((bits + 0x7fff + ((bits >> 16) & 1)) >> 16);
+        }
+
+        operator float() const { return detail::float_of_bits(std::uint32_t(bits_) << 16); }
+
+        static bfloat16 from_bits(std::uint16_t bits)
+        {
+            bfloat16 x;
+            x.bits_ = bits;
+            return x;
+        }
+
+        std::uint16_t bits() const { return bits_; }
+
+    private:
+        std::uint16_t bits_;
+    };
+
+    // Lane types: fixed-point Q formats.
+    //
+    // fixed<Int, FracBits> holds a signed 8-, 16- or 32-bit integer whose
+    // value is raw / 2^FracBits; q15 covers [-1, 1) in steps of 2^-15. Like
+    // float16 it converts to and from float (double for 32-bit formats), so
+    // load_from and store_to convert whole vectors, and transform and fir
+    // compute on it directly. Arithmetic saturates instead of wrapping.
+    // Products round to nearest with ties up, like pmulhrsw, and take the
+    // format of the left operand, so a Q15 signal can be scaled by Q14
+    // coefficients. A 16-bit value times a Q15 one compiles to pmulhrsw;
+    // other products, and every sum, compute in the integer twice as wide,
+    // since gcc 12 does not match paddsw. Q15 arithmetic stays slower than
+    // float: the type is for exact, compact storage, not for speed.
+    namespace detail {
+        template <typename Int>
+        using wide_int_t = std::conditional_t<sizeof(Int) <= 2, std::int32_t, std::int64_t>;
+
+        template <typename Int, typename Wide>
+        constexpr Int saturate(Wide x)
+        {
+            using limits = std::numeric_limits<Int>;
+            return static_cast<Int>(x < limits::min() ? limits::min() : x > limits::max() ? limits::max() : x);
+        }
+
+    } // namespace detail
+
+    template <typename Int, unsigned FracBits>
+    struct fixed {
+        static_assert(std::is_signed_v<Int> && std::is_integral_v<Int> && sizeof(Int) <= 4, "fixed holds int8_t, int16_t or int32_t");
+        static_assert(FracBits < 8 * sizeof(Int), "FracBits leaves no room for the sign");
+
+        using raw_type = Int;
+
+        // 32-bit formats convert through double, which holds them exactly.
+        using real_type = std::conditional_t<sizeof(Int) <= 2, float, double>;
+
+        static constexpr unsigned frac_bits = FracBits;
+
+        fixed() = default;
+
+        // Rounds to nearest even and saturates; NaN converts to 0.
+        fixed(real_type x)
+            : raw_ { from_real(x) }
+        {
+        }
+
+        constexpr operator real_type() const { return static_cast<real_type>(raw_) / scale; }
+
+        static constexpr fixed from_raw(Int raw) { return { raw_tag {}, raw }; }
+
+        constexpr Int raw() const { return raw_; }
+
+    private:
+        struct raw_tag {
+        };
+
+        constexpr fixed(raw_tag, Int raw)
+            : raw_ { raw }
+        {
+        }
+
+        static constexpr real_type scale = static_cast<real_type>(std::uint64_t { 1 } << FracBits);
+
+        static Int from_real(real_type x)
+        {
+            using limits = std::numeric_limits<Int>;
+
+            x = x == x ? x * scale : 0;
+            x = x < limits::min() ? limits::min() : x > limits::max() ? limits::max() : x;
+            return static_cast<Int>(std::nearbyint(x));
+        }
+
+        Int raw_;
+    };
+
+    using q7 = fixed<std::int8_t, 7>;
+
+    using q15 = fixed<std::int16_t, 15>;
+
+    using q31 = fixed<std::int32_t, 31>;
+
+    template <typename Int, unsigned F>
+    constexpr fixed<Int, F> operator+(fixed<Int, F> x, fixed<Int, F> y)
+    {
+        using Wide = detail::wide_int_t<Int>;
+        return fixed<Int, F>::from_raw(detail::saturate<Int>(Wide { x.raw() } + y.raw()));
+    }
+
+    template <typename Int, unsigned F>
+    constexpr fixed<Int, F> operator-(fixed<Int, F> x, fixed<Int, F> y)
+    {
+        using Wide = detail::wide_int_t<Int>;
+        return fixed<Int, F>::from_raw(detail::saturate<Int>(Wide { x.raw() } - y.raw()));
+    }
+
+    template <typename Int, unsigned F>
+    constexpr fixed<Int, F> operator-(fixed<Int, F> x)
+    {
+        using Wide = detail::wide_int_t<Int>;
+        return fixed<Int, F>::from_raw(detail::saturate<Int>(-Wide { x.raw() }));
+    }
+
+    template <typename Int, unsigned F, unsigned G>
+    constexpr fixed<Int, F> operator*(fixed<Int, F> x, fixed<Int, G> y)
+    {
+        using Wide = detail::wide_int_t<Int>;
+
+        // A 16-bit value times a Q15 one is pmulhrsw, written in the form gcc
+        // matches. Only -1 * -1 overflows, to -1 instead of the largest
+        // value, and the xor turns one into the other.
+        if constexpr (sizeof(Int) == 2 && G == 15) {
+            constexpr Int min = std::numeric_limits<Int>::min();
+
+            auto rounded = static_cast<Int>(((Wide { x.raw() } * y.raw() >> 14) + 1) >> 1);
+            return fixed<Int, F>::from_raw(static_cast<Int>(rounded ^ -((x.raw() == min) & (y.raw() == min))));
+        }
+
+        Wide product = Wide { x.raw() } * y.raw();
+        if constexpr (G > 0)
+            product = (product + (Wide { 1 } << (G - 1))) >> G;
+        return fixed<Int, F>::from_raw(detail::saturate<Int>(product));
+    }
+
+    template <typename Int, unsigned F>
+    constexpr bool operator==(fixed<Int, F> x, fixed<Int, F> y)
+    {
+        return x.raw() == y.raw();
+    }
+
+    template <typename Int, unsigned F>
+    constexpr bool operator!=(fixed<Int, F> x, fixed<Int, F> y)
+    {
+        return x.raw() != y.raw();
+    }
+
+    template <typename Int, unsigned F>
+    constexpr bool operator<(fixed<Int, F> x, fixed<Int, F> y)
+    {
+        return x.raw() < y.raw();
+    }
+
+    template <typename Int, unsigned F>
+    constexpr bool operator>(fixed<Int, F> x, fixed<Int, F> y)
+    {
+        return x.raw() > y.raw();
+    }
+
+    template <typename Int, unsigned F>
+    constexpr bool operator<=(fixed<Int, F> x, fixed<Int, F> y)
+    {
+        return x.raw() <= y.raw();
+    }
+
+    template <typename Int, unsigned F>
+    constexpr bool operator>=(fixed<Int, F> x, fixed<Int, F> y)
+    {
+        return x.raw() >= y.raw();
+    }
+
+    inline namespace trait {
+        // The type that algorithms compute in for elements stored as T.
+        template <typename T>
+        struct compute_type {
+            using type = T;
+        };
+
+        template <>
+        struct compute_type<float16> {
+            using type = float;
+        };
+
+        template <>
+        struct compute_type<bfloat16> {
+            using type = float;
+        };
+
+        template <typename T>
+        using compute_type_t = typename compute_type<T>::type;
+
+    } // namespace trait
+
     namespace detail {
+        template <typename T>
+        struct is_tuple : std::false_type {
+        };
+
+        template <typename... Ts>
+        struct is_tuple<std::tuple<Ts...>> : std::true_type {
+        };
+
+        template <size_t I, typename F, typename... Vs>
+        constexpr auto apply_lane(F& func, const Vs&... vss)
+        {
+            return func(vss[I]...);
+        }
+
+        template <typename V, size_t K, typename R, size_t N, size_t... Is>
+        constexpr auto lane_component(const std::array<R, N>& results, std::index_sequence<Is...>)
+        {
+            return typename V::template with_value_t<std::tuple_element_t<K, R>> { std::get<K>(results[Is])... };
+        }
+
+        // Splits the lane results of a function that returns a tuple into a
+        // tuple of vectors.
+        template <typename V, typename R, size_t N, size_t... Ks, typename Lanes>
+        constexpr auto split_lanes(const std::array<R, N>& results, std::index_sequence<Ks...>, Lanes lanes)
+        {
+            return std::tuple { lane_component<V, Ks>(results, lanes)... };
+        }
+
         template <typename F, typename V, size_t... Is>
         constexpr auto unroll_impl(F func, V xs, std::index_sequence<Is...>)
             -> typename V::template with_value_t<decltype(func(xs[0]))>
@@ -125,12 +509,29 @@ namespace pure_simd {
             return { func(xs[Is], ys[Is], zs[Is])... };
         }
 
+        // The fixed arities expand func directly, which gcc inlines more
+        // readily than through apply_lane when vectors are wide.
+        template <typename F, typename V0, typename... Vs, size_t... Is>
+        constexpr auto unroll_variadic(F func, std::index_sequence<Is...> lanes, const V0& xs, const Vs&... vss)
+        {
+            using R = decltype(func(xs[0], vss[0]...));
+
+            if constexpr (is_tuple<R>::value) {
+                std::array<R, V0::size()> results { apply_lane<Is>(func, xs, vss...)... };
+                return split_lanes<V0>(results, std::make_index_sequence<std::tuple_size_v<R>> {}, lanes);
+            } else if constexpr (sizeof...(Vs) < 3) {
+                return unroll_impl(func, xs, vss..., lanes);
+            } else {
+                return typename V0::template with_value_t<R> { apply_lane<Is>(func, xs, vss...)... };
+            }
+        }
+
     } // namespace detail
 
     template <typename F, typename V, typename = must_be_vector<V>>
     constexpr auto unroll(F func, V xs)
     {
-        return detail::unroll_impl(func, xs, index_sequence_of<V> {});
+        return detail::unroll_variadic(func, index_sequence_of<V> {}, xs);
     }
 
     template <
@@ -140,7 +541,7 @@ namespace pure_simd {
         typename = assert_same_size<V0, V1>>
     constexpr auto unroll(F func, V0 xs, V1 ys)
     {
-        return detail::unroll_impl(func, xs, ys, index_sequence_of<V0> {});
+        return detail::unroll_variadic(func, index_sequence_of<V0> {}, xs, ys);
     }
 
     template <
@@ -152,13 +553,24 @@ namespace pure_simd {
         typename = assert_same_size<V0, V2>>
     constexpr auto unroll(F func, V0 xs, V1 ys, V2 zs)
     {
-        return detail::unroll_impl(func, xs, ys, zs, index_sequence_of<V0> {});
+        return detail::unroll_variadic(func, index_sequence_of<V0> {}, xs, ys, zs);
+    }
+
+    // Applies func lane-wise to any number of vectors of the same size. When
+    // func returns a std::tuple, the result is a std::tuple of vectors.
+    template <
+        typename F, typename V0, typename... Vs,
+        typename = must_be_vector<V0>,
+        typename = std::enable_if_t<(is_vector<Vs>::value && ...) && (same_size<V0, Vs>::value && ...)>>
+    constexpr auto unroll(F func, V0 xs, Vs... vss)
+    {
+        return detail::unroll_variadic(func, index_sequence_of<V0> {}, xs, vss...);
     }
 
     template <typename F, typename V, typename = must_be_vector<V>>
     constexpr auto unroll(V xs, F func)
     {
-        return detail::unroll_impl(func, xs, index_sequence_of<V> {});
+        return detail::unroll_variadic(func, index_sequence_of<V> {}, xs);
     }
 
     template <
@@ -168,7 +580,7 @@ namespace pure_simd {
         typename = assert_same_size<V0, V1>>
     constexpr auto unroll(V0 xs, V1 ys, F func)
     {
-        return detail::unroll_impl(func, xs, ys, index_sequence_of<V0> {});
+        return detail::unroll_variadic(func, index_sequence_of<V0> {}, xs, ys);
     }
 
     template <
@@ -180,7 +592,7 @@ namespace pure_simd {
         typename = assert_same_size<V0, V2>>
     constexpr auto unroll(V0 xs, V1 ys, V2 zs, F func)
     {
-        return detail::unroll_impl(func, xs, ys, zs, index_sequence_of<V0> {});
+        return detail::unroll_variadic(func, index_sequence_of<V0> {}, xs, ys, zs);
     }
 
 #define OVERLOAD_BINARY_OPERATOR(op)                                  \
@@ -426,12 +838,41 @@ namespace pure_simd {
         return detail::load_from_impl<V>(src, index_sequence_of<V> {});
     }
 
+    // Fixed-point lanes move through a loop, which gcc vectorizes together
+    // with their conversions. Unrolled, it copies them one by one.
+    template <typename V, typename Int, unsigned F, typename = must_be_vector<V>>
+    inline V load_from(const fixed<Int, F>* src)
+    {
+        if constexpr (std::is_same_v<typename V::value_type, fixed<Int, F>>)
+            return detail::load_from_impl<V>(src, index_sequence_of<V> {});
+
+        V xs;
+        for (size_t k = 0; k < V::size(); ++k)
+            xs[k] = static_cast<typename V::value_type>(src[k]);
+        return xs;
+    }
+
+    template <typename V, typename Int, unsigned F, typename = must_be_vector<V>>
+    inline void store_to(V xs, fixed<Int, F>* dst)
+    {
+        for (size_t k = 0; k < V::size(); ++k)
+            dst[k] = static_cast<fixed<Int, F>>(xs[k]);
+    }
+
     namespace detail {
 
         template <typename V, typename T, typename S, typename I, I... Is>
         constexpr V iota_impl(T start, S step, std::integer_sequence<I, Is...>)
         {
-            return { (start + step * Is)... };
+            using L = typename V::value_type;
+
+            // Integers narrower than int promote to int in the arithmetic, so
+            // only those lanes are cast back; everything else keeps the
+            // narrowing check of the braces.
+            if constexpr (std::is_integral_v<L> && sizeof(L) < sizeof(int) && std::is_integral_v<T> && std::is_integral_v<S>)
+                return { static_cast<L>(start + step * Is)... };
+            else
+                return { (start + step * Is)... };
         };
 
     } // namespace detail
@@ -540,6 +981,66 @@ namespace pure_simd {
         return detail::gather_bits_impl<T>(xs, index_sequence_of<V> {});
     }
 
+    namespace detail {
+        // Like gather_bits, but collects the bits eight lanes at a time: the
+        // lanes are narrowed to bytes of 0 or 1, reinterpreted as 64-bit words
+        // and packed by a multiplication, which compilers keep in vector registers.
+        template <typename V>
+        inline std::uint64_t bitmask(V xs)
+        {
+            static_assert(V::size() <= 64);
+
+            constexpr size_t words = (V::size() + 7) / 8;
+
+            vector<std::uint8_t, words * 8> bytes {};
+            for (size_t i = 0; i < V::size(); ++i)
+                bytes[i] = xs[i] != 0;
+
+            std::uint64_t packed[words];
+            std::memcpy(packed, bytes.data, sizeof(packed));
+
+            std::uint64_t bits = 0;
+            for (size_t i = 0; i < words; ++i)
+                bits |= ((packed[i] * 0x0102040810204080ull) >> 56) << (8 * i);
+
+            return bits;
+        }
+
+        inline int countr_zero(std::uint64_t bits)
+        {
+#if defined(__GNUC__)
+            return __builtin_ctzll(bits);
+#else
+            int n = 0;
+            for (; (bits & 1) == 0; bits >>= 1)
+                ++n;
+            return n;
+#endif
+        }
+
+        // bits must not be zero.
+        inline int countl_zero(std::uint64_t bits)
+        {
+#if defined(__GNUC__)
+            return __builtin_clzll(bits);
+#else
+            int n = 0;
+            for (; (bits >> 63) == 0; bits <<= 1)
+                ++n;
+            return n;
+#endif
+        }
+
+        // Calls `func` with the index of every set bit, from the lowest up.
+        template <typename F>
+        inline void for_each_bit(std::uint64_t bits, F func)
+        {
+            for (; bits != 0; bits &= bits - 1)
+                func(static_cast<size_t>(countr_zero(bits)));
+        }
+
+    } // namespace detail
+
     // Operations: sum.
     namespace detail {
         template <typename V, typename T, size_t... Is>
@@ -555,71 +1056,612 @@ namespace pure_simd {
         return detail::sum_impl(x, init, index_sequence_of<V> {});
     }
 
-    // Algorithms: transform, accumulate, and inner_product.
-    template <size_t VectorSize, typename F, typename T, typename S>
-    constexpr void transform(const S* src, size_t n, T* dst, F func)
-    {
-        using SourceVec = pure_simd::vector<S, VectorSize>;
+    // Operations: complex vectors.
+    //
+    // complex_vector keeps the real and the imaginary parts in separate
+    // vectors (split, or SoA, layout), so that every operation is a handful
+    // of lane-wise vector operations without shuffles.
+    template <typename T, size_t N, size_t Align = 32>
+    struct complex_vector {
+        using value_type = T;
 
-        auto rem = n % VectorSize;
-        auto loops = n / VectorSize;
+        using vector_type = vector<T, N, Align>;
 
-        for (size_t i = 0; i < loops; ++i, src += VectorSize, dst += VectorSize)
-            store_to(unroll(load_from<SourceVec>(src), func), dst);
+        static constexpr size_t size() { return N; }
 
-        std::transform(src, src + rem, dst, func);
-    }
+        vector_type re;
 
-    template <size_t VectorSize, typename F, typename T, typename S0, typename S1>
-    constexpr void transform(const S0* src0, size_t n, const S1* src1, T* dst, F func)
-    {
-        using Source0Vec = pure_simd::vector<S0, VectorSize>;
-        using Source1Vec = pure_simd::vector<S1, VectorSize>;
+        vector_type im;
+    };
 
-        auto rem = n % VectorSize;
-        auto loops = n / VectorSize;
+    inline namespace trait {
+        template <typename T>
+        struct is_complex_vector : std::false_type {
+        };
 
-        for (size_t i = 0; i < loops; ++i, src0 += VectorSize, src1 += VectorSize, dst += VectorSize)
-            store_to(unroll(load_from<Source0Vec>(src0), load_from<Source1Vec>(src1), func), dst);
+        template <typename T, size_t N, size_t A>
+        struct is_complex_vector<complex_vector<T, N, A>> : std::true_type {
+        };
+
+        template <typename T>
+        using must_be_complex_vector = std::enable_if_t<is_complex_vector<T>::value>;
+
+    } // namespace trait
 
-        std::transform(src0, src0 + rem, src1, dst, func);
+    template <typename T, size_t N, size_t A>
+    constexpr complex_vector<T, N, A> operator+(complex_vector<T, N, A> xs, complex_vector<T, N, A> ys)
+    {
+        return { xs.re + ys.re, xs.im + ys.im };
     }
 
-    template <size_t VectorSize, typename T, typename S, typename F>
-    constexpr auto accumulate(const S* src, size_t n, T init, F func)
+    template <typename T, size_t N, size_t A>
+    constexpr complex_vector<T, N, A> operator-(complex_vector<T, N, A> xs, complex_vector<T, N, A> ys)
     {
-        using Source = vector<S, VectorSize>;
-        using Target = vector<T, VectorSize>;
+        return { xs.re - ys.re, xs.im - ys.im };
+    }
 
-        auto rem = n % VectorSize;
-        auto loops = n / VectorSize;
+    template <typename T, size_t N, size_t A>
+    constexpr complex_vector<T, N, A> operator*(complex_vector<T, N, A> xs, complex_vector<T, N, A> ys)
+    {
+        return { xs.re * ys.re - xs.im * ys.im, xs.re * ys.im + xs.im * ys.re };
+    }
 
-        auto sum = scalar<Target>(init);
-        for (size_t i = 0; i < loops; ++i, src += VectorSize)
-            sum = unroll(sum, load_from<Source>(src), func);
+    template <typename T, size_t N, size_t A>
+    constexpr complex_vector<T, N, A> conj(complex_vector<T, N, A> xs)
+    {
+        return { xs.re, -xs.im };
+    }
 
-        std::transform(src, src + rem, sum.begin(), sum.begin(), [&](auto val, auto curr) {
-            return func(curr, val);
-        });
+    // Returns xs * conj(ys), as used by correlations.
+    template <typename T, size_t N, size_t A>
+    constexpr complex_vector<T, N, A> conj_multiply(complex_vector<T, N, A> xs, complex_vector<T, N, A> ys)
+    {
+        return { xs.re * ys.re + xs.im * ys.im, xs.im * ys.re - xs.re * ys.im };
+    }
 
-        return sum;
+    // Returns the squared magnitudes.
+    template <typename T, size_t N, size_t A>
+    constexpr vector<T, N, A> norm(complex_vector<T, N, A> xs)
+    {
+        return xs.re * xs.re + xs.im * xs.im;
     }
 
-    template <size_t VectorSize, typename T, typename S>
-    constexpr auto accumulate(const S* src, size_t n, T init)
+    // Returns the magnitudes.
+    template <typename T, size_t N, size_t A>
+    constexpr vector<T, N, A> abs(complex_vector<T, N, A> xs)
     {
-        return accumulate<VectorSize>(src, n, init, std::plus<>());
+        return unroll(norm(xs), [](T x) { return std::sqrt(x); });
     }
 
-    template <size_t VectorSize, typename T, typename S1, typename S2, typename FAdd, typename FMultiply>
-    constexpr auto inner_product(const S1* src1, size_t n, const S2* src2, T init, FAdd f_add, FMultiply f_multiply)
+    template <typename V, typename T, typename = must_be_complex_vector<V>>
+    constexpr V load_from(const T* re, const T* im)
     {
-        using Source1 = vector<S1, VectorSize>;
-        using Source2 = vector<S2, VectorSize>;
-        using Target = vector<T, VectorSize>;
+        using Vec = typename V::vector_type;
+        return { load_from<Vec>(re), load_from<Vec>(im) };
+    }
 
-        auto rem = n % VectorSize;
-        auto loops = n / VectorSize;
+    template <typename T, size_t N, size_t A>
+    constexpr void store_to(complex_vector<T, N, A> xs, T* re, T* im)
+    {
+        store_to(xs.re, re);
+        store_to(xs.im, im);
+    }
+
+    // Operations: any, all, and none.
+    namespace detail {
+        template <typename V, size_t... Is>
+        constexpr bool any_impl(V xs, std::index_sequence<Is...>)
+        {
+            return (false | ... | static_cast<bool>(xs[Is]));
+        }
+
+        template <typename V, size_t... Is>
+        constexpr bool all_impl(V xs, std::index_sequence<Is...>)
+        {
+            return (true & ... & static_cast<bool>(xs[Is]));
+        }
+
+    } // namespace detail
+
+    template <typename V, typename = must_be_vector<V>>
+    constexpr bool any(V xs)
+    {
+        return detail::any_impl(xs, index_sequence_of<V> {});
+    }
+
+    template <typename V, typename = must_be_vector<V>>
+    constexpr bool all(V xs)
+    {
+        return detail::all_impl(xs, index_sequence_of<V> {});
+    }
+
+    template <typename V, typename = must_be_vector<V>>
+    constexpr bool none(V xs)
+    {
+        return !any(xs);
+    }
+
+    // Operations: popcount, countl_zero, countr_zero, rotl, rotr, and byteswap.
+    //
+    // Lane by lane like the functions of <bit>, on vectors of unsigned
+    // integers, except byteswap, which takes any integers. Counts come back
+    // in lanes of the same type. The lane forms are ones gcc vectorizes:
+    // shifts, masks and adds, and vpopcnt where the target has it.
+    namespace detail {
+        // Bits are counted in pairs, nibbles, and bytes, whose counts are
+        // then added up, unless the target counts the bits of 32-bit and
+        // 64-bit lanes itself.
+        template <typename T>
+        constexpr T popcount_lane(T x)
+        {
+#if defined(__AVX512VPOPCNTDQ__)
+            if constexpr (sizeof(T) == 8)
+                return static_cast<T>(__builtin_popcountll(x));
+            else if constexpr (sizeof(T) == 4)
+                return static_cast<T>(__builtin_popcount(x));
+#endif
+            constexpr T ones = static_cast<T>(~T {}) / 255;
+
+            x = static_cast<T>(x - ((x >> 1) & (ones * 0x55)));
+            x = static_cast<T>((x & (ones * 0x33)) + ((x >> 2) & (ones * 0x33)));
+            x = static_cast<T>((x + (x >> 4)) & (ones * 0x0f));
+            for (unsigned shift = 8; shift < 8 * sizeof(T); shift *= 2)
+                x = static_cast<T>(x + (x >> shift));
+            return static_cast<T>(x & 0xff);
+        }
+
+        // The leading zeros are the bits left clear once the highest set bit
+        // is copied into every lower one.
+        template <typename T>
+        constexpr T countl_zero_lane(T x)
+        {
+            for (unsigned shift = 1; shift < 8 * sizeof(T); shift *= 2)
+                x = static_cast<T>(x | (x >> shift));
+            return popcount_lane(static_cast<T>(~x));
+        }
+
+        // The trailing zeros are the bits set in ~x & (x - 1).
+        template <typename T>
+        constexpr T countr_zero_lane(T x)
+        {
+            return popcount_lane(static_cast<T>(~x & (x - 1)));
+        }
+
+        // Rotates left by s modulo the width, which takes a negative shift
+        // in two's complement as a right rotation.
+        template <typename T>
+        constexpr T rotl_lane(T x, unsigned s)
+        {
+            constexpr unsigned width = 8 * sizeof(T);
+
+            unsigned r = s % width;
+            return static_cast<T>((x << r) | (x >> ((width - r) % width)));
+        }
+
+        template <typename T>
+        constexpr T byteswap_lane(T x)
+        {
+            using U = std::make_unsigned_t<T>;
+
+            auto u = static_cast<U>(x);
+            if constexpr (sizeof(T) == 1) {
+                return x;
+            } else if constexpr (sizeof(T) == 2) {
+                return static_cast<T>(static_cast<U>(u << 8 | u >> 8));
+            } else {
+#if defined(__GNUC__)
+                if constexpr (sizeof(T) == 4)
+                    return static_cast<T>(__builtin_bswap32(u));
+                else
+                    return static_cast<T>(__builtin_bswap64(u));
+#else
+                U swapped = 0;
+                for (size_t i = 0; i < sizeof(T); ++i, u >>= 8)
+                    swapped = static_cast<U>(swapped << 8 | (u & 0xff));
+                return static_cast<T>(swapped);
+#endif
+            }
+        }
+
+        template <typename V>
+        constexpr void assert_unsigned_lanes()
+        {
+            static_assert(std::is_unsigned_v<typename V::value_type>, "bit operations take unsigned lanes");
+        }
+
+    } // namespace detail
+
+    template <typename V, typename = must_be_vector<V>>
+    constexpr V popcount(V xs)
+    {
+        detail::assert_unsigned_lanes<V>();
+        return unroll(xs, [](auto a) { return detail::popcount_lane(a); });
+    }
+
+    template <typename V, typename = must_be_vector<V>>
+    constexpr V countl_zero(V xs)
+    {
+        detail::assert_unsigned_lanes<V>();
+        return unroll(xs, [](auto a) { return detail::countl_zero_lane(a); });
+    }
+
+    template <typename V, typename = must_be_vector<V>>
+    constexpr V countr_zero(V xs)
+    {
+        detail::assert_unsigned_lanes<V>();
+        return unroll(xs, [](auto a) { return detail::countr_zero_lane(a); });
+    }
+
+    // Rotates every lane left by s bits; a negative s rotates right.
+    template <typename V, typename = must_be_vector<V>>
+    constexpr V rotl(V xs, int s)
+    {
+        detail::assert_unsigned_lanes<V>();
+        return unroll(xs, [s](auto a) { return detail::rotl_lane(a, static_cast<unsigned>(s)); });
+    }
+
+    template <typename V, typename = must_be_vector<V>>
+    constexpr V rotr(V xs, int s)
+    {
+        detail::assert_unsigned_lanes<V>();
+        return unroll(xs, [s](auto a) { return detail::rotl_lane(a, 0u - static_cast<unsigned>(s)); });
+    }
+
+    template <typename V, typename = must_be_vector<V>>
+    constexpr V byteswap(V xs)
+    {
+        static_assert(std::is_integral_v<typename V::value_type>, "byteswap takes integer lanes");
+        return unroll(xs, [](auto a) { return detail::byteswap_lane(a); });
+    }
+
+    // Operations: sort and merge.
+    namespace detail {
+        template <typename V, size_t... Is>
+        constexpr V reverse_impl(V xs, std::index_sequence<Is...>)
+        {
+            return { xs[V::size() - 1 - Is]... };
+        }
+
+        template <typename V>
+        constexpr V reverse(V xs)
+        {
+            return reverse_impl(xs, index_sequence_of<V> {});
+        }
+
+        template <typename V, size_t... Is>
+        constexpr auto concat_impl(V xs, V ys, std::index_sequence<Is...>)
+            -> vector<typename V::value_type, 2 * V::size(), V::align()>
+        {
+            return { (Is < V::size() ? xs[Is % V::size()] : ys[Is % V::size()])... };
+        }
+
+        template <typename V>
+        constexpr auto concat(V xs, V ys)
+        {
+            return concat_impl(xs, ys, std::make_index_sequence<2 * V::size()> {});
+        }
+
+        template <typename V, size_t Offset, size_t... Is>
+        constexpr auto half_impl(V xs, std::index_sequence<Is...>)
+            -> vector<typename V::value_type, V::size() / 2, V::align()>
+        {
+            return { xs[Offset + Is]... };
+        }
+
+        template <size_t Half, typename V>
+        constexpr auto half(V xs)
+        {
+            return half_impl<V, Half * V::size() / 2>(xs, std::make_index_sequence<V::size() / 2> {});
+        }
+
+        template <size_t J, typename V, size_t... Is>
+        constexpr V exchange_lanes_impl(V xs, std::index_sequence<Is...>)
+        {
+            return { xs[Is ^ J]... };
+        }
+
+        // One compare-exchange step of a bitonic network: lane i is compared
+        // with lane i ^ J and keeps the smaller key if it lies in the lower
+        // half of an ascending block (or the upper half of a descending one).
+        // Blocks of size K alternate in direction. The payloads follow their keys.
+        template <size_t K, size_t J, typename V, typename... Ws, size_t... Is>
+        constexpr void bitonic_step_impl(std::index_sequence<Is...>, V& keys, Ws&... payloads)
+        {
+            using mask_type = typename V::template with_value_t<bool>;
+
+            constexpr mask_type keeps_min { (((Is & J) == 0) == ((Is & K) == 0))... };
+
+            const V others = exchange_lanes_impl<J>(keys, index_sequence_of<V> {});
+            const mask_type swaps = unroll(keeps_min, keys, others, [](bool min, auto a, auto b) {
+                return min ? b < a : a < b;
+            });
+
+            auto choose = [&](auto xs) {
+                return unroll(swaps, xs, exchange_lanes_impl<J>(xs, index_sequence_of<V> {}), [](bool swap, auto a, auto b) {
+                    return swap ? b : a;
+                });
+            };
+
+            keys = choose(keys);
+            ((payloads = choose(payloads)), ...);
+        }
+
+        template <size_t K, size_t J, typename V, typename... Ws>
+        constexpr void bitonic_merge_steps(V& keys, Ws&... payloads)
+        {
+            bitonic_step_impl<K, J>(index_sequence_of<V> {}, keys, payloads...);
+
+            if constexpr (J > 1)
+                bitonic_merge_steps<K, J / 2>(keys, payloads...);
+        }
+
+        template <size_t K, typename V, typename... Ws>
+        constexpr void bitonic_sort_steps(V& keys, Ws&... payloads)
+        {
+            if constexpr (K <= V::size()) {
+                bitonic_merge_steps<K, K / 2>(keys, payloads...);
+                bitonic_sort_steps<2 * K>(keys, payloads...);
+            }
+        }
+
+    } // namespace detail
+
+    // Sorts the lanes of `keys` in ascending order with a bitonic network.
+    // The size of the vector must be a power of two.
+    template <typename V, typename = must_be_vector<V>>
+    constexpr V sort(V keys)
+    {
+        static_assert(detail::is_power_of_two(V::size()));
+
+        detail::bitonic_sort_steps<2>(keys);
+        return keys;
+    }
+
+    // Sorts `keys` in ascending order and applies the same permutation to `payloads`.
+    template <
+        typename V, typename W,
+        typename = must_be_vector<V>,
+        typename = must_be_vector<W>,
+        typename = assert_same_size<V, W>>
+    constexpr std::pair<V, W> sort(V keys, W payloads)
+    {
+        static_assert(detail::is_power_of_two(V::size()));
+
+        detail::bitonic_sort_steps<2>(keys, payloads);
+        return { keys, payloads };
+    }
+
+    // Merges two sorted vectors. The first vector of the result holds the
+    // smaller half of the lanes, the second the larger one, both sorted.
+    template <typename V, typename = must_be_vector<V>>
+    constexpr std::pair<V, V> merge(V xs, V ys)
+    {
+        static_assert(detail::is_power_of_two(V::size()));
+
+        auto keys = detail::concat(xs, detail::reverse(ys));
+        detail::bitonic_merge_steps<2 * V::size(), V::size()>(keys);
+
+        return { detail::half<0>(keys), detail::half<1>(keys) };
+    }
+
+    namespace detail {
+        // Swaps the payload lanes of `xs` and `ys` where `his` is less than
+        // `los`. Integer lanes are swapped with masks, which compilers
+        // vectorize more reliably than selections.
+        template <typename V, typename W>
+        constexpr void exchange_if_less(V los, V his, W& xs, W& ys)
+        {
+            using T = typename W::value_type;
+
+            if constexpr (std::is_integral_v<T>) {
+                auto masks = unroll(los, his, [](auto lo, auto hi) { return static_cast<T>(-static_cast<T>(hi < lo)); });
+                auto diffs = cast_to<T>((xs ^ ys) & masks);
+                xs = cast_to<T>(xs ^ diffs);
+                ys = cast_to<T>(ys ^ diffs);
+            } else {
+                auto swaps = his < los;
+                auto choose = [](bool swap, auto a, auto b) { return swap ? b : a; };
+                auto new_xs = unroll(swaps, xs, ys, choose);
+                ys = unroll(swaps, ys, xs, choose);
+                xs = new_xs;
+            }
+        }
+
+        // One step of a bitonic network over the vectors of an array: every
+        // lane is compare-exchanged between keys[i] and keys[i ^ J], so the
+        // lanes are sorted across the vectors independently of each other.
+        template <size_t K, size_t J, typename V, size_t M, typename... Ws>
+        constexpr void column_step(std::array<V, M>& keys, std::array<Ws, M>&... payloads)
+        {
+            for (size_t i = 0; i < M; ++i) {
+                auto partner = i ^ J;
+                if (partner < i)
+                    continue;
+
+                auto lo = (i & K) == 0 ? i : partner;
+                auto hi = i + partner - lo;
+
+                (exchange_if_less(keys[lo], keys[hi], payloads[lo], payloads[hi]), ...);
+
+                auto mins = min(keys[lo], keys[hi]);
+                keys[hi] = max(keys[lo], keys[hi]);
+                keys[lo] = mins;
+            }
+        }
+
+        template <size_t K, size_t J, typename V, size_t M, typename... Ws>
+        constexpr void column_merge_steps(std::array<V, M>& keys, std::array<Ws, M>&... payloads)
+        {
+            column_step<K, J>(keys, payloads...);
+
+            if constexpr (J > 1)
+                column_merge_steps<K, J / 2>(keys, payloads...);
+        }
+
+        template <size_t K, typename V, size_t M, typename... Ws>
+        constexpr void column_sort_steps(std::array<V, M>& keys, std::array<Ws, M>&... payloads)
+        {
+            if constexpr (K <= M) {
+                column_merge_steps<K, K / 2>(keys, payloads...);
+                column_sort_steps<2 * K>(keys, payloads...);
+            }
+        }
+
+    } // namespace detail
+
+    // Sorts every lane across the vectors of `keys`, so that afterwards
+    // keys[0][i] <= keys[1][i] <= ... for each lane i. Only lane-wise min and
+    // max are needed. The number of vectors must be a power of two.
+    template <typename V, size_t M, typename = must_be_vector<V>>
+    constexpr std::array<V, M> sort_columns(std::array<V, M> keys)
+    {
+        static_assert(detail::is_power_of_two(M));
+
+        detail::column_sort_steps<2>(keys);
+        return keys;
+    }
+
+    // Sorts the columns of `keys` and applies the same permutations to `payloads`.
+    template <
+        typename V, typename W, size_t M,
+        typename = must_be_vector<V>,
+        typename = must_be_vector<W>,
+        typename = assert_same_size<V, W>>
+    constexpr std::pair<std::array<V, M>, std::array<W, M>> sort_columns(std::array<V, M> keys, std::array<W, M> payloads)
+    {
+        static_assert(detail::is_power_of_two(M));
+
+        detail::column_sort_steps<2>(keys, payloads);
+        return { keys, payloads };
+    }
+
+    // Algorithms: transform, accumulate, and inner_product.
+    struct prefetch_options;
+
+    // The constraint keeps transform(dst, n, func, src) from matching here
+    // when func is a function pointer.
+    template <size_t VectorSize, typename F, typename T, typename S, typename = std::enable_if_t<!std::is_function_v<T>>>
+    constexpr void transform(const S* src, size_t n, T* dst, F func)
+    {
+        using SourceVec = pure_simd::vector<compute_type_t<S>, VectorSize>;
+
+        auto rem = n % VectorSize;
+        auto loops = n / VectorSize;
+
+        for (size_t i = 0; i < loops; ++i, src += VectorSize, dst += VectorSize)
+            store_to(unroll(load_from<SourceVec>(src), func), dst);
+
+        std::transform(src, src + rem, dst, [&](compute_type_t<S> x) { return func(x); });
+    }
+
+    // The constraint keeps transform(src, n, dst, func, prefetch_options)
+    // and transform(dst, n, func, src0, src1) from matching here when func
+    // is a function pointer.
+    template <
+        size_t VectorSize, typename F, typename T, typename S0, typename S1,
+        typename = std::enable_if_t<!std::is_same_v<F, prefetch_options> && !std::is_function_v<S1>>>
+    constexpr void transform(const S0* src0, size_t n, const S1* src1, T* dst, F func)
+    {
+        using Source0Vec = pure_simd::vector<compute_type_t<S0>, VectorSize>;
+        using Source1Vec = pure_simd::vector<compute_type_t<S1>, VectorSize>;
+
+        auto rem = n % VectorSize;
+        auto loops = n / VectorSize;
+
+        for (size_t i = 0; i < loops; ++i, src0 += VectorSize, src1 += VectorSize, dst += VectorSize)
+            store_to(unroll(load_from<Source0Vec>(src0), load_from<Source1Vec>(src1), func), dst);
+
+        std::transform(src0, src0 + rem, src1, dst, [&](compute_type_t<S0> x, compute_type_t<S1> y) { return func(x, y); });
+    }
+
+    namespace detail {
+        template <typename X, typename T>
+        constexpr void store_lanes(const X& xs, T* dst)
+        {
+            if constexpr (is_vector<X>::value)
+                store_to(xs, dst);
+            else
+                *dst = xs;
+        }
+
+        // Stores every element of a tuple of vectors or of scalars to the
+        // matching pointer of `dsts`.
+        template <typename... Xs, typename... Ts>
+        constexpr void store_lanes(const std::tuple<Xs...>& xs, const std::tuple<Ts*...>& dsts)
+        {
+            std::apply([&](const auto&... ys) {
+                std::apply([&](auto*... ps) { (store_lanes(ys, ps), ...); }, dsts);
+            }, xs);
+        }
+
+        template <typename T>
+        constexpr T* advance_all(T* dst, size_t offset)
+        {
+            return dst + offset;
+        }
+
+        template <typename... Ts>
+        constexpr std::tuple<Ts*...> advance_all(const std::tuple<Ts*...>& dsts, size_t offset)
+        {
+            return std::apply([offset](auto*... ps) { return std::tuple<Ts*...> { ps + offset... }; }, dsts);
+        }
+
+    } // namespace detail
+
+    // dst[i] = func(srcs[i]...) for any number of sources in one pass. dst is
+    // a pointer, or a std::tuple of pointers when func returns a std::tuple,
+    // e.g. transform<8>(std::tuple { sums, differences }, n, func, xs, ys).
+    template <size_t VectorSize, typename D, typename F, typename... Ss>
+    constexpr void transform(D dst, size_t n, F func, const Ss*... srcs)
+    {
+        auto rem = n % VectorSize;
+        auto loops = n / VectorSize;
+
+        size_t i = 0;
+        for (size_t loop = 0; loop < loops; ++loop, i += VectorSize) {
+            auto results = unroll(func, load_from<vector<compute_type_t<Ss>, VectorSize>>(srcs + i)...);
+            detail::store_lanes(results, detail::advance_all(dst, i));
+        }
+
+        for (; rem > 0; --rem, ++i)
+            detail::store_lanes(func(compute_type_t<Ss>(srcs[i])...), detail::advance_all(dst, i));
+    }
+
+    template <size_t VectorSize, typename T, typename S, typename F>
+    constexpr auto accumulate(const S* src, size_t n, T init, F func)
+    {
+        using Source = vector<compute_type_t<S>, VectorSize>;
+        using Target = vector<T, VectorSize>;
+
+        auto rem = n % VectorSize;
+        auto loops = n / VectorSize;
+
+        auto sum = scalar<Target>(init);
+        for (size_t i = 0; i < loops; ++i, src += VectorSize)
+            sum = unroll(sum, load_from<Source>(src), func);
+
+        std::transform(src, src + rem, sum.begin(), sum.begin(), [&](compute_type_t<S> val, auto curr) {
+            return func(curr, val);
+        });
+
+        return sum;
+    }
+
+    template <size_t VectorSize, typename T, typename S>
+    constexpr auto accumulate(const S* src, size_t n, T init)
+    {
+        return accumulate<VectorSize>(src, n, init, std::plus<>());
+    }
+
+    template <size_t VectorSize, typename T, typename S1, typename S2, typename FAdd, typename FMultiply>
+    constexpr auto inner_product(const S1* src1, size_t n, const S2* src2, T init, FAdd f_add, FMultiply f_multiply)
+    {
+        using Source1 = vector<compute_type_t<S1>, VectorSize>;
+        using Source2 = vector<compute_type_t<S2>, VectorSize>;
+        using Target = vector<T, VectorSize>;
+
+        auto rem = n % VectorSize;
+        auto loops = n / VectorSize;
 
         auto sum = scalar<Target>(init);
         for (size_t i = 0; i < loops; ++i, src1 += VectorSize, src2 += VectorSize)
@@ -627,7 +1669,7 @@ namespace pure_simd {
 
         auto tar = sum.begin();
         for (size_t i = 0; i < rem; ++i, ++src1, ++src2, ++tar)
-            *tar = f_add(*tar, f_multiply(*src1, *src2));
+            *tar = f_add(*tar, f_multiply(compute_type_t<S1>(*src1), compute_type_t<S2>(*src2)));
 
         return sum;
     }
@@ -638,6 +1680,3814 @@ namespace pure_simd {
         return inner_product<VectorSize>(src1, n, src2, init, std::plus<>(), std::multiplies<>());
     }
 
+    // Algorithms: software prefetching.
+    //
+    // transform, accumulate, inner_product, gather and gather_strided take a
+    // prefetch_options as their last argument. The loops then prefetch the
+    // input `distance` ahead of the vector they are loading, which helps when
+    // the hardware prefetcher cannot follow the access pattern. A distance of
+    // zero disables prefetching. For the gathers every element is taken to
+    // cost one cache line, so a distance in bytes is divided by the line size.
+    // Inputs are always prefetched for reading; `write` also prefetches the
+    // output of transform and the gathers, the same distance ahead, for
+    // writing.
+    constexpr size_t cache_line_size = 64;
+
+    struct prefetch_options {
+        enum class unit { bytes, vectors };
+
+        size_t distance = 0;
+
+        unit distance_unit = unit::bytes;
+
+        // Also prefetch the output for writing.
+        bool write = false;
+
+        // From 0 (no temporal locality) to 3 (keep in all cache levels).
+        int locality = 3;
+    };
+
+    constexpr prefetch_options prefetch_bytes(size_t distance, bool write = false, int locality = 3)
+    {
+        return { distance, prefetch_options::unit::bytes, write, locality };
+    }
+
+    constexpr prefetch_options prefetch_vectors(size_t distance, bool write = false, int locality = 3)
+    {
+        return { distance, prefetch_options::unit::vectors, write, locality };
+    }
+
+    namespace detail {
+        struct no_prefetcher {
+            void operator()(const void*, size_t) const { }
+        };
+
+        // Prefetches every cache line of [p, p + bytes).
+        template <bool Write, int Locality>
+        struct prefetcher {
+            void operator()(const void* p, size_t bytes) const
+            {
+#if defined(__GNUC__)
+                for (size_t offset = 0; offset < bytes; offset += cache_line_size)
+                    __builtin_prefetch(static_cast<const char*>(p) + offset, Write, Locality);
+#endif
+            }
+        };
+
+        // Calls func with the prefetchers of the input and of the output for
+        // the hints of `options`. The hints must be constants, so each
+        // combination is its own instantiation.
+        template <typename F>
+        void with_prefetcher(prefetch_options options, F func)
+        {
+            if (options.distance == 0)
+                return func(no_prefetcher {}, no_prefetcher {});
+
+            switch (std::clamp(options.locality, 0, 3) + 4 * options.write) {
+            case 0: return func(prefetcher<false, 0> {}, no_prefetcher {});
+            case 1: return func(prefetcher<false, 1> {}, no_prefetcher {});
+            case 2: return func(prefetcher<false, 2> {}, no_prefetcher {});
+            case 3: return func(prefetcher<false, 3> {}, no_prefetcher {});
+            case 4: return func(prefetcher<false, 0> {}, prefetcher<true, 0> {});
+            case 5: return func(prefetcher<false, 1> {}, prefetcher<true, 1> {});
+            case 6: return func(prefetcher<false, 2> {}, prefetcher<true, 2> {});
+            default: return func(prefetcher<false, 3> {}, prefetcher<true, 3> {});
+            }
+        }
+
+        // The distance in elements of a contiguous input of S.
+        template <size_t VectorSize, typename S>
+        constexpr size_t prefetch_ahead(prefetch_options options)
+        {
+            if (options.distance_unit == prefetch_options::unit::vectors)
+                return options.distance * VectorSize;
+            return (options.distance + sizeof(S) - 1) / sizeof(S);
+        }
+
+        // The distance in elements of a gather, one cache line per element.
+        template <size_t VectorSize>
+        constexpr size_t gather_ahead(prefetch_options options)
+        {
+            if (options.distance_unit == prefetch_options::unit::vectors)
+                return options.distance * VectorSize;
+            return (options.distance + cache_line_size - 1) / cache_line_size;
+        }
+
+        // Calls fetch(i + ahead) and body(i) for the whole vectors at i while
+        // i + ahead stays inside the input, then body(i) alone. Returns the
+        // number of elements that were left for the scalar tail.
+        template <size_t VectorSize, typename Fetch, typename Body>
+        size_t prefetched_loop(size_t n, size_t ahead, Fetch fetch, Body body)
+        {
+            size_t i = 0;
+            for (; i + ahead + VectorSize <= n; i += VectorSize) {
+                fetch(i + ahead);
+                body(i);
+            }
+
+            for (; i + VectorSize <= n; i += VectorSize)
+                body(i);
+
+            return i;
+        }
+
+        // Measures the latency with a random pointer chase and the bandwidth
+        // with a sequential sum, both over 32 MiB, more than the caches hold.
+        inline size_t measure_prefetch_distance()
+        {
+            using clock = std::chrono::steady_clock;
+
+            constexpr size_t count = size_t(4) << 20;
+            constexpr size_t steps = size_t(1) << 20;
+
+            // Sattolo's algorithm yields a single cycle through all entries.
+            std::vector<size_t> next(count);
+            for (size_t i = 0; i < count; ++i)
+                next[i] = i;
+
+            std::uint64_t state = 0x9e3779b97f4a7c15;
+            for (size_t i = count - 1; i > 0; --i) {
+                state ^= state << 13;
+                state ^= state >> 7;
+                state ^= state << 17;
+                std::swap(next[i], next[state % i]);
+            }
+
+            auto start = clock::now();
+            size_t at = 0;
+            for (size_t i = 0; i < steps; ++i)
+                at = next[at];
+            auto chased = clock::now();
+
+            size_t sum = at;
+            for (size_t i = 0; i < count; ++i)
+                sum += next[i];
+            auto streamed = clock::now();
+
+            // Keeps both loops from being optimized away.
+            *static_cast<volatile size_t*>(next.data()) = sum;
+
+            double latency = std::chrono::duration<double>(chased - start).count() / steps;
+            double bandwidth = count * sizeof(size_t) / std::chrono::duration<double>(streamed - chased).count();
+
+            // The bytes in flight that hide the latency at full bandwidth.
+            auto distance = static_cast<size_t>(latency * bandwidth);
+            distance = (distance + cache_line_size - 1) / cache_line_size * cache_line_size;
+            return std::clamp<size_t>(distance, 4 * cache_line_size, 1024 * cache_line_size);
+        }
+
+    } // namespace detail
+
+    // Prefetches the latency-bandwidth product ahead. Both are measured on
+    // the first call, which takes around a tenth of a second.
+    inline prefetch_options prefetch_auto(bool write = false, int locality = 3)
+    {
+        static const size_t distance = detail::measure_prefetch_distance();
+        return prefetch_bytes(distance, write, locality);
+    }
+
+    template <size_t VectorSize, typename F, typename T, typename S>
+    void transform(const S* src, size_t n, T* dst, F func, prefetch_options options)
+    {
+        using SourceVec = vector<compute_type_t<S>, VectorSize>;
+
+        detail::with_prefetcher(options, [&](auto prefetch, auto prefetch_dst) {
+            auto i = detail::prefetched_loop<VectorSize>(
+                n, detail::prefetch_ahead<VectorSize, S>(options),
+                [&](size_t j) {
+                    prefetch(src + j, sizeof(SourceVec));
+                    prefetch_dst(dst + j, VectorSize * sizeof(T));
+                },
+                [&](size_t j) { store_to(unroll(load_from<SourceVec>(src + j), func), dst + j); });
+
+            std::transform(src + i, src + n, dst + i, [&](compute_type_t<S> x) { return func(x); });
+        });
+    }
+
+    template <size_t VectorSize, typename F, typename T, typename S0, typename S1>
+    void transform(const S0* src0, size_t n, const S1* src1, T* dst, F func, prefetch_options options)
+    {
+        using Source0Vec = vector<compute_type_t<S0>, VectorSize>;
+        using Source1Vec = vector<compute_type_t<S1>, VectorSize>;
+
+        detail::with_prefetcher(options, [&](auto prefetch, auto prefetch_dst) {
+            auto i = detail::prefetched_loop<VectorSize>(
+                n, detail::prefetch_ahead<VectorSize, S0>(options),
+                [&](size_t j) {
+                    prefetch(src0 + j, sizeof(Source0Vec));
+                    prefetch(src1 + j, sizeof(Source1Vec));
+                    prefetch_dst(dst + j, VectorSize * sizeof(T));
+                },
+                [&](size_t j) {
+                    store_to(unroll(load_from<Source0Vec>(src0 + j), load_from<Source1Vec>(src1 + j), func), dst + j);
+                });
+
+            std::transform(src0 + i, src0 + n, src1 + i, dst + i, [&](compute_type_t<S0> x, compute_type_t<S1> y) {
+                return func(x, y);
+            });
+        });
+    }
+
+    template <size_t VectorSize, typename T, typename S, typename F>
+    auto accumulate(const S* src, size_t n, T init, F func, prefetch_options options)
+    {
+        using Source = vector<compute_type_t<S>, VectorSize>;
+        using Target = vector<T, VectorSize>;
+
+        auto sum = scalar<Target>(init);
+        detail::with_prefetcher(options, [&](auto prefetch, auto) {
+            auto i = detail::prefetched_loop<VectorSize>(
+                n, detail::prefetch_ahead<VectorSize, S>(options),
+                [&](size_t j) { prefetch(src + j, sizeof(Source)); },
+                [&](size_t j) { sum = unroll(sum, load_from<Source>(src + j), func); });
+
+            std::transform(src + i, src + n, sum.begin(), sum.begin(), [&](compute_type_t<S> val, auto curr) {
+                return func(curr, val);
+            });
+        });
+
+        return sum;
+    }
+
+    template <size_t VectorSize, typename T, typename S>
+    auto accumulate(const S* src, size_t n, T init, prefetch_options options)
+    {
+        return accumulate<VectorSize>(src, n, init, std::plus<>(), options);
+    }
+
+    template <size_t VectorSize, typename T, typename S1, typename S2, typename FAdd, typename FMultiply>
+    auto inner_product(const S1* src1, size_t n, const S2* src2, T init, FAdd f_add, FMultiply f_multiply, prefetch_options options)
+    {
+        using Source1 = vector<compute_type_t<S1>, VectorSize>;
+        using Source2 = vector<compute_type_t<S2>, VectorSize>;
+        using Target = vector<T, VectorSize>;
+
+        auto sum = scalar<Target>(init);
+        detail::with_prefetcher(options, [&](auto prefetch, auto) {
+            auto i = detail::prefetched_loop<VectorSize>(
+                n, detail::prefetch_ahead<VectorSize, S1>(options),
+                [&](size_t j) {
+                    prefetch(src1 + j, sizeof(Source1));
+                    prefetch(src2 + j, sizeof(Source2));
+                },
+                [&](size_t j) {
+                    sum = unroll(sum, unroll(load_from<Source1>(src1 + j), load_from<Source2>(src2 + j), f_multiply), f_add);
+                });
+
+            for (auto tar = sum.begin(); i < n; ++i, ++tar)
+                *tar = f_add(*tar, f_multiply(compute_type_t<S1>(src1[i]), compute_type_t<S2>(src2[i])));
+        });
+
+        return sum;
+    }
+
+    template <size_t VectorSize, typename T, typename S1, typename S2>
+    auto inner_product(const S1* src1, size_t n, const S2* src2, T init, prefetch_options options)
+    {
+        return inner_product<VectorSize>(src1, n, src2, init, std::plus<>(), std::multiplies<>(), options);
+    }
+
+    // dst[i] = src[indices[i]]
+    template <size_t VectorSize, typename T, typename I>
+    void gather(const T* src, const I* indices, size_t n, T* dst, prefetch_options options = {})
+    {
+        using IndexVec = vector<I, VectorSize>;
+
+        auto at = [src](I index) { return src[index]; };
+
+        detail::with_prefetcher(options, [&](auto prefetch, auto prefetch_dst) {
+            auto i = detail::prefetched_loop<VectorSize>(
+                n, detail::gather_ahead<VectorSize>(options),
+                [&](size_t j) {
+                    for (size_t k = 0; k < VectorSize; ++k)
+                        prefetch(src + indices[j + k], sizeof(T));
+                    prefetch_dst(dst + j, VectorSize * sizeof(T));
+                },
+                [&](size_t j) { store_to(unroll(load_from<IndexVec>(indices + j), at), dst + j); });
+
+            std::transform(indices + i, indices + n, dst + i, at);
+        });
+    }
+
+    // dst[i] = src[i * stride]
+    template <size_t VectorSize, typename T>
+    void gather_strided(const T* src, size_t stride, size_t n, T* dst, prefetch_options options = {})
+    {
+        using IndexVec = vector<size_t, VectorSize>;
+
+        auto at = [src](size_t index) { return src[index]; };
+
+        detail::with_prefetcher(options, [&](auto prefetch, auto prefetch_dst) {
+            auto i = detail::prefetched_loop<VectorSize>(
+                n, detail::gather_ahead<VectorSize>(options),
+                [&](size_t j) {
+                    for (size_t k = 0; k < VectorSize; ++k)
+                        prefetch(src + (j + k) * stride, sizeof(T));
+                    prefetch_dst(dst + j, VectorSize * sizeof(T));
+                },
+                [&](size_t j) { store_to(unroll(iota<IndexVec>(j * stride, stride), at), dst + j); });
+
+            for (; i < n; ++i)
+                dst[i] = src[i * stride];
+        });
+    }
+
+    // Algorithms: parallel slices.
+    //
+    // The overloads that take a thread count cut their input into one slice
+    // per thread and process the last slice on the calling thread.
+    namespace detail {
+        // Joins the thread on every exit, so that an exception does not
+        // destroy a joinable std::thread.
+        struct joining_thread {
+            joining_thread() = default;
+
+            joining_thread(const joining_thread&) = delete;
+
+            joining_thread& operator=(const joining_thread&) = delete;
+
+            ~joining_thread()
+            {
+                if (thread.joinable())
+                    thread.join();
+            }
+
+            std::thread thread;
+        };
+
+        // The number of slices of at least Granule elements that n elements
+        // are cut into for `threads` threads.
+        template <size_t Granule>
+        size_t thread_count(size_t n, size_t threads)
+        {
+            return std::max<size_t>(1, std::min(threads, n / Granule));
+        }
+
+        // Calls `func(t, begin, size)` for the thread_count slices of [0, n).
+        // Every slice but the last holds a multiple of Granule elements; the
+        // last takes the rest and runs on the caller. All threads are joined
+        // before this returns or throws.
+        template <size_t Granule, typename F>
+        void parallel_slices(size_t n, size_t threads, F func)
+        {
+            threads = thread_count<Granule>(n, threads);
+
+            const size_t slice_size = n / threads / Granule * Granule;
+            const size_t last = (threads - 1) * slice_size;
+
+            std::vector<joining_thread> workers(threads - 1);
+            for (size_t t = 0; t + 1 < threads; ++t)
+                workers[t].thread = std::thread(func, t, t * slice_size, slice_size);
+
+            func(threads - 1, last, n - last);
+        }
+
+    } // namespace detail
+
+    // Algorithms: deterministic reductions.
+    //
+    // Passing one of the modes below to accumulate or inner_product returns
+    // the reduced scalar instead of a vector of partial sums. The result is
+    // bitwise identical for every VectorSize and thread count, because the
+    // summation order does not depend on either: the input is cut into blocks
+    // of reduction_block elements, element i of a block always goes to lane
+    // i % reduction_lanes, a partial last chunk is zero-padded, lanes are
+    // folded in a fixed tree, and block results are combined pairwise.
+    //
+    // `pairwise` adds plainly, `kahan` and `neumaier` carry a compensation
+    // term per lane. The results are only reproducible when the compiler
+    // keeps IEEE semantics, i.e. without -ffast-math.
+    namespace detail {
+        struct pairwise_sum {
+        };
+
+        struct kahan_sum {
+        };
+
+        struct neumaier_sum {
+        };
+
+    } // namespace detail
+
+    template <typename Algorithm>
+    struct reduction_mode {
+        // Splits the blocks among `count` threads, which leaves the result unchanged.
+        constexpr reduction_mode with_threads(size_t count) const { return { count }; }
+
+        size_t threads = 1;
+    };
+
+    inline constexpr reduction_mode<detail::pairwise_sum> pairwise {};
+
+    inline constexpr reduction_mode<detail::kahan_sum> kahan {};
+
+    inline constexpr reduction_mode<detail::neumaier_sum> neumaier {};
+
+    constexpr size_t reduction_lanes = 64;
+
+    constexpr size_t reduction_block = 4096;
+
+    namespace detail {
+        // The reduced value is `sum + error`.
+        template <typename T>
+        struct compensated {
+            T sum;
+            T error;
+        };
+
+        template <typename V>
+        constexpr void reduce_step(pairwise_sum, V& sums, V&, V xs)
+        {
+            sums = sums + xs;
+        }
+
+        // Kahan keeps the negated error, which is undone when folding.
+        template <typename V>
+        constexpr void reduce_step(kahan_sum, V& sums, V& errors, V xs)
+        {
+            auto ys = xs - errors;
+            auto ts = sums + ys;
+            errors = (ts - sums) - ys;
+            sums = ts;
+        }
+
+        // Neumaier's correction computed without branches (TwoSum), which
+        // yields the same exact rounding error regardless of magnitudes.
+        template <typename V>
+        constexpr void reduce_step(neumaier_sum, V& sums, V& errors, V xs)
+        {
+            auto ts = sums + xs;
+            auto bs = ts - sums;
+            errors = errors + ((sums - (ts - bs)) + (xs - bs));
+            sums = ts;
+        }
+
+        template <typename T>
+        constexpr compensated<T> reduce_combine(pairwise_sum, compensated<T> a, compensated<T> b)
+        {
+            return { a.sum + b.sum, T {} };
+        }
+
+        template <typename Algorithm, typename T>
+        constexpr compensated<T> reduce_combine(Algorithm, compensated<T> a, compensated<T> b)
+        {
+            auto t = a.sum + b.sum;
+            auto bp = t - a.sum;
+            return { t, (a.error + b.error) + ((a.sum - (t - bp)) + (b.sum - bp)) };
+        }
+
+        // Whether compilers may contract a * b + c into a fused multiply-add.
+        template <typename T>
+        constexpr bool has_fast_fma()
+        {
+#if defined(FP_FAST_FMAF)
+            if constexpr (std::is_same_v<T, float>)
+                return true;
+#endif
+#if defined(FP_FAST_FMA)
+            if constexpr (std::is_same_v<T, double>)
+                return true;
+#endif
+            return false;
+        }
+
+        // Products are fused explicitly where the compiler could contract
+        // them on its own, so contraction cannot depend on VectorSize. The
+        // compensated modes also pick up the rounding error of the product.
+        template <typename V>
+        constexpr void reduce_product_step(pairwise_sum, V& sums, V&, V xs, V ys)
+        {
+            sums = unroll(xs, ys, sums, [](auto x, auto y, auto sum) {
+                if constexpr (has_fast_fma<decltype(sum)>())
+                    return std::fma(x, y, sum);
+                else
+                    return x * y + sum;
+            });
+        }
+
+        template <typename Algorithm, typename V>
+        constexpr void reduce_product_step(Algorithm mode, V& sums, V& errors, V xs, V ys)
+        {
+            auto ps = xs * ys;
+
+            if constexpr (has_fast_fma<typename V::value_type>()) {
+                auto es = unroll(xs, ys, ps, [](auto x, auto y, auto p) { return std::fma(x, y, -p); });
+                errors = std::is_same_v<Algorithm, kahan_sum> ? errors - es : errors + es;
+            }
+
+            reduce_step(mode, sums, errors, ps);
+        }
+
+        // Reduces `chunks` chunks of reduction_lanes values into one
+        // compensated value. `step(sums, errors, i)` adds the i-th VectorSize
+        // values to the accumulators.
+        template <size_t VectorSize, typename T, typename Algorithm, typename F>
+        compensated<T> reduce_chunks(Algorithm mode, size_t chunks, F step)
+        {
+            static_assert(reduction_lanes % VectorSize == 0, "VectorSize must divide reduction_lanes");
+
+            using Vec = vector<T, VectorSize>;
+
+            constexpr size_t vectors = reduction_lanes / VectorSize;
+
+            std::array<Vec, vectors> sums {};
+            std::array<Vec, vectors> errors {};
+
+            for (size_t i = 0; i < chunks; ++i)
+                for (size_t k = 0; k < vectors; ++k)
+                    step(sums[k], errors[k], i * vectors + k);
+
+            std::array<compensated<T>, reduction_lanes> lanes;
+            for (size_t k = 0; k < vectors; ++k)
+                for (size_t l = 0; l < VectorSize; ++l)
+                    lanes[k * VectorSize + l] = { sums[k][l], std::is_same_v<Algorithm, kahan_sum> ? -errors[k][l] : errors[k][l] };
+
+            for (size_t width = reduction_lanes / 2; width > 0; width /= 2)
+                for (size_t l = 0; l < width; ++l)
+                    lanes[l] = reduce_combine(mode, lanes[l], lanes[l + width]);
+
+            return lanes[0];
+        }
+
+        template <typename T, typename Algorithm>
+        compensated<T> reduce_tree(Algorithm mode, const compensated<T>* results, size_t count)
+        {
+            if (count == 1)
+                return results[0];
+
+            auto half = count / 2;
+            return reduce_combine(mode, reduce_tree(mode, results, half), reduce_tree(mode, results + half, count - half));
+        }
+
+        // Reduces the blocks of [0, n), `block(begin, size)` reducing one of them.
+        template <typename T, typename Algorithm, typename F>
+        T reduce_blocks(Algorithm mode, size_t n, T init, size_t threads, F block)
+        {
+            auto blocks = (n + reduction_block - 1) / reduction_block;
+            if (blocks == 0)
+                return init;
+
+            std::vector<compensated<T>> results(blocks);
+            auto reduce_range = [&](size_t lo, size_t hi) {
+                for (size_t b = lo; b < hi; ++b)
+                    results[b] = block(b * reduction_block, std::min(reduction_block, n - b * reduction_block));
+            };
+
+            parallel_slices<1>(blocks, threads, [&](size_t, size_t begin, size_t size) { reduce_range(begin, begin + size); });
+
+            auto total = reduce_combine(mode, compensated<T> { init, T {} }, reduce_tree(mode, results.data(), blocks));
+            return total.sum + total.error;
+        }
+
+        // Copies the last, partial chunk of a block into a zero-padded buffer.
+        template <typename S>
+        std::array<S, reduction_lanes> padded_chunk(const S* src, size_t count)
+        {
+            std::array<S, reduction_lanes> chunk {};
+            std::copy(src, src + count, chunk.begin());
+            return chunk;
+        }
+
+    } // namespace detail
+
+    template <size_t VectorSize, typename T, typename S, typename Algorithm>
+    T accumulate(const S* src, size_t n, T init, reduction_mode<Algorithm> mode)
+    {
+        static_assert(std::is_floating_point_v<T>, "deterministic reductions need a floating-point accumulator");
+
+        using SourceVec = vector<S, VectorSize>;
+
+        return detail::reduce_blocks(Algorithm {}, n, init, mode.threads, [&](size_t begin, size_t size) {
+            auto chunks = size / reduction_lanes;
+            auto rem = size % reduction_lanes;
+            const S* block = src + begin;
+
+            auto result = detail::reduce_chunks<VectorSize, T>(Algorithm {}, chunks, [&](auto& sums, auto& errors, size_t i) {
+                detail::reduce_step(Algorithm {}, sums, errors, cast_to<T>(load_from<SourceVec>(block + i * VectorSize)));
+            });
+
+            if (rem > 0) {
+                auto tail = detail::padded_chunk(block + chunks * reduction_lanes, rem);
+                result = detail::reduce_combine(Algorithm {}, result, detail::reduce_chunks<VectorSize, T>(Algorithm {}, 1, [&](auto& sums, auto& errors, size_t i) {
+                    detail::reduce_step(Algorithm {}, sums, errors, cast_to<T>(load_from<SourceVec>(tail.data() + i * VectorSize)));
+                }));
+            }
+
+            return result;
+        });
+    }
+
+    template <size_t VectorSize, typename T, typename S1, typename S2, typename Algorithm>
+    T inner_product(const S1* src1, size_t n, const S2* src2, T init, reduction_mode<Algorithm> mode)
+    {
+        static_assert(std::is_floating_point_v<T>, "deterministic reductions need a floating-point accumulator");
+
+        using Source1Vec = vector<S1, VectorSize>;
+        using Source2Vec = vector<S2, VectorSize>;
+
+        auto step = [](auto& sums, auto& errors, const S1* xs, const S2* ys) {
+            detail::reduce_product_step(Algorithm {}, sums, errors, cast_to<T>(load_from<Source1Vec>(xs)), cast_to<T>(load_from<Source2Vec>(ys)));
+        };
+
+        return detail::reduce_blocks(Algorithm {}, n, init, mode.threads, [&](size_t begin, size_t size) {
+            auto chunks = size / reduction_lanes;
+            auto rem = size % reduction_lanes;
+            const S1* block1 = src1 + begin;
+            const S2* block2 = src2 + begin;
+
+            auto result = detail::reduce_chunks<VectorSize, T>(Algorithm {}, chunks, [&](auto& sums, auto& errors, size_t i) {
+                step(sums, errors, block1 + i * VectorSize, block2 + i * VectorSize);
+            });
+
+            if (rem > 0) {
+                auto tail1 = detail::padded_chunk(block1 + chunks * reduction_lanes, rem);
+                auto tail2 = detail::padded_chunk(block2 + chunks * reduction_lanes, rem);
+                result = detail::reduce_combine(Algorithm {}, result, detail::reduce_chunks<VectorSize, T>(Algorithm {}, 1, [&](auto& sums, auto& errors, size_t i) {
+                    step(sums, errors, tail1.data() + i * VectorSize, tail2.data() + i * VectorSize);
+                }));
+            }
+
+            return result;
+        });
+    }
+
+    // Algorithms: find, count, find_first_of, and split.
+    //
+    // `pred` is applied to whole vectors like the functions of transform, so
+    // it must be a generic callable that works lane-wise on scalars too.
+    template <size_t VectorSize, typename T, typename F>
+    size_t find_if(const T* src, size_t n, F pred)
+    {
+        using SourceVec = vector<T, VectorSize>;
+
+        auto rem = n % VectorSize;
+        auto loops = n / VectorSize;
+
+        for (size_t i = 0; i < loops; ++i, src += VectorSize) {
+            auto bits = detail::bitmask(unroll(load_from<SourceVec>(src), pred));
+            if (bits != 0)
+                return i * VectorSize + detail::countr_zero(bits);
+        }
+
+        return loops * VectorSize + (std::find_if(src, src + rem, pred) - src);
+    }
+
+    template <size_t VectorSize, typename T, typename F>
+    size_t find_if_not(const T* src, size_t n, F pred)
+    {
+        return find_if<VectorSize>(src, n, [pred](auto x) { return !pred(x); });
+    }
+
+    // Returns the index of the first element equal to `value`, or `n`.
+    template <size_t VectorSize, typename T>
+    size_t find(const T* src, size_t n, T value)
+    {
+        return find_if<VectorSize>(src, n, [value](auto x) { return x == value; });
+    }
+
+    // Returns the index of the first element equal to any of `values`, or `n`.
+    // Every block is compared against each of the values, so the set should be small.
+    template <size_t VectorSize, typename T>
+    size_t find_first_of(const T* src, size_t n, const T* values, size_t count)
+    {
+        using SourceVec = vector<T, VectorSize>;
+        using MaskVec = vector<std::uint8_t, VectorSize>;
+
+        auto rem = n % VectorSize;
+        auto loops = n / VectorSize;
+
+        for (size_t i = 0; i < loops; ++i, src += VectorSize) {
+            auto xs = load_from<SourceVec>(src);
+
+            MaskVec matches {};
+            for (size_t k = 0; k < count; ++k)
+                matches = unroll(matches, xs == scalar<SourceVec>(values[k]), [](std::uint8_t m, bool match) {
+                    return static_cast<std::uint8_t>(m | match);
+                });
+
+            auto bits = detail::bitmask(matches);
+            if (bits != 0)
+                return i * VectorSize + detail::countr_zero(bits);
+        }
+
+        return loops * VectorSize + (std::find_first_of(src, src + rem, values, values + count) - src);
+    }
+
+    // Returns the number of elements equal to `value`. Matches are counted in
+    // byte lanes, which are flushed before they can overflow.
+    template <size_t VectorSize, typename T>
+    size_t count(const T* src, size_t n, T value)
+    {
+        using SourceVec = vector<T, VectorSize>;
+        using CountVec = vector<std::uint8_t, VectorSize>;
+
+        constexpr size_t max_loops = std::numeric_limits<std::uint8_t>::max();
+
+        auto rem = n % VectorSize;
+        auto loops = n / VectorSize;
+
+        size_t total = 0;
+        const auto values = scalar<SourceVec>(value);
+
+        while (loops > 0) {
+            auto chunk = std::min(loops, max_loops);
+            CountVec counts {};
+
+            for (size_t i = 0; i < chunk; ++i, src += VectorSize)
+                counts = unroll(counts, load_from<SourceVec>(src), values, [](std::uint8_t c, auto x, auto v) {
+                    return static_cast<std::uint8_t>(c + (x == v));
+                });
+
+            total += sum(counts, size_t {});
+            loops -= chunk;
+        }
+
+        return total + std::count(src, src + rem, value);
+    }
+
+    // Calls `func(pos)` for the index of every element equal to `value`, in order.
+    template <size_t VectorSize, typename T, typename F>
+    void find_all(const T* src, size_t n, T value, F func)
+    {
+        using SourceVec = vector<T, VectorSize>;
+
+        auto rem = n % VectorSize;
+        auto loops = n / VectorSize;
+
+        const auto values = scalar<SourceVec>(value);
+
+        size_t pos = 0;
+        for (size_t i = 0; i < loops; ++i, pos += VectorSize) {
+            detail::for_each_bit(detail::bitmask(load_from<SourceVec>(src + pos) == values), [&](size_t bit) {
+                func(pos + bit);
+            });
+        }
+
+        for (; pos < loops * VectorSize + rem; ++pos) {
+            if (src[pos] == value)
+                func(pos);
+        }
+    }
+
+    // Splits [0, n) at every `delimiter` and calls `func(begin, end)` for each
+    // piece, delimiters excluded. Like splitting a string, n delimiters give
+    // n + 1 pieces, some of which may be empty.
+    template <size_t VectorSize, typename T, typename F>
+    void split(const T* src, size_t n, T delimiter, F func)
+    {
+        size_t begin = 0;
+
+        find_all<VectorSize>(src, n, delimiter, [&](size_t pos) {
+            func(begin, pos);
+            begin = pos + 1;
+        });
+
+        func(begin, n);
+    }
+
+    // Algorithms: while_any and masked_loop.
+    //
+    // Lanes of iterative kernels (escape-time fractals, Newton solvers, ray
+    // marching) finish after different numbers of iterations. The loops below
+    // keep a mask of the active lanes and stop once no lane is active. Masks
+    // are integer vectors with all bits set in active lanes, as produced by
+    // `-static_cast<int>(cond)`; gcc keeps those in vector registers, while
+    // bool masks mixed with wider lanes tend to be scalarized.
+
+    // Calls `active = body(active)` while any lane of `active` is set and
+    // returns the number of iterations. `body` advances all lanes and returns
+    // the lanes that are still active; it must not change the results of the
+    // inactive ones, e.g. by subtracting the mask from per-lane counters
+    // instead of selecting. A finished lane never becomes active again.
+    template <typename M, typename F, typename = must_be_vector<M>>
+    size_t while_any(M active, F body)
+    {
+        using Mask = typename M::value_type;
+
+        size_t iterations = 0;
+
+        for (; any(active); ++iterations)
+            active = unroll(active, body(active), [](Mask was, Mask is) { return static_cast<Mask>(was & is); });
+
+        return iterations;
+    }
+
+    // Persistent-lane scheduling of `count` work items over VectorSize lanes.
+    // `start(lane, item)` loads an item into a lane, `step(active)` advances
+    // all lanes by one iteration and returns the mask of lanes that are still
+    // busy, and `finish(lane, item)` stores the result of a finished lane. A
+    // finished lane is refilled with the next item right away, so lanes only
+    // idle once the items run out. Every item gets at least one step.
+    template <size_t VectorSize, typename Mask = std::int32_t, typename Start, typename Step, typename Finish>
+    void masked_loop(size_t count, Start start, Step step, Finish finish)
+    {
+        using MaskVec = vector<Mask, VectorSize>;
+
+        std::array<size_t, VectorSize> items {};
+        MaskVec active {};
+
+        size_t next = 0;
+        for (size_t lane = 0; lane < VectorSize && next < count; ++lane, ++next) {
+            start(lane, next);
+            items[lane] = next;
+            active[lane] = static_cast<Mask>(-1);
+        }
+
+        while (any(active)) {
+            MaskVec busy = step(active);
+            auto finished = detail::bitmask(unroll(active, busy, [](Mask was, Mask is) { return static_cast<Mask>(was & ~is); }));
+
+            detail::for_each_bit(finished, [&](size_t lane) {
+                finish(lane, items[lane]);
+
+                if (next < count) {
+                    start(lane, next);
+                    items[lane] = next++;
+                } else {
+                    active[lane] = 0;
+                }
+            });
+        }
+    }
+
+    // Algorithms: histogram.
+    namespace detail {
+        // Adds `bins` counters of every lane-private sub-histogram to `out`.
+        template <size_t VectorSize, typename C>
+        void merge_histograms(const C* counts, size_t lanes, size_t bins, size_t* out)
+        {
+            for (size_t lane = 0; lane < lanes; ++lane, counts += bins + 1)
+                transform<VectorSize>(counts, bins, out, out, [](auto count, auto total) {
+                    return total + count;
+                });
+        }
+
+    } // namespace detail
+
+    // Counts the elements of `src` per key into `out[0, bins)`, overwriting it.
+    // Keys outside [0, bins) are ignored.
+    //
+    // Every lane increments its own sub-histogram, so the increments of a
+    // vector never collide and repeated keys do not serialize on one counter.
+    // The sub-histograms take VectorSize * (bins + 1) 32-bit counters and are
+    // merged at the end, so keep VectorSize small when `bins` is large.
+    template <size_t VectorSize, typename T>
+    void histogram(const T* src, size_t n, size_t bins, size_t* out)
+    {
+        static_assert(std::is_integral_v<T>, "histogram keys must be integers");
+
+        using SourceVec = vector<T, VectorSize>;
+        using IndexVec = vector<size_t, VectorSize>;
+
+        constexpr size_t max_loops = std::numeric_limits<std::uint32_t>::max() - 1;
+
+        // Every sub-histogram has a spare counter for the out-of-range keys.
+        const size_t stride = bins + 1;
+        const auto offsets = iota<IndexVec>(size_t {}, stride);
+
+        std::vector<std::uint32_t> counts(VectorSize * stride);
+        std::fill(out, out + bins, size_t {});
+
+        auto rem = n % VectorSize;
+        auto loops = n / VectorSize;
+
+        while (loops > 0) {
+            auto chunk = std::min(loops, max_loops);
+
+            for (size_t i = 0; i < chunk; ++i, src += VectorSize) {
+                auto indices = unroll(load_from<SourceVec>(src), offsets, [bins](auto key, size_t offset) {
+                    return offset + std::min(static_cast<size_t>(key), bins);
+                });
+
+                for (size_t lane = 0; lane < VectorSize; ++lane)
+                    ++counts[indices[lane]];
+            }
+
+            detail::merge_histograms<VectorSize>(counts.data(), VectorSize, bins, out);
+            std::fill(counts.begin(), counts.end(), std::uint32_t {});
+            loops -= chunk;
+        }
+
+        for (size_t i = 0; i < rem; ++i) {
+            auto key = static_cast<size_t>(src[i]);
+            if (key < bins)
+                ++out[key];
+        }
+    }
+
+    // Thread-parallel histogram: `src` is split into `threads` slices that are
+    // counted concurrently into private histograms and summed into `out`.
+    template <size_t VectorSize, typename T>
+    void histogram(const T* src, size_t n, size_t bins, size_t* out, size_t threads)
+    {
+        threads = detail::thread_count<VectorSize>(n, threads);
+        if (threads == 1)
+            return histogram<VectorSize>(src, n, bins, out);
+
+        std::vector<size_t> partials(threads * (bins + 1));
+        detail::parallel_slices<VectorSize>(n, threads, [&](size_t t, size_t begin, size_t size) {
+            histogram<VectorSize>(src + begin, size, bins, partials.data() + t * (bins + 1));
+        });
+
+        std::fill(out, out + bins, size_t {});
+        detail::merge_histograms<VectorSize>(partials.data(), threads, bins, out);
+    }
+
+    // Algorithms: fft and ifft.
+    //
+    // In-place transforms of power-of-two sizes on split complex data. The
+    // plan holds the twiddle factors of all stages. The input is permuted
+    // into bit-reversed order tile by tile, then pairs of radix-2 stages are
+    // fused into radix-4 passes to halve the passes over the data. The
+    // butterflies run on complex_vectors as wide as the stage allows, up to
+    // VectorSize.
+    template <typename T>
+    struct fft_plan {
+        size_t size;
+
+        // Twiddles of the stage with half-size m start at offset m - 1.
+        std::vector<T> twiddle_re;
+
+        std::vector<T> twiddle_im;
+
+        size_t log2_size;
+    };
+
+    namespace detail {
+        inline size_t reverse_bits(size_t x, size_t bits)
+        {
+            size_t reversed = 0;
+            for (size_t b = 0; b < bits; ++b)
+                reversed |= ((x >> b) & 1) << (bits - 1 - b);
+            return reversed;
+        }
+
+        // Copies src[i] to dst[reverse_bits(i, bits)] tile by tile. Index i
+        // is split into (high, middle, low) with TileBits-bit high and low
+        // parts; every middle value moves a tile through a small buffer, so
+        // that reads and writes stay in a few cache lines instead of
+        // conflicting on the power-of-two strides. Needs bits >= 2 * TileBits.
+        template <size_t TileBits, typename T>
+        void bit_reverse_copy(const T* src, T* dst, size_t bits)
+        {
+            constexpr size_t tile = size_t { 1 } << TileBits;
+
+            const size_t middle_bits = bits - 2 * TileBits;
+            const size_t high_shift = bits - TileBits;
+
+            std::array<size_t, tile> reversed;
+            for (size_t i = 0; i < tile; ++i)
+                reversed[i] = reverse_bits(i, TileBits);
+
+            std::array<T, tile * tile> buffer;
+            for (size_t middle = 0; middle < (size_t { 1 } << middle_bits); ++middle) {
+                const size_t middle_reversed = reverse_bits(middle, middle_bits);
+
+                for (size_t high = 0; high < tile; ++high) {
+                    const T* from = src + (high << high_shift) + (middle << TileBits);
+                    for (size_t low = 0; low < tile; ++low)
+                        buffer[reversed[high] * tile + low] = from[low];
+                }
+
+                for (size_t low = 0; low < tile; ++low) {
+                    T* to = dst + (reversed[low] << high_shift) + (middle_reversed << TileBits);
+                    for (size_t high = 0; high < tile; ++high)
+                        to[high] = buffer[high * tile + low];
+                }
+            }
+        }
+
+        template <typename T>
+        void bit_reverse_permute(T* xs, size_t bits, std::vector<T>& scratch)
+        {
+            constexpr size_t tile_bits = 4;
+
+            const size_t n = size_t { 1 } << bits;
+            if (bits < 2 * tile_bits) {
+                for (size_t i = 0; i < n; ++i) {
+                    size_t j = reverse_bits(i, bits);
+                    if (i < j)
+                        std::swap(xs[i], xs[j]);
+                }
+                return;
+            }
+
+            scratch.resize(n);
+            bit_reverse_copy<tile_bits>(xs, scratch.data(), bits);
+            std::copy(scratch.begin(), scratch.end(), xs);
+        }
+
+    } // namespace detail
+
+    template <typename T>
+    fft_plan<T> make_fft_plan(size_t n)
+    {
+        if (n == 0 || !detail::is_power_of_two(n) || n > (size_t { 1 } << 31))
+            throw std::invalid_argument("fft size must be a power of two");
+
+        fft_plan<T> plan { n, std::vector<T>(n), std::vector<T>(n), 0 };
+
+        const double pi = std::acos(-1.0);
+        for (size_t m = 1; m < n; m *= 2) {
+            for (size_t j = 0; j < m; ++j) {
+                plan.twiddle_re[m - 1 + j] = static_cast<T>(std::cos(pi * j / m));
+                plan.twiddle_im[m - 1 + j] = static_cast<T>(-std::sin(pi * j / m));
+            }
+        }
+
+        while ((size_t { 1 } << plan.log2_size) < n)
+            ++plan.log2_size;
+
+        return plan;
+    }
+
+    namespace detail {
+        // Calls `func(size_constant<W>)` with the widest W <= MaxWidth that
+        // divides the power of two `m`.
+        template <size_t MaxWidth, typename F>
+        void with_width(size_t m, F func)
+        {
+            if constexpr (MaxWidth == 1)
+                func(size_constant<1> {});
+            else if (m >= MaxWidth)
+                func(size_constant<MaxWidth> {});
+            else
+                with_width<MaxWidth / 2>(m, func);
+        }
+
+        template <size_t Width, typename T>
+        void fft_radix2_stage(T* re, T* im, size_t n, size_t m, const T* w_re, const T* w_im)
+        {
+            using ComplexVec = complex_vector<T, Width>;
+
+            for (size_t k = 0; k < n; k += 2 * m) {
+                for (size_t j = 0; j < m; j += Width) {
+                    auto a = load_from<ComplexVec>(re + k + j, im + k + j);
+                    auto b = load_from<ComplexVec>(re + k + j + m, im + k + j + m) * load_from<ComplexVec>(w_re + j, w_im + j);
+
+                    store_to(a + b, re + k + j, im + k + j);
+                    store_to(a - b, re + k + j + m, im + k + j + m);
+                }
+            }
+        }
+
+        // The radix-2 stages of half-sizes m and 2m in one pass.
+        template <size_t Width, typename T>
+        void fft_radix4_stage(T* re, T* im, size_t n, size_t m, const fft_plan<T>& plan)
+        {
+            using ComplexVec = complex_vector<T, Width>;
+
+            const T* w1_re = plan.twiddle_re.data() + m - 1;
+            const T* w1_im = plan.twiddle_im.data() + m - 1;
+            const T* w2_re = plan.twiddle_re.data() + 2 * m - 1;
+            const T* w2_im = plan.twiddle_im.data() + 2 * m - 1;
+
+            for (size_t k = 0; k < n; k += 4 * m) {
+                for (size_t j = 0; j < m; j += Width) {
+                    T* r = re + k + j;
+                    T* i = im + k + j;
+
+                    auto w1 = load_from<ComplexVec>(w1_re + j, w1_im + j);
+                    auto a = load_from<ComplexVec>(r, i);
+                    auto b = load_from<ComplexVec>(r + m, i + m) * w1;
+                    auto c = load_from<ComplexVec>(r + 2 * m, i + 2 * m);
+                    auto d = load_from<ComplexVec>(r + 3 * m, i + 3 * m) * w1;
+
+                    auto ab0 = a + b;
+                    auto ab1 = a - b;
+                    auto cd0 = (c + d) * load_from<ComplexVec>(w2_re + j, w2_im + j);
+                    auto cd1 = (c - d) * load_from<ComplexVec>(w2_re + j + m, w2_im + j + m);
+
+                    store_to(ab0 + cd0, r, i);
+                    store_to(ab1 + cd1, r + m, i + m);
+                    store_to(ab0 - cd0, r + 2 * m, i + 2 * m);
+                    store_to(ab1 - cd1, r + 3 * m, i + 3 * m);
+                }
+            }
+        }
+
+        template <size_t VectorSize, typename T>
+        void fft_impl(const fft_plan<T>& plan, T* re, T* im)
+        {
+            const size_t n = plan.size;
+
+            std::vector<T> scratch;
+            bit_reverse_permute(re, plan.log2_size, scratch);
+            bit_reverse_permute(im, plan.log2_size, scratch);
+
+            size_t m = 1;
+            for (; 4 * m <= n; m *= 4) {
+                with_width<VectorSize>(m, [&](auto width) {
+                    fft_radix4_stage<decltype(width)::value>(re, im, n, m, plan);
+                });
+            }
+
+            if (2 * m <= n) {
+                with_width<VectorSize>(m, [&](auto width) {
+                    fft_radix2_stage<decltype(width)::value>(re, im, n, m, plan.twiddle_re.data() + m - 1, plan.twiddle_im.data() + m - 1);
+                });
+            }
+        }
+
+    } // namespace detail
+
+    // Computes X[k] = sum_j x[j] * exp(-2 pi i j k / n) in place.
+    template <size_t VectorSize, typename T>
+    void fft(const fft_plan<T>& plan, T* re, T* im)
+    {
+        static_assert(detail::is_power_of_two(VectorSize), "VectorSize must be a power of two");
+
+        detail::fft_impl<VectorSize>(plan, re, im);
+    }
+
+    // The inverse of fft, including the scaling by 1 / n.
+    template <size_t VectorSize, typename T>
+    void ifft(const fft_plan<T>& plan, T* re, T* im)
+    {
+        static_assert(detail::is_power_of_two(VectorSize), "VectorSize must be a power of two");
+
+        const size_t n = plan.size;
+        const T scale = T { 1 } / static_cast<T>(n);
+
+        transform<VectorSize>(im, n, im, [](auto x) { return -x; });
+        detail::fft_impl<VectorSize>(plan, re, im);
+        transform<VectorSize>(re, n, re, [scale](auto x) { return x * scale; });
+        transform<VectorSize>(im, n, im, [scale](auto x) { return -x * scale; });
+    }
+
+    // Algorithms: fir, convolve, and stencil.
+    //
+    // The shifted windows are unaligned loads at consecutive offsets, which
+    // stay in L1. The filters add one tap at a time to a block of outputs
+    // small enough for L1, so the vector sums never form a long dependency
+    // chain. Outputs near the ends read through a small buffer filled by the
+    // border mode. dst must not overlap src.
+    enum class border {
+        zero,
+        clamp,
+        wrap
+    };
+
+    namespace detail {
+        template <typename T>
+        T border_value(const T* src, std::ptrdiff_t n, std::ptrdiff_t i, border mode)
+        {
+            if (i >= 0 && i < n)
+                return src[i];
+
+            switch (mode) {
+            case border::clamp:
+                return src[i < 0 ? 0 : n - 1];
+            case border::wrap:
+                return src[(i % n + n) % n];
+            default:
+                return T {};
+            }
+        }
+
+        // Calls kernel(window, dst, count) on the interior and on the two
+        // ends, where output i reads window[i, i + before + after].
+        template <typename T, typename Kernel>
+        void with_borders(const T* src, size_t n, size_t before, size_t after, border mode, T* dst, Kernel kernel)
+        {
+            auto edge = [&](size_t begin, size_t end) {
+                if (begin == end)
+                    return;
+
+                std::vector<T> window(end - begin + before + after);
+                for (size_t i = 0; i < window.size(); ++i) {
+                    auto pos = static_cast<std::ptrdiff_t>(begin + i) - static_cast<std::ptrdiff_t>(before);
+                    window[i] = border_value(src, static_cast<std::ptrdiff_t>(n), pos, mode);
+                }
+
+                kernel(window.data(), dst + begin, end - begin);
+            };
+
+            if (n == 0)
+                return;
+
+            if (n <= before + after) {
+                edge(0, n);
+                return;
+            }
+
+            kernel(src, dst + before, n - before - after);
+            edge(0, before);
+            edge(n - after, n);
+        }
+
+        // dst[i] = sum_k taps[k] * src[i + k] for i < count.
+        template <size_t VectorSize, typename T>
+        void correlate_kernel(const T* src, const T* taps, size_t tap_count, T* dst, size_t count)
+        {
+            using Vec = vector<T, VectorSize>;
+
+            constexpr size_t block = 512;
+
+            for (size_t begin = 0; begin < count; begin += block, src += block, dst += block) {
+                const size_t size = std::min(block, count - begin);
+                const size_t loops = size / VectorSize;
+                const size_t rem = size % VectorSize;
+
+                std::fill(dst, dst + size, T {});
+                for (size_t k = 0; k < tap_count; ++k) {
+                    const T tap = taps[k];
+                    const T* xs = src + k;
+                    T* sums = dst;
+                    for (size_t i = 0; i < loops; ++i, xs += VectorSize, sums += VectorSize)
+                        store_to(load_from<Vec>(sums) + scalar<Vec>(tap) * load_from<Vec>(xs), sums);
+                    for (size_t i = 0; i < rem; ++i)
+                        sums[i] = sums[i] + tap * xs[i];
+                }
+            }
+        }
+
+        template <size_t VectorSize, typename T>
+        void correlate(const T* src, size_t n, const T* taps, size_t tap_count, size_t origin, T* dst, border mode)
+        {
+            with_borders(src, n, origin, tap_count - 1 - origin, mode, dst, [&](const T* window, T* out, size_t count) {
+                correlate_kernel<VectorSize>(window, taps, tap_count, out, count);
+            });
+        }
+
+        template <typename V, typename T, size_t... Ks>
+        constexpr std::array<V, sizeof...(Ks)> stencil_window(const T* src, std::index_sequence<Ks...>)
+        {
+            return { load_from<V>(src + Ks)... };
+        }
+
+        template <size_t Width, size_t Radius, typename T, typename F>
+        size_t stencil_kernel(const T* src, T* dst, size_t count, F& func)
+        {
+            using Vec = vector<T, Width>;
+            using Window = std::make_index_sequence<2 * Radius + 1>;
+
+            // The bound on the reads repeats i + Width <= count, since
+            // available == count + 2 * Radius. It is there for gcc: the
+            // second exit keeps the loop vectorizer from transposing the
+            // overlapping loads, which halves throughput, and leaves the body
+            // to the SLP vectorizer, which emits one load per window.
+            const size_t available = count + 2 * Radius;
+
+            size_t i = 0;
+            for (; i + Width <= count && i + Width + 2 * Radius <= available; i += Width)
+                store_to(func(stencil_window<Vec>(src + i, Window {})), dst + i);
+
+            return i;
+        }
+
+    } // namespace detail
+
+    // dst[i] = sum_k taps[k] * src[i - k], the causal filter of a stream
+    // whose samples before src[0] are given by mode.
+    template <size_t VectorSize, typename T>
+    void fir(const T* src, size_t n, const T* taps, size_t tap_count, T* dst, border mode = border::zero)
+    {
+        if (tap_count == 0)
+            return std::fill(dst, dst + n, T {});
+
+        std::vector<T> reversed(taps, taps + tap_count);
+        std::reverse(reversed.begin(), reversed.end());
+
+        detail::correlate<VectorSize>(src, n, reversed.data(), tap_count, tap_count - 1, dst, mode);
+    }
+
+    // dst[i] = sum_k kernel[k] * src[i + k - count / 2], the kernel centered
+    // on each element. This is a correlation, which equals the convolution
+    // for the usual symmetric kernels.
+    template <size_t VectorSize, typename T>
+    void convolve(const T* src, size_t n, const T* kernel, size_t count, T* dst, border mode = border::zero)
+    {
+        if (count == 0)
+            return std::fill(dst, dst + n, T {});
+
+        detail::correlate<VectorSize>(src, n, kernel, count, count / 2, dst, mode);
+    }
+
+    // Convolves every row of a row-major width x height image with
+    // row_kernel, then every column with column_kernel.
+    template <size_t VectorSize, typename T>
+    void convolve_separable(const T* src, size_t width, size_t height,
+        const T* row_kernel, size_t row_count, const T* column_kernel, size_t column_count,
+        T* dst, border mode = border::zero)
+    {
+        std::vector<T> rows(width * height);
+        for (size_t y = 0; y < height; ++y)
+            convolve<VectorSize>(src + y * width, width, row_kernel, row_count, rows.data() + y * width, mode);
+
+        std::vector<const T*> inputs;
+        std::vector<T> weights;
+        for (size_t y = 0; y < height; ++y) {
+            inputs.clear();
+            weights.clear();
+            for (size_t k = 0; k < column_count; ++k) {
+                auto row = static_cast<std::ptrdiff_t>(y + k) - static_cast<std::ptrdiff_t>(column_count / 2);
+                auto h = static_cast<std::ptrdiff_t>(height);
+                if (row < 0 || row >= h) {
+                    if (mode == border::zero)
+                        continue;
+                    row = mode == border::clamp ? std::clamp<std::ptrdiff_t>(row, 0, h - 1) : (row % h + h) % h;
+                }
+
+                inputs.push_back(rows.data() + row * width);
+                weights.push_back(column_kernel[k]);
+            }
+
+            T* out = dst + y * width;
+            std::fill(out, out + width, T {});
+            for (size_t k = 0; k < inputs.size(); ++k) {
+                const T weight = weights[k];
+                transform<VectorSize>(inputs[k], width, out, out, [weight](auto x, auto sum) {
+                    return sum + x * weight;
+                });
+            }
+        }
+    }
+
+    // dst[i] = func(window) for windows of 2 * Radius + 1 vectors, where
+    // window[k] holds src[i + k - Radius] in lane i. func is called with
+    // vectors of VectorSize and of 1 lane, like the func of transform.
+    template <size_t VectorSize, size_t Radius, typename T, typename F>
+    void stencil(const T* src, size_t n, T* dst, F func, border mode = border::zero)
+    {
+        detail::with_borders(src, n, Radius, Radius, mode, dst, [&](const T* window, T* out, size_t count) {
+            size_t done = detail::stencil_kernel<VectorSize, Radius>(window, out, count, func);
+            detail::stencil_kernel<1, Radius>(window + done, out + done, count - done, func);
+        });
+    }
+
+    // Algorithms: sort.
+    namespace detail {
+        struct no_payload {
+        };
+
+        template <typename P>
+        constexpr P* advance(P* payloads, size_t n)
+        {
+            if constexpr (std::is_same_v<std::remove_const_t<P>, no_payload>)
+                return payloads;
+            else
+                return payloads + n;
+        }
+
+        template <typename T, typename P>
+        void insertion_sort(T* keys, size_t n, P* payloads)
+        {
+            for (size_t i = 1; i < n; ++i) {
+                for (size_t j = i; j > 0 && keys[j] < keys[j - 1]; --j) {
+                    std::swap(keys[j], keys[j - 1]);
+                    if constexpr (!std::is_same_v<P, no_payload>)
+                        std::swap(payloads[j], payloads[j - 1]);
+                }
+            }
+        }
+
+        // Sorts runs of VectorSize elements. Blocks of VectorSize vectors are
+        // sorted column-wise in registers and stored transposed, so that every
+        // column becomes a run. The tail is sorted by insertion sort.
+        template <size_t VectorSize, typename T, typename P>
+        void sort_runs(T* keys, size_t n, P* payloads)
+        {
+            using KeyVec = vector<T, VectorSize>;
+            using PayloadVec = vector<P, VectorSize>;
+
+            constexpr size_t block_size = VectorSize * VectorSize;
+
+            auto rem = n % block_size;
+            auto loops = n / block_size;
+
+            for (size_t i = 0; i < loops; ++i, keys += block_size, payloads = advance(payloads, block_size)) {
+                std::array<KeyVec, VectorSize> columns;
+                for (size_t k = 0; k < VectorSize; ++k)
+                    columns[k] = load_from<KeyVec>(keys + k * VectorSize);
+
+                if constexpr (std::is_same_v<P, no_payload>) {
+                    columns = sort_columns(columns);
+                } else {
+                    std::array<PayloadVec, VectorSize> payload_columns;
+                    for (size_t k = 0; k < VectorSize; ++k)
+                        payload_columns[k] = load_from<PayloadVec>(payloads + k * VectorSize);
+
+                    std::tie(columns, payload_columns) = sort_columns(columns, payload_columns);
+
+                    for (size_t k = 0; k < VectorSize; ++k)
+                        for (size_t l = 0; l < VectorSize; ++l)
+                            payloads[l * VectorSize + k] = payload_columns[k][l];
+                }
+
+                for (size_t k = 0; k < VectorSize; ++k)
+                    for (size_t l = 0; l < VectorSize; ++l)
+                        keys[l * VectorSize + k] = columns[k][l];
+            }
+
+            for (size_t i = 0; i < rem; i += VectorSize)
+                insertion_sort(keys + i, std::min(VectorSize, rem - i), advance(payloads, i));
+        }
+
+        // Branchless merge of the sorted runs `a` and `b` into `out`.
+        template <typename T, typename P>
+        void merge_runs(const T* a, size_t na, const T* b, size_t nb, T* out, const P* pa, const P* pb, P* pout)
+        {
+            size_t ia = 0;
+            size_t ib = 0;
+
+            while (ia < na && ib < nb) {
+                bool from_b = b[ib] < a[ia];
+
+                *out++ = from_b ? b[ib] : a[ia];
+                if constexpr (!std::is_same_v<P, no_payload>)
+                    *pout++ = from_b ? pb[ib] : pa[ia];
+
+                ib += from_b;
+                ia += !from_b;
+            }
+
+            out = std::copy(a + ia, a + na, out);
+            std::copy(b + ib, b + nb, out);
+
+            if constexpr (!std::is_same_v<P, no_payload>) {
+                pout = std::copy(pa + ia, pa + na, pout);
+                std::copy(pb + ib, pb + nb, pout);
+            }
+        }
+
+        template <size_t VectorSize, typename T, typename P>
+        void sort_impl(T* keys, size_t n, P* payloads)
+        {
+            constexpr bool has_payload = !std::is_same_v<P, no_payload>;
+
+            sort_runs<VectorSize>(keys, n, payloads);
+
+            if (n <= VectorSize)
+                return;
+
+            std::vector<T> key_buffer(n);
+            std::vector<P> payload_buffer(has_payload ? n : 0);
+
+            T* src = keys;
+            T* dst = key_buffer.data();
+            P* payload_src = payloads;
+            P* payload_dst = payload_buffer.data();
+
+            for (size_t width = VectorSize; width < n; width *= 2) {
+                for (size_t lo = 0; lo < n; lo += 2 * width) {
+                    auto mid = std::min(lo + width, n);
+                    auto hi = std::min(lo + 2 * width, n);
+
+                    merge_runs(
+                        src + lo, mid - lo, src + mid, hi - mid, dst + lo,
+                        advance<const P>(payload_src, lo), advance<const P>(payload_src, mid), advance(payload_dst, lo));
+                }
+
+                std::swap(src, dst);
+                std::swap(payload_src, payload_dst);
+            }
+
+            if (src != keys) {
+                std::copy(src, src + n, keys);
+                if constexpr (has_payload)
+                    std::copy(payload_src, payload_src + n, payloads);
+            }
+        }
+
+    } // namespace detail
+
+    // Sorts `keys` in ascending order. Runs of VectorSize elements are formed
+    // by sorting networks over VectorSize vectors and then merged bottom-up.
+    template <size_t VectorSize, typename T>
+    void sort(T* keys, size_t n)
+    {
+        detail::sort_impl<VectorSize>(keys, n, static_cast<detail::no_payload*>(nullptr));
+    }
+
+    // Sorts `keys` in ascending order and moves `payloads` along with them.
+    template <size_t VectorSize, typename T, typename P>
+    void sort(T* keys, size_t n, P* payloads)
+    {
+        detail::sort_impl<VectorSize>(keys, n, payloads);
+    }
+
+    // Algorithms: inclusive_scan.
+    namespace detail {
+        // xs moved up by Shift lanes, with zeros shifted in.
+        template <size_t Shift, typename V, size_t... Is>
+        constexpr V shift_lanes_up(V xs, std::index_sequence<Is...>)
+        {
+            return { (Is >= Shift ? xs[Is - Shift] : typename V::value_type {})... };
+        }
+
+        // Prefix sums of the lanes of xs, in log2(N) steps.
+        template <size_t Step = 1, typename V>
+        constexpr V scan_lanes(V xs)
+        {
+            if constexpr (Step < V::size())
+                return scan_lanes<2 * Step>(xs + shift_lanes_up<Step>(xs, index_sequence_of<V> {}));
+            else
+                return xs;
+        }
+
+    } // namespace detail
+
+    constexpr size_t scan_block = 1024;
+
+    // dst[i] = init + src[0] + ... + src[i]. A block of scan_block elements
+    // is first scanned vector by vector, which has no dependencies between
+    // the vectors, and then the running total is added in a second pass
+    // over the block while it is still in L1. src may equal dst.
+    template <size_t VectorSize, typename T>
+    void inclusive_scan(const T* src, size_t n, T* dst, T init = T {})
+    {
+        using V = vector<T, VectorSize>;
+
+        static_assert(scan_block % VectorSize == 0);
+
+        size_t i = 0;
+        for (; i + scan_block <= n; i += scan_block) {
+            for (size_t j = i; j < i + scan_block; j += VectorSize)
+                store_to(detail::scan_lanes(load_from<V>(src + j)), dst + j);
+
+            for (size_t j = i; j < i + scan_block; j += VectorSize) {
+                auto xs = load_from<V>(dst + j) + scalar<V>(init);
+                store_to(xs, dst + j);
+                init = xs[VectorSize - 1];
+            }
+        }
+
+        for (; i < n; ++i)
+            dst[i] = init = init + src[i];
+    }
+
+    // Algorithms: bit packing, frame of reference, and delta coding.
+    //
+    // pack_bits stores the low `bits` bits of every value. Full blocks of
+    // bitpack_block values are packed column-wise: value i belongs to column
+    // i % bitpack_lanes, and every column fills its own sequence of words,
+    // which are interleaved in memory like the values. Every shift is then
+    // the same for all lanes, so a block packs with whole-vector shifts,
+    // and the layout does not depend on VectorSize. A shorter last block is
+    // packed sequentially. Each of the 33 widths is its own fully unrolled
+    // kernel.
+    //
+    // encode and decode add a two-word header to every block: the bit width
+    // and the reference (the minimum) that is subtracted before packing. With
+    // integer_coding::delta, the differences of consecutive values are
+    // coded instead, which suits sorted posting lists and timestamps, and
+    // decoding ends with an inclusive_scan. All arithmetic wraps around.
+    // decode checks every header against the size of its input, so corrupt
+    // data throws std::invalid_argument instead of reading out of bounds.
+    constexpr size_t bitpack_lanes = 32;
+
+    constexpr size_t bitpack_block = 32 * bitpack_lanes;
+
+    enum class integer_coding { frame_of_reference, delta };
+
+    // The number of words that pack_bits writes.
+    constexpr size_t packed_size(size_t n, unsigned bits)
+    {
+        return n / bitpack_block * bits * bitpack_lanes + (n % bitpack_block * bits + 31) / 32;
+    }
+
+    // An upper bound of the number of words that encode writes.
+    constexpr size_t max_encoded_size(size_t n)
+    {
+        return (n + bitpack_block - 1) / bitpack_block * 2 + n;
+    }
+
+    namespace detail {
+        constexpr unsigned bit_width(std::uint32_t x)
+        {
+#if defined(__GNUC__)
+            return x == 0 ? 0 : 32 - __builtin_clz(x);
+#else
+            unsigned n = 0;
+            for (; x != 0; x >>= 1)
+                ++n;
+            return n;
+#endif
+        }
+
+        template <unsigned Bits, size_t Row, typename V>
+        void pack_row(const std::uint32_t* src, std::uint32_t* dst, V& word)
+        {
+            constexpr unsigned shift = Row * Bits % 32;
+            constexpr size_t index = Row * Bits / 32;
+
+            auto xs = load_from<V>(src + Row * bitpack_lanes);
+            if constexpr (shift == 0)
+                word = xs;
+            else
+                word = word | (xs << scalar<V>(shift));
+
+            if constexpr (shift + Bits >= 32) {
+                store_to(word, dst + index * bitpack_lanes);
+                if constexpr (shift + Bits > 32)
+                    word = xs >> scalar<V>(32 - shift);
+            }
+        }
+
+        template <unsigned Bits, typename V, size_t... Rows>
+        void pack_columns(const std::uint32_t* src, std::uint32_t* dst, std::index_sequence<Rows...>)
+        {
+            V word {};
+            (pack_row<Bits, Rows>(src, dst, word), ...);
+        }
+
+        template <unsigned Bits, size_t Row, typename V>
+        void unpack_row(const std::uint32_t* src, std::uint32_t* dst)
+        {
+            constexpr unsigned shift = Row * Bits % 32;
+            constexpr size_t index = Row * Bits / 32;
+
+            auto xs = load_from<V>(src + index * bitpack_lanes) >> scalar<V>(shift);
+            if constexpr (shift + Bits > 32)
+                xs = xs | (load_from<V>(src + (index + 1) * bitpack_lanes) << scalar<V>(32 - shift));
+            if constexpr (Bits < 32)
+                xs = xs & scalar<V>((std::uint32_t { 1 } << Bits) - 1);
+
+            store_to(xs, dst + Row * bitpack_lanes);
+        }
+
+        template <unsigned Bits, typename V, size_t... Rows>
+        void unpack_columns(const std::uint32_t* src, std::uint32_t* dst, std::index_sequence<Rows...>)
+        {
+            (unpack_row<Bits, Rows, V>(src, dst), ...);
+        }
+
+        template <size_t VectorSize, unsigned Bits>
+        void pack_block(const std::uint32_t* src, std::uint32_t* dst)
+        {
+            using V = vector<std::uint32_t, VectorSize>;
+
+            if constexpr (Bits > 0) {
+                for (size_t column = 0; column < bitpack_lanes; column += VectorSize)
+                    pack_columns<Bits, V>(src + column, dst + column, std::make_index_sequence<32> {});
+            }
+        }
+
+        template <size_t VectorSize, unsigned Bits>
+        void unpack_block(const std::uint32_t* src, std::uint32_t* dst)
+        {
+            using V = vector<std::uint32_t, VectorSize>;
+
+            if constexpr (Bits == 0) {
+                std::fill(dst, dst + bitpack_block, 0);
+            } else {
+                for (size_t column = 0; column < bitpack_lanes; column += VectorSize)
+                    unpack_columns<Bits, V>(src + column, dst + column, std::make_index_sequence<32> {});
+            }
+        }
+
+        using block_kernel = void (*)(const std::uint32_t*, std::uint32_t*);
+
+        template <size_t VectorSize, unsigned... Bits>
+        constexpr std::array<block_kernel, sizeof...(Bits)> pack_kernels(std::integer_sequence<unsigned, Bits...>)
+        {
+            return { &pack_block<VectorSize, Bits>... };
+        }
+
+        template <size_t VectorSize, unsigned... Bits>
+        constexpr std::array<block_kernel, sizeof...(Bits)> unpack_kernels(std::integer_sequence<unsigned, Bits...>)
+        {
+            return { &unpack_block<VectorSize, Bits>... };
+        }
+
+        inline std::uint32_t* pack_sequential(const std::uint32_t* src, size_t n, unsigned bits, std::uint32_t* dst)
+        {
+            std::uint64_t buffer = 0;
+            unsigned filled = 0;
+            for (size_t i = 0; i < n; ++i) {
+                buffer |= std::uint64_t { src[i] } << filled;
+                filled += bits;
+                if (filled >= 32) {
+                    *dst++ = static_cast<std::uint32_t>(buffer);
+                    buffer >>= 32;
+                    filled -= 32;
+                }
+            }
+
+            if (filled > 0)
+                *dst++ = static_cast<std::uint32_t>(buffer);
+            return dst;
+        }
+
+        inline const std::uint32_t* unpack_sequential(const std::uint32_t* src, size_t n, unsigned bits, std::uint32_t* dst)
+        {
+            const std::uint64_t mask = (std::uint64_t { 1 } << bits) - 1;
+
+            std::uint64_t buffer = 0;
+            unsigned filled = 0;
+            for (size_t i = 0; i < n; ++i) {
+                if (filled < bits) {
+                    buffer |= std::uint64_t { *src++ } << filled;
+                    filled += 32;
+                }
+                dst[i] = static_cast<std::uint32_t>(buffer & mask);
+                buffer >>= bits;
+                filled -= bits;
+            }
+            return src;
+        }
+
+    } // namespace detail
+
+    // Packs the low `bits` bits (0 to 32) of n values, which must not have
+    // higher bits set, into packed_size(n, bits) words. Returns the end of
+    // the output.
+    template <size_t VectorSize>
+    std::uint32_t* pack_bits(const std::uint32_t* src, size_t n, unsigned bits, std::uint32_t* dst)
+    {
+        static_assert(bitpack_lanes % VectorSize == 0);
+        static constexpr auto kernels = detail::pack_kernels<VectorSize>(std::make_integer_sequence<unsigned, 33> {});
+
+        if (bits > 32)
+            throw std::invalid_argument("bit width must be at most 32");
+
+        auto kernel = kernels[bits];
+        for (; n >= bitpack_block; n -= bitpack_block, src += bitpack_block, dst += bits * bitpack_lanes)
+            kernel(src, dst);
+
+        return detail::pack_sequential(src, n, bits, dst);
+    }
+
+    // The inverse of pack_bits. Returns the end of the input.
+    template <size_t VectorSize>
+    const std::uint32_t* unpack_bits(const std::uint32_t* src, size_t n, unsigned bits, std::uint32_t* dst)
+    {
+        static_assert(bitpack_lanes % VectorSize == 0);
+        static constexpr auto kernels = detail::unpack_kernels<VectorSize>(std::make_integer_sequence<unsigned, 33> {});
+
+        if (bits > 32)
+            throw std::invalid_argument("bit width must be at most 32");
+
+        auto kernel = kernels[bits];
+        for (; n >= bitpack_block; n -= bitpack_block, src += bits * bitpack_lanes, dst += bitpack_block)
+            kernel(src, dst);
+
+        return detail::unpack_sequential(src, n, bits, dst);
+    }
+
+    // The number of bits needed for the largest of n values.
+    template <size_t VectorSize>
+    unsigned required_bits(const std::uint32_t* src, size_t n)
+    {
+        auto ors = accumulate<VectorSize>(src, n, std::uint32_t {}, std::bit_or<>());
+        return detail::bit_width(std::accumulate(ors.begin(), ors.end(), std::uint32_t {}, std::bit_or<>()));
+    }
+
+    // Writes at most max_encoded_size(n) words and returns their number.
+    template <size_t VectorSize>
+    size_t encode(const std::uint32_t* src, size_t n, std::uint32_t* dst, integer_coding coding)
+    {
+        auto min = [](auto x, auto y) { return std::min(x, y); };
+        auto minus = [](std::uint32_t x, std::uint32_t y) { return x - y; };
+
+        std::array<std::uint32_t, bitpack_block> offsets;
+        std::uint32_t previous = 0;
+
+        const auto begin = dst;
+        for (size_t i = 0; i < n; i += bitpack_block) {
+            const size_t count = std::min(bitpack_block, n - i);
+            const std::uint32_t* values = src + i;
+
+            if (coding == integer_coding::delta) {
+                offsets[0] = src[i] - previous;
+                transform<VectorSize>(src + i + 1, count - 1, src + i, offsets.data() + 1, minus);
+                previous = src[i + count - 1];
+                values = offsets.data();
+            }
+
+            auto minima = accumulate<VectorSize>(values, count, ~std::uint32_t {}, min);
+            auto reference = *std::min_element(minima.begin(), minima.end());
+
+            transform<VectorSize>(values, count, offsets.data(), [reference](std::uint32_t x) { return x - reference; });
+            auto bits = required_bits<VectorSize>(offsets.data(), count);
+
+            *dst++ = bits;
+            *dst++ = reference;
+            dst = pack_bits<VectorSize>(offsets.data(), count, bits, dst);
+        }
+
+        return dst - begin;
+    }
+
+    // Decodes n values written by encode with the same coding from the
+    // `size` words at src. Returns the end of the input.
+    template <size_t VectorSize>
+    const std::uint32_t* decode(const std::uint32_t* src, size_t size, size_t n, std::uint32_t* dst, integer_coding coding)
+    {
+        const auto end = src + size;
+
+        std::uint32_t previous = 0;
+        for (size_t i = 0; i < n; i += bitpack_block) {
+            const size_t count = std::min(bitpack_block, n - i);
+            if (end - src < 2)
+                throw std::invalid_argument("encoded data ends before a block header");
+
+            const std::uint32_t bits = src[0];
+            const std::uint32_t reference = src[1];
+            if (bits > 32)
+                throw std::invalid_argument("encoded block has a bit width above 32");
+            if (packed_size(count, bits) > static_cast<size_t>(end - src - 2))
+                throw std::invalid_argument("encoded data ends inside a block");
+
+            src = unpack_bits<VectorSize>(src + 2, count, bits, dst + i);
+            transform<VectorSize>(dst + i, count, dst + i, [reference](std::uint32_t x) { return x + reference; });
+
+            if (coding == integer_coding::delta) {
+                inclusive_scan<VectorSize>(dst + i, count, dst + i, previous);
+                previous = dst[i + count - 1];
+            }
+        }
+
+        return src;
+    }
+
+    // Algorithms: random number generation.
+    //
+    // philox is the counter-based Philox4x32-10 generator. Every fourth call
+    // encrypts the next VectorSize counters under the seed, with the stream
+    // number in the upper half of each counter, and the four words of the
+    // blocks are returned over four calls, so that every lane has a block of
+    // its own in flight. seek reaches any call in constant time, and a copy
+    // that starts at position p produces exactly the values a single engine
+    // would, so fill_random can split its range among threads. xoshiro256pp runs one
+    // xoshiro256++ per lane, lane l starting l jumps of 2^128 steps after the
+    // seeded state, so that the lanes never overlap.
+    //
+    // Every call of an engine returns its next VectorSize values. The
+    // distributions consume one engine value per float and 64 bits per
+    // double, whatever the engine.
+    namespace detail {
+        inline double double_of_bits(std::uint64_t bits)
+        {
+            double x;
+            std::memcpy(&x, &bits, sizeof(x));
+            return x;
+        }
+
+        // Philox4x32-10 over a vector of counters. Every round is a loop over
+        // the lanes, which gcc vectorizes with widening multiplications, and
+        // the rounds are expanded from a pack rather than left to the unroller.
+        template <typename V, std::uint32_t... Rounds>
+        std::array<V, 4> philox_rounds(std::array<V, 4> c, std::uint32_t k0, std::uint32_t k1, std::integer_sequence<std::uint32_t, Rounds...>)
+        {
+            auto round = [&c](std::uint32_t k0, std::uint32_t k1) {
+                for (size_t i = 0; i < V::size(); ++i) {
+                    std::uint64_t p0 = std::uint64_t { c[0][i] } * 0xd2511f53u;
+                    std::uint64_t p1 = std::uint64_t { c[2][i] } * 0xcd9e8d57u;
+                    c[0][i] = static_cast<std::uint32_t>(p1 >> 32) ^ c[1][i] ^ k0;
+                    c[1][i] = static_cast<std::uint32_t>(p1);
+                    c[2][i] = static_cast<std::uint32_t>(p0 >> 32) ^ c[3][i] ^ k1;
+                    c[3][i] = static_cast<std::uint32_t>(p0);
+                }
+            };
+
+            (round(k0 + Rounds * 0x9e3779b9u, k1 + Rounds * 0xbb67ae85u), ...);
+            return c;
+        }
+
+        template <typename V>
+        std::array<V, 4> philox_block(const std::array<V, 4>& c, std::uint32_t k0, std::uint32_t k1)
+        {
+            return philox_rounds(c, k0, k1, std::make_integer_sequence<std::uint32_t, 10> {});
+        }
+
+        constexpr std::uint64_t splitmix64(std::uint64_t& state)
+        {
+            std::uint64_t z = (state += 0x9e3779b97f4a7c15u);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9u;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebu;
+            return z ^ (z >> 31);
+        }
+
+        // Advances xoshiro256 states by the jump polynomial `jump`.
+        template <typename S>
+        void xoshiro_jump(S& s, const std::uint64_t (&jump)[4], void (*next)(S&))
+        {
+            S t {};
+            for (std::uint64_t word : jump) {
+                for (int b = 0; b < 64; ++b) {
+                    if (word & (std::uint64_t { 1 } << b)) {
+                        for (size_t k = 0; k < 4; ++k)
+                            t[k] = t[k] ^ s[k];
+                    }
+                    next(s);
+                }
+            }
+            s = t;
+        }
+
+    } // namespace detail
+
+    template <size_t VectorSize>
+    class philox {
+    public:
+        using result_type = vector<std::uint32_t, VectorSize>;
+
+        explicit philox(std::uint64_t seed = 0, std::uint64_t stream = 0)
+            : key_ { static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32) }
+            , stream_ { static_cast<std::uint32_t>(stream), static_cast<std::uint32_t>(stream >> 32) }
+        {
+        }
+
+        static constexpr size_t size() { return VectorSize; }
+
+        result_type operator()()
+        {
+            auto group = call_ / 4;
+            if (group != group_) {
+                blocks_ = blocks(group);
+                group_ = group;
+            }
+            return blocks_[call_++ % 4];
+        }
+
+        // The number of values returned so far.
+        std::uint64_t position() const { return call_ * VectorSize; }
+
+        // Positions move in whole calls, so they are rounded down to a
+        // multiple of VectorSize.
+        void seek(std::uint64_t position) { call_ = position / VectorSize; }
+
+        void discard(std::uint64_t count) { seek(position() + count); }
+
+    private:
+        // Encrypts the counters of `group`, which the next four calls return
+        // word by word.
+        std::array<result_type, 4> blocks(std::uint64_t group) const
+        {
+            using B = vector<std::uint64_t, VectorSize>;
+
+            auto counters = iota<B>(group * VectorSize, std::uint64_t { 1 });
+            return detail::philox_block<result_type>(
+                { cast_to<std::uint32_t>(counters), cast_to<std::uint32_t>(counters >> scalar<B>(std::uint64_t { 32 })),
+                    scalar<result_type>(stream_[0]), scalar<result_type>(stream_[1]) },
+                key_[0], key_[1]);
+        }
+
+        std::uint32_t key_[2];
+        std::uint32_t stream_[2];
+        std::uint64_t call_ = 0;
+        std::uint64_t group_ = ~std::uint64_t {};
+        std::array<result_type, 4> blocks_;
+    };
+
+    template <size_t VectorSize>
+    class xoshiro256pp {
+    public:
+        using result_type = vector<std::uint64_t, VectorSize>;
+
+        // The seed is expanded by splitmix64, as the authors recommend.
+        explicit xoshiro256pp(std::uint64_t seed = 0)
+        {
+            state_type s;
+            for (auto& word : s)
+                word = detail::splitmix64(seed);
+
+            for (size_t lane = 0; lane < VectorSize; ++lane) {
+                for (size_t k = 0; k < 4; ++k)
+                    lanes_[k][lane] = s[k];
+                detail::xoshiro_jump(s, jump_polynomial, &next_scalar);
+            }
+        }
+
+        static constexpr size_t size() { return VectorSize; }
+
+        result_type operator()()
+        {
+            auto& [s0, s1, s2, s3] = lanes_;
+
+            result_type result;
+            for (size_t i = 0; i < VectorSize; ++i) {
+                result[i] = rotl(s0[i] + s3[i], 23) + s0[i];
+                auto t = s1[i] << 17;
+
+                s2[i] ^= s0[i];
+                s3[i] ^= s1[i];
+                s1[i] ^= s2[i];
+                s0[i] ^= s3[i];
+                s2[i] ^= t;
+                s3[i] = rotl(s3[i], 45);
+            }
+            return result;
+        }
+
+        // Advances every lane by 2^192 steps, which gives a thread its own
+        // set of lanes.
+        void long_jump()
+        {
+            for (size_t lane = 0; lane < VectorSize; ++lane) {
+                state_type s { lanes_[0][lane], lanes_[1][lane], lanes_[2][lane], lanes_[3][lane] };
+                detail::xoshiro_jump(s, long_jump_polynomial, &next_scalar);
+                for (size_t k = 0; k < 4; ++k)
+                    lanes_[k][lane] = s[k];
+            }
+        }
+
+    private:
+        using state_type = std::array<std::uint64_t, 4>;
+
+        static constexpr std::uint64_t rotl(std::uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+        static void next_scalar(state_type& s)
+        {
+            auto t = s[1] << 17;
+            s[2] ^= s[0];
+            s[3] ^= s[1];
+            s[1] ^= s[2];
+            s[0] ^= s[3];
+            s[2] ^= t;
+            s[3] = rotl(s[3], 45);
+        }
+
+        static constexpr std::uint64_t jump_polynomial[4] = {
+            0x180ec6d33cfd0abau, 0xd5a61266f0c9392cu, 0xa9582618e03fc9aau, 0x39abdc4529b1661cu
+        };
+
+        static constexpr std::uint64_t long_jump_polynomial[4] = {
+            0x76e15d3efefdcbbfu, 0xc5004e441c522fb3u, 0x77710069854ee241u, 0x39109bb02acbe635u
+        };
+
+        std::array<result_type, 4> lanes_;
+    };
+
+    namespace detail {
+        // The next VectorSize values of `gen` as U, combining two values of a
+        // 32-bit engine for 64 bits and keeping the upper half of a 64-bit
+        // engine for 32 bits.
+        template <typename U, typename Engine>
+        auto random_bits(Engine& gen)
+        {
+            using R = typename Engine::result_type;
+            using W = typename R::value_type;
+            using V = typename R::template with_value_t<U>;
+
+            if constexpr (sizeof(U) > sizeof(W)) {
+                static_assert(sizeof(U) == 2 * sizeof(W));
+                auto lo = cast_to<U>(gen());
+                auto hi = cast_to<U>(gen());
+                return (hi << scalar<V>(U(sizeof(W) * CHAR_BIT))) | lo;
+            } else if constexpr (sizeof(U) < sizeof(W)) {
+                return cast_to<U>(gen() >> scalar<R>(W((sizeof(W) - sizeof(U)) * CHAR_BIT)));
+            } else {
+                return gen();
+            }
+        }
+
+        // The engine values that one vector of U takes.
+        template <typename U, typename Engine>
+        constexpr size_t engine_values_per_vector()
+        {
+            using W = typename Engine::result_type::value_type;
+            return Engine::size() * std::max<size_t>(1, sizeof(U) / sizeof(W));
+        }
+
+        template <typename T>
+        using bits_of_t = std::conditional_t<sizeof(T) == sizeof(std::uint64_t), std::uint64_t, std::uint32_t>;
+
+        // Uniform on [0, 1) with 23 or 52 random bits: the bits fill the
+        // mantissa of a number in [1, 2).
+        template <typename T, typename Engine>
+        auto random_unit(Engine& gen)
+        {
+            if constexpr (std::is_same_v<T, float>) {
+                return unroll(random_bits<std::uint32_t>(gen), [](std::uint32_t bits) {
+                    return float_of_bits((bits >> 9) | 0x3f800000u) - 1.0f;
+                });
+            } else {
+                static_assert(std::is_same_v<T, double>, "only float and double are supported");
+                return unroll(random_bits<std::uint64_t>(gen), [](std::uint64_t bits) {
+                    return double_of_bits((bits >> 12) | 0x3ff0000000000000u) - 1.0;
+                });
+            }
+        }
+
+        // log(x) for normal x > 0, within two ulp, after Cephes' logf.
+        inline float log_normal_float(float x)
+        {
+            std::uint32_t bits = bits_of_float(x);
+            int exponent = int(bits >> 23) - 126;
+            float m = float_of_bits((bits & 0x7fffffu) | 0x3f000000u);
+
+            bool low = m < 0.70710678f;
+            exponent -= low;
+            float f = low ? m + m - 1.0f : m - 1.0f;
+
+            float z = f * f;
+            float y = 7.0376836292e-2f;
+            y = y * f - 1.1514610310e-1f;
+            y = y * f + 1.1676998740e-1f;
+            y = y * f - 1.2420140846e-1f;
+            y = y * f + 1.4249322787e-1f;
+            y = y * f - 1.6668057665e-1f;
+            y = y * f + 2.0000714765e-1f;
+            y = y * f - 2.4999993993e-1f;
+            y = y * f + 3.3333331174e-1f;
+            y = y * f * z;
+
+            float e = static_cast<float>(exponent);
+            y += -2.12194440e-4f * e - 0.5f * z;
+            return f + y + 0.693359375f * e;
+        }
+
+        // sqrt(x) for x >= 0 from the bit-level estimate of 1 / sqrt(x) and
+        // three Newton steps. std::sqrt may set errno, which keeps gcc from
+        // vectorizing it.
+        inline float sqrt_nonnegative(float x)
+        {
+            float y = float_of_bits(0x5f375a86u - (bits_of_float(x) >> 1));
+            for (int step = 0; step < 3; ++step)
+                y = y * (1.5f - 0.5f * x * y * y);
+            return x * y;
+        }
+
+        // sin and cos of 2 pi t for t in [0, 1). The quadrant is taken from t
+        // exactly, which leaves an angle within [-pi/4, pi/4] for the Cephes
+        // polynomials.
+        inline std::tuple<float, float> sin_cos_turns(float t)
+        {
+            int quadrant = static_cast<int>(4.0f * t + 0.5f);
+            float a = (t - 0.25f * static_cast<float>(quadrant)) * 6.28318530717958648f;
+            float z = a * a;
+
+            float s = a + a * z * (-1.6666654611e-1f + z * (8.3321608736e-3f + z * -1.9515295891e-4f));
+            float c = 1.0f - 0.5f * z + z * z * (4.166664568298827e-2f + z * (-1.388731625493765e-3f + z * 2.443315711809948e-5f));
+
+            float sine = quadrant & 1 ? c : s;
+            float cosine = quadrant & 1 ? s : c;
+            return { quadrant & 2 ? -sine : sine, (quadrant + 1) & 2 ? -cosine : cosine };
+        }
+
+    } // namespace detail
+
+    // All bits uniformly random, for unsigned integers of 32 or 64 bits.
+    template <typename T>
+    struct uniform_bits {
+        static_assert(std::is_unsigned_v<T> && (sizeof(T) == 4 || sizeof(T) == 8));
+
+        using bits_type = T;
+
+        template <typename Engine>
+        auto operator()(Engine& gen) const
+        {
+            return detail::random_bits<T>(gen);
+        }
+    };
+
+    // Uniform on [low, high).
+    template <typename T>
+    struct uniform_real {
+        using bits_type = detail::bits_of_t<T>;
+
+        T low = 0;
+        T high = 1;
+
+        template <typename Engine>
+        auto operator()(Engine& gen) const
+        {
+            using V = typename Engine::result_type::template with_value_t<T>;
+            return scalar<V>(low) + scalar<V>(high - low) * detail::random_unit<T>(gen);
+        }
+    };
+
+    // Normal by the Box-Muller transform. The first half of the uniform
+    // lanes gives the radii and the second half the angles, and every pair
+    // yields a cosine and a sine lane, so no state is carried between
+    // calls. float uses polynomial log, sqrt, sin and cos, which vectorize;
+    // double calls the standard ones.
+    template <typename T>
+    struct normal {
+        using bits_type = detail::bits_of_t<T>;
+
+        T mean = 0;
+        T stddev = 1;
+
+        template <typename Engine>
+        auto operator()(Engine& gen) const
+        {
+            static_assert(Engine::size() % 2 == 0, "normal needs an even VectorSize");
+
+            constexpr size_t half = Engine::size() / 2;
+
+            auto us = detail::random_unit<T>(gen);
+            decltype(us) result;
+            for (size_t i = 0; i < half; ++i) {
+                if constexpr (std::is_same_v<T, float>) {
+                    float r = stddev * detail::sqrt_nonnegative(-2.0f * detail::log_normal_float(1.0f - us[i]));
+                    auto [s, c] = detail::sin_cos_turns(us[half + i]);
+                    result[i] = mean + r * c;
+                    result[half + i] = mean + r * s;
+                } else {
+                    T r = stddev * std::sqrt(-2 * std::log(1 - us[i]));
+                    T a = us[half + i] * T(6.283185307179586476925286766559);
+                    result[i] = mean + r * std::cos(a);
+                    result[half + i] = mean + r * std::sin(a);
+                }
+            }
+            return result;
+        }
+    };
+
+    // Fills dst with values of `dist` drawn from `gen`. The tail takes a whole
+    // vector from the engine and drops what is left over.
+    template <typename T, typename Engine, typename Distribution>
+    void fill_random(T* dst, size_t n, Engine& gen, Distribution dist)
+    {
+        constexpr size_t VectorSize = Engine::size();
+
+        // A local copy of the state cannot alias dst, so it stays in registers.
+        auto local = gen;
+
+        size_t i = 0;
+        for (; i + VectorSize <= n; i += VectorSize)
+            store_to(dist(local), dst + i);
+
+        if (i < n) {
+            auto xs = dist(local);
+            std::copy(xs.begin(), xs.begin() + (n - i), dst + i);
+        }
+        gen = local;
+    }
+
+    // Splits the range among `threads` by counter: every thread seeks its
+    // own copy of `gen` to where its slice begins, so dst and the final
+    // position of `gen` are the same as with one thread.
+    template <typename T, size_t VectorSize, typename Distribution>
+    void fill_random(T* dst, size_t n, philox<VectorSize>& gen, Distribution dist, size_t threads)
+    {
+        constexpr size_t per_vector = detail::engine_values_per_vector<typename Distribution::bits_type, philox<VectorSize>>();
+
+        threads = detail::thread_count<VectorSize>(n, threads);
+        if (threads == 1)
+            return fill_random(dst, n, gen, dist);
+
+        // The slices copy `origin`, so that only the caller's slice, the
+        // last, touches `gen`.
+        const auto origin = gen;
+        detail::parallel_slices<VectorSize>(n, threads, [&](size_t, size_t begin, size_t size) {
+            auto copy = origin;
+            copy.seek(origin.position() + begin / VectorSize * per_vector);
+            fill_random(dst + begin, size, copy, dist);
+
+            if (begin + size == n)
+                gen = copy;
+        });
+    }
+
+    // Algorithms: decimal parsing and formatting.
+    //
+    // parse_uint, parse_int and parse_double read numbers separated by single
+    // delimiters, such as the ',' and '\n' of CSV columns: every number ends
+    // at the first character that cannot continue it, which is skipped. A
+    // compare of 64 bytes gives the mask of non-digits, from which the end of
+    // every number within them is a shift and a count away. Each run is then
+    // loaded so that it ends at the last of 8 or VectorSize (8 or 16) lanes,
+    // the lanes before it are zeroed, and the digits are folded pairwise with
+    // the weights 10, 100, 10^4 and 10^8, so up to VectorSize digits take one
+    // step. Parsing stops at the first field that is not a number or does not fit
+    // the type. parse_double rounds exactly: numbers that the fast path
+    // cannot convert exactly (more than 19 digits, large exponents, inf and
+    // nan) are handed to std::from_chars.
+    //
+    // format_uint and format_int write VectorSize numbers per step, each
+    // followed by the delimiter. Every value is split into 8-digit halves,
+    // which are divided by 10^4, 100 and 10 in all lanes at once. Each number
+    // is then copied as 16 bytes, and dst advances by its length only.
+    struct parse_result {
+        // One past the last character consumed.
+        const char* ptr;
+        // The number of values written.
+        size_t count;
+    };
+
+    // An upper bound of the number of bytes that format_uint and format_int write.
+    constexpr size_t max_formatted_size(size_t n)
+    {
+        return n * 21 + 16;
+    }
+
+    namespace detail {
+        constexpr std::uint64_t decimal_powers[20] = {
+            1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull,
+            100000000ull, 1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull,
+            10000000000000ull, 100000000000000ull, 1000000000000000ull, 10000000000000000ull,
+            100000000000000000ull, 1000000000000000000ull, 10000000000000000000ull
+        };
+
+        // value = value * factor + addend, wrapping around; returns whether
+        // that overflowed.
+        inline bool multiply_add_overflows(std::uint64_t& value, std::uint64_t factor, std::uint64_t addend)
+        {
+#if defined(__GNUC__)
+            bool overflow = __builtin_mul_overflow(value, factor, &value);
+            return __builtin_add_overflow(value, addend, &value) || overflow;
+#else
+            constexpr auto max = std::numeric_limits<std::uint64_t>::max();
+
+            bool overflow = factor != 0 && value > max / factor;
+            value *= factor;
+            overflow |= value > max - addend;
+            value += addend;
+            return overflow;
+#endif
+        }
+
+        // Loaded from offset 16 - N + len, keeps the last len of N lanes.
+        alignas(32) constexpr std::uint8_t digit_masks[32] = {
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
+        };
+
+        template <typename V>
+        PURE_SIMD_NOINLINE V load_padded(const char* text, size_t size, std::ptrdiff_t pos)
+        {
+            auto begin = std::max<std::ptrdiff_t>(pos, 0);
+            auto end = std::min<std::ptrdiff_t>(pos + V::size(), size);
+
+            std::uint8_t bytes[V::size()] = {};
+            if (begin < end)
+                std::memcpy(bytes + (begin - pos), text + begin, end - begin);
+            return load_from<V>(bytes);
+        }
+
+        // Loads the bytes of text from pos on, with zeros for those outside [0, size).
+        template <typename V>
+        inline V load_bytes(const char* text, size_t size, std::ptrdiff_t pos)
+        {
+            if (pos >= 0 && static_cast<size_t>(pos) + V::size() <= size)
+                return load_from<V>(reinterpret_cast<const std::uint8_t*>(text + pos));
+            return load_padded<V>(text, size, pos);
+        }
+
+        // The mask of the lanes of bytes that are decimal digits.
+        template <typename V>
+        inline std::uint64_t digit_mask(const V& bytes)
+        {
+            return bitmask(unroll(bytes, [](std::uint8_t b) {
+                return static_cast<std::uint8_t>(b - '0') <= 9;
+            }));
+        }
+
+        // Combines neighbouring lanes as the high and the low digits of a
+        // number in base `weight`. The pairs are read as lanes of twice the
+        // width, the earlier lane being the lower half, so every step is a
+        // multiplication, a shift and an addition.
+        template <typename W, typename V>
+        inline vector<W, V::size() / 2> fold_digits(const V& xs, W weight)
+        {
+            constexpr unsigned half = 4 * sizeof(W);
+            constexpr W low = (W { 1 } << half) - 1;
+
+            vector<W, V::size() / 2> pairs;
+            static_assert(sizeof(pairs.data) == sizeof(xs.data));
+            std::memcpy(pairs.data, xs.data, sizeof(pairs.data));
+
+            return unroll(pairs, [weight](W x) { return static_cast<W>((x & low) * weight + (x >> half)); });
+        }
+
+        // The value of the last `len` lanes of bytes, which are digits.
+        template <typename V>
+        inline std::uint64_t digits_value(const V& bytes, size_t len)
+        {
+            auto mask = load_from<V>(digit_masks + 16 - V::size() + len);
+            auto digits = unroll(bytes, mask, [](std::uint8_t b, std::uint8_t m) {
+                return static_cast<std::uint8_t>((b - '0') & m);
+            });
+
+            auto pairs = fold_digits(digits, std::uint16_t { 10 });
+            auto quads = fold_digits(pairs, std::uint32_t { 100 });
+            auto octets = fold_digits(quads, std::uint64_t { 10000 });
+
+            if constexpr (V::size() == 8)
+                return octets[0];
+            else
+                return octets[0] * 100000000 + octets[1];
+        }
+
+        // Keeps the mask of non-digits of 64 bytes of text, so that finding
+        // the end of a number takes a shift and a count instead of a load and
+        // a compare that depend on the end of the previous number.
+        class digit_scanner {
+        public:
+            digit_scanner(const char* text, size_t size)
+                : text(text)
+                , size(size)
+            {
+            }
+
+            // The number of digits at pos. Runs are seen up to at least 32
+            // digits, longer ones may be cut short.
+            size_t run(size_t pos)
+            {
+                if (pos < base_ || pos - base_ > 32)
+                    refill(pos);
+
+                auto offset = pos - base_;
+                auto bits = nondigits_ >> offset;
+                return bits != 0 ? countr_zero(bits) : 64 - offset;
+            }
+
+            const char* const text;
+            const size_t size;
+
+        private:
+            void refill(size_t pos)
+            {
+                base_ = pos;
+                nondigits_ = ~digit_mask(load_bytes<vector<std::uint8_t, 64>>(text, size, pos));
+            }
+
+            size_t base_ = ~size_t { 0 };
+            std::uint64_t nondigits_ = 0;
+        };
+
+        // The value of the `len` digits that end at `end`, where len is at most
+        // VectorSize. Up to 8 digits are converted with 8 lanes.
+        template <size_t VectorSize>
+        inline std::uint64_t digits_before(const digit_scanner& scanner, size_t end, size_t len)
+        {
+            constexpr size_t Small = std::min<size_t>(VectorSize, 8);
+
+            auto load = [&](auto lanes) {
+                using ByteVec = vector<std::uint8_t, decltype(lanes)::value>;
+                return load_bytes<ByteVec>(scanner.text, scanner.size, static_cast<std::ptrdiff_t>(end) - decltype(lanes)::value);
+            };
+
+            if (len > Small)
+                return digits_value(load(size_constant<VectorSize> {}), len);
+            return digits_value(load(size_constant<Small> {}), len);
+        }
+
+        template <size_t VectorSize>
+        size_t parse_long_digits(digit_scanner& scanner, size_t pos, std::uint64_t& value, bool& overflow)
+        {
+            size_t total = 0;
+            for (;;) {
+                auto run = std::min(scanner.run(pos + total), VectorSize);
+                total += run;
+                if (run > 0) {
+                    overflow |= multiply_add_overflows(value, decimal_powers[run], digits_before<VectorSize>(scanner, pos + total, run));
+                }
+                if (run < VectorSize)
+                    return total;
+            }
+        }
+
+        // Parses the digits at pos into value and returns their number.
+        // `overflow` is set if value does not fit.
+        template <size_t VectorSize>
+        inline size_t parse_digits(digit_scanner& scanner, size_t pos, std::uint64_t& value, bool& overflow)
+        {
+            value = 0;
+            auto run = scanner.run(pos);
+            if (run > std::min<size_t>(2 * VectorSize, 19))
+                return parse_long_digits<VectorSize>(scanner, pos, value, overflow);
+
+            if (run > VectorSize) {
+                auto high = run - VectorSize;
+                value = digits_before<VectorSize>(scanner, pos + high, high) * decimal_powers[VectorSize]
+                    + digits_before<VectorSize>(scanner, pos + run, VectorSize);
+            } else if (run > 0) {
+                value = digits_before<VectorSize>(scanner, pos + run, run);
+            }
+            return run;
+        }
+
+        template <size_t VectorSize, typename T, typename F>
+        inline parse_result parse_fields(const char* first, const char* last, T* dst, size_t n, F parse)
+        {
+            static_assert(VectorSize == 8 || VectorSize == 16, "digits are converted 8 or 16 at a time");
+
+            digit_scanner scanner(first, static_cast<size_t>(last - first));
+
+            size_t pos = 0;
+            size_t count = 0;
+            while (count < n && pos < scanner.size) {
+                // A field that fails to parse may still have set value, so
+                // dst is only written on success.
+                T value {};
+                auto len = parse(scanner, pos, value);
+                if (len == 0)
+                    break;
+
+                dst[count++] = value;
+                pos += len;
+                pos += pos < scanner.size;
+            }
+
+            return { first + pos, count };
+        }
+
+        // Splits every lane into the quotient and the remainder of `divisor`.
+        template <size_t N>
+        vector<std::uint32_t, 2 * N> split_digits(const vector<std::uint32_t, N>& xs, std::uint32_t divisor)
+        {
+            vector<std::uint32_t, 2 * N> result {};
+            for (size_t i = 0; i < N; ++i) {
+                result[2 * i] = xs[i] / divisor;
+                result[2 * i + 1] = xs[i] % divisor;
+            }
+            return result;
+        }
+
+        // The number of decimal digits of x, from its bit width.
+        inline size_t decimal_length(std::uint64_t x)
+        {
+            x |= 1;
+            size_t guess = static_cast<size_t>(64 - countl_zero(x)) * 1233 >> 12;
+            return guess + 1 - (x < decimal_powers[guess]);
+        }
+
+        template <typename T>
+        constexpr bool is_negative(T x)
+        {
+            if constexpr (std::is_signed_v<T>)
+                return x < 0;
+            else
+                return false;
+        }
+
+        template <size_t VectorSize, typename T>
+        char* format_decimal(const T* src, size_t n, char* dst, char delimiter)
+        {
+            constexpr std::uint64_t low_digits = 10000000000000000ull;
+
+            alignas(64) char digits[VectorSize * 16 + 16] = {};
+
+            for (size_t i = 0; i < n; i += VectorSize) {
+                auto count = std::min(VectorSize, n - i);
+
+                std::uint64_t magnitudes[VectorSize] = {};
+                for (size_t k = 0; k < count; ++k)
+                    magnitudes[k] = is_negative(src[i + k]) ? 0 - static_cast<std::uint64_t>(src[i + k]) : static_cast<std::uint64_t>(src[i + k]);
+
+                vector<std::uint32_t, 2 * VectorSize> halves {};
+                for (size_t k = 0; k < VectorSize; ++k) {
+                    auto low = magnitudes[k] % low_digits;
+                    halves[2 * k] = static_cast<std::uint32_t>(low / 100000000);
+                    halves[2 * k + 1] = static_cast<std::uint32_t>(low % 100000000);
+                }
+
+                auto ones = split_digits(split_digits(split_digits(halves, 10000), 100), 10);
+                for (size_t k = 0; k < ones.size(); ++k)
+                    digits[k] = static_cast<char>('0' + ones[k]);
+
+                for (size_t k = 0; k < count; ++k) {
+                    if (is_negative(src[i + k]))
+                        *dst++ = '-';
+
+                    auto x = magnitudes[k];
+                    size_t len = 16;
+                    if (x >= low_digits)
+                        dst = std::to_chars(dst, dst + 4, x / low_digits).ptr;
+                    else
+                        len = decimal_length(x);
+
+                    std::memcpy(dst, digits + k * 16 + 16 - len, 16);
+                    dst += len;
+                    *dst++ = delimiter;
+                }
+            }
+
+            return dst;
+        }
+    } // namespace detail
+
+    template <size_t VectorSize>
+    parse_result parse_uint(const char* first, const char* last, std::uint64_t* dst, size_t n)
+    {
+        return detail::parse_fields<VectorSize>(first, last, dst, n, [](detail::digit_scanner& scanner, size_t pos, std::uint64_t& value) -> size_t {
+            bool overflow = false;
+            auto len = detail::parse_digits<VectorSize>(scanner, pos, value, overflow);
+            return overflow ? 0 : len;
+        });
+    }
+
+    // Accepts a leading '-', but not '+'.
+    template <size_t VectorSize>
+    parse_result parse_int(const char* first, const char* last, std::int64_t* dst, size_t n)
+    {
+        return detail::parse_fields<VectorSize>(first, last, dst, n, [](detail::digit_scanner& scanner, size_t pos, std::int64_t& value) -> size_t {
+            bool negative = scanner.text[pos] == '-';
+            bool overflow = false;
+
+            std::uint64_t magnitude;
+            auto len = detail::parse_digits<VectorSize>(scanner, pos + negative, magnitude, overflow);
+
+            auto limit = static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max()) + negative;
+            if (len == 0 || overflow || magnitude > limit)
+                return 0;
+
+            value = static_cast<std::int64_t>(negative ? 0 - magnitude : magnitude);
+            return len + negative;
+        });
+    }
+
+    // Accepts the format of std::from_chars with chars_format::general.
+    template <size_t VectorSize>
+    parse_result parse_double(const char* first, const char* last, double* dst, size_t n)
+    {
+        return detail::parse_fields<VectorSize>(first, last, dst, n, [](detail::digit_scanner& scanner, size_t pos, double& value) -> size_t {
+            constexpr double powers[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+            const auto* text = scanner.text;
+            const auto size = scanner.size;
+
+            auto p = pos;
+            bool negative = text[p] == '-';
+            p += negative;
+
+            std::uint64_t mantissa;
+            bool overflow = false;
+            auto digits = detail::parse_digits<VectorSize>(scanner, p, mantissa, overflow);
+            p += digits;
+
+            int exponent = 0;
+            if (p < size && text[p] == '.') {
+                std::uint64_t fraction_value;
+                auto fraction = detail::parse_digits<VectorSize>(scanner, p + 1, fraction_value, overflow);
+                p += 1 + fraction;
+                digits += fraction;
+                exponent -= static_cast<int>(fraction);
+
+                if (digits <= 19)
+                    mantissa = mantissa * detail::decimal_powers[fraction] + fraction_value;
+            }
+
+            bool exact = !overflow && digits > 0 && digits <= 19 && mantissa <= std::uint64_t { 1 } << 53;
+            if (exact && p < size && (text[p] == 'e' || text[p] == 'E')) {
+                auto q = p + 1;
+                bool negative_exponent = q < size && text[q] == '-';
+                q += q < size && (text[q] == '-' || text[q] == '+');
+
+                int explicit_exponent = 0;
+                auto start = q;
+                for (; q < size && q - start < 4 && static_cast<unsigned>(text[q] - '0') <= 9; ++q)
+                    explicit_exponent = explicit_exponent * 10 + (text[q] - '0');
+
+                exact = q > start && q - start < 4;
+                exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+                p = q;
+            }
+
+            if (exact && exponent >= -22 && exponent <= 22) {
+                auto x = static_cast<double>(mantissa);
+                x = exponent < 0 ? x / powers[-exponent] : x * powers[exponent];
+                value = negative ? -x : x;
+                return p - pos;
+            }
+
+            auto [ptr, ec] = std::from_chars(text + pos, text + size, value);
+            return ec == std::errc() ? static_cast<size_t>(ptr - (text + pos)) : 0;
+        });
+    }
+
+    // dst needs max_formatted_size(n) bytes. Returns one past the last delimiter.
+    template <size_t VectorSize>
+    char* format_uint(const std::uint64_t* src, size_t n, char* dst, char delimiter)
+    {
+        return detail::format_decimal<VectorSize>(src, n, dst, delimiter);
+    }
+
+    template <size_t VectorSize>
+    char* format_int(const std::int64_t* src, size_t n, char* dst, char delimiter)
+    {
+        return detail::format_decimal<VectorSize>(src, n, dst, delimiter);
+    }
+
+    // Algorithms: hashing and open-addressing hash tables.
+    //
+    // The hashers take 32-bit or 64-bit unsigned keys, either one at a time
+    // or a whole vector of them per call, so they can be passed to transform
+    // like any lane-wise function. multiply_shift is Fibonacci hashing: one
+    // multiplication whose high bits are good but whose low bits are not.
+    // murmur3_mix is the MurmurHash3 finalizer, and xxhash_mix is XXH32 or
+    // XXH64 of the key's little-endian bytes with seed 0.
+    //
+    // The tables are flat arrays of keys, divided into groups of VectorSize
+    // slots, with `empty` in the unused slots. A key starts at the group
+    // given by the top bits of its hash, which suit all three hashers, and
+    // moves on group by group until it is found or the group has an empty
+    // slot. Every step compares a whole group against the broadcast key.
+    // The batched lookups hash VectorSize keys at once and prefetch all of
+    // their groups before probing any of them, so that the cache misses of
+    // a large table overlap.
+    struct multiply_shift {
+        template <typename T>
+        constexpr T operator()(T key) const
+        {
+            if constexpr (is_vector<T>::value) {
+                return unroll(key, *this);
+            } else {
+                static_assert(std::is_unsigned_v<T> && (sizeof(T) == 4 || sizeof(T) == 8));
+                return static_cast<T>(key * (sizeof(T) == 4 ? 0x9e3779b9u : 0x9e3779b97f4a7c15ull));
+            }
+        }
+    };
+
+    struct murmur3_mix {
+        template <typename T>
+        constexpr T operator()(T key) const
+        {
+            if constexpr (is_vector<T>::value) {
+                return unroll(key, *this);
+            } else if constexpr (sizeof(T) == 4) {
+                static_assert(std::is_unsigned_v<T>);
+                key ^= key >> 16;
+                key *= 0x85ebca6bu;
+                key ^= key >> 13;
+                key *= 0xc2b2ae35u;
+                return key ^ key >> 16;
+            } else {
+                static_assert(std::is_unsigned_v<T> && sizeof(T) == 8);
+                key ^= key >> 33;
+                key *= 0xff51afd7ed558ccdull;
+                key ^= key >> 33;
+                key *= 0xc4ceb9fe1a85ec53ull;
+                return key ^ key >> 33;
+            }
+        }
+    };
+
+    struct xxhash_mix {
+        template <typename T>
+        constexpr T operator()(T key) const
+        {
+            if constexpr (is_vector<T>::value) {
+                return unroll(key, *this);
+            } else if constexpr (sizeof(T) == 4) {
+                static_assert(std::is_unsigned_v<T>);
+                T h = 0x165667b1u + 4 + key * 0xc2b2ae3du;
+                h = (h << 17 | h >> 15) * 0x27d4eb2fu;
+                h ^= h >> 15;
+                h *= 0x85ebca77u;
+                h ^= h >> 13;
+                h *= 0xc2b2ae3du;
+                return h ^ h >> 16;
+            } else {
+                static_assert(std::is_unsigned_v<T> && sizeof(T) == 8);
+                T k = key * 0xc2b2ae3d27d4eb4full;
+                k = (k << 31 | k >> 33) * 0x9e3779b185ebca87ull;
+                T h = (0x27d4eb2f165667c5ull + 8) ^ k;
+                h = (h << 27 | h >> 37) * 0x9e3779b185ebca87ull + 0x85ebca77c2b2ae63ull;
+                h ^= h >> 33;
+                h *= 0xc2b2ae3d27d4eb4full;
+                h ^= h >> 29;
+                h *= 0x165667b19e3779f9ull;
+                return h ^ h >> 32;
+            }
+        }
+    };
+
+    // out[i] = hash(keys[i])
+    template <size_t VectorSize, typename Hash = murmur3_mix, typename T>
+    void hash_batch(const T* keys, size_t n, T* out, Hash hash = {})
+    {
+        transform<VectorSize>(keys, n, out, hash);
+    }
+
+    // The mask of the VectorSize slots of `group` that hold `key`.
+    template <size_t VectorSize, typename T>
+    inline std::uint64_t match_group(const T* group, T key)
+    {
+        using KeyVec = vector<T, VectorSize>;
+
+        return detail::bitmask(load_from<KeyVec>(group) == scalar<KeyVec>(key));
+    }
+
+    namespace detail {
+        template <size_t VectorSize, typename T>
+        struct hash_table_shape {
+            explicit hash_table_shape(size_t capacity)
+                : groups(capacity / VectorSize)
+            {
+                if (capacity % VectorSize != 0 || groups == 0 || (groups & (groups - 1)) != 0)
+                    throw std::invalid_argument("hash table capacity must be a power of two times VectorSize");
+
+                while ((size_t { 1 } << bits) < groups)
+                    ++bits;
+            }
+
+            // The group whose slots a key with this hash tries first.
+            size_t home(T hash) const
+            {
+                return bits == 0 ? 0 : static_cast<size_t>(hash >> (8 * sizeof(T) - bits));
+            }
+
+            size_t groups;
+            unsigned bits = 0;
+        };
+
+        // Calls `func(i, home)` for every key in order, with the groups of
+        // each block of VectorSize keys prefetched before the first call.
+        template <size_t VectorSize, typename T, typename Hash, typename F>
+        inline void for_each_home(const hash_table_shape<VectorSize, T>& shape, const T* table, const T* keys, size_t n, Hash hash, F func)
+        {
+            using KeyVec = vector<T, VectorSize>;
+
+            size_t homes[VectorSize];
+            for (size_t i = 0; i < n; i += VectorSize) {
+                auto count = std::min(VectorSize, n - i);
+
+                KeyVec block {};
+                std::copy(keys + i, keys + i + count, block.data);
+
+                auto hashes = hash(block);
+                for (size_t k = 0; k < VectorSize; ++k)
+                    homes[k] = shape.home(hashes[k]);
+
+                // Only the homes of real keys are prefetched, not those of the
+                // padding in a partial block. The constant trip count lets gcc
+                // unroll the loop; stopping at count was slower.
+#if defined(__GNUC__)
+                for (size_t k = 0; k < VectorSize; ++k)
+                    if (k < count)
+                        __builtin_prefetch(table + homes[k] * VectorSize);
+#endif
+
+                for (size_t k = 0; k < count; ++k)
+                    func(i + k, homes[k]);
+            }
+        }
+    } // namespace detail
+
+    // Inserts the keys into the table, which holds `capacity` slots, and
+    // writes the slot of each key. A key that is already in the table keeps
+    // its slot. `capacity` must be a power of two times VectorSize, and no
+    // key may equal `empty`. Throws std::length_error when the table is full.
+    template <size_t VectorSize, typename Hash = murmur3_mix, typename T>
+    void hash_table_insert(T* table, size_t capacity, T empty, const T* keys, size_t n, size_t* slots, Hash hash = {})
+    {
+        const detail::hash_table_shape<VectorSize, T> shape(capacity);
+
+        detail::for_each_home(shape, table, keys, n, hash, [&](size_t i, size_t group) {
+            const T key = keys[i];
+            if (key == empty)
+                throw std::invalid_argument("a hash table key equals the empty key");
+
+            for (size_t step = 0; step < shape.groups; ++step, group = (group + 1) & (shape.groups - 1)) {
+                auto* slot = table + group * VectorSize;
+
+                if (auto found = match_group<VectorSize>(slot, key)) {
+                    slots[i] = group * VectorSize + detail::countr_zero(found);
+                    return;
+                }
+
+                if (auto free = match_group<VectorSize>(slot, empty)) {
+                    auto index = detail::countr_zero(free);
+                    slot[index] = key;
+                    slots[i] = group * VectorSize + index;
+                    return;
+                }
+            }
+
+            throw std::length_error("hash table is full");
+        });
+    }
+
+    // Writes the slot of each key, or `capacity` for the keys that are not
+    // in the table.
+    template <size_t VectorSize, typename Hash = murmur3_mix, typename T>
+    void hash_table_find(const T* table, size_t capacity, T empty, const T* keys, size_t n, size_t* slots, Hash hash = {})
+    {
+        const detail::hash_table_shape<VectorSize, T> shape(capacity);
+
+        detail::for_each_home(shape, table, keys, n, hash, [&](size_t i, size_t group) {
+            slots[i] = capacity;
+
+            for (size_t step = 0; step < shape.groups; ++step, group = (group + 1) & (shape.groups - 1)) {
+                auto* slot = table + group * VectorSize;
+
+                if (auto found = match_group<VectorSize>(slot, keys[i])) {
+                    slots[i] = group * VectorSize + detail::countr_zero(found);
+                    return;
+                }
+
+                if (match_group<VectorSize>(slot, empty) != 0)
+                    return;
+            }
+        });
+    }
+
+    // Algorithms: batched lower_bound and the Eytzinger layout.
+    //
+    // lower_bound_batch answers VectorSize queries at once. All of them take
+    // the same number of halving steps, and each step is a compare and a
+    // conditional add per lane, so there is no branch to mispredict and the
+    // VectorSize loads of a step are in flight together.
+    //
+    // The lanes are plain arrays, not vectors, and the kernels compile to
+    // VectorSize interleaved scalar cmp/cmov chains. gcc 12 emits no gathers
+    // outside the loop vectorizer, so vector lanes load one element at a time
+    // as well; vectorizing only the compare and add made the search 20-35%
+    // slower.
+    //
+    // The Eytzinger layout stores a sorted array as a complete binary search
+    // tree in breadth-first order: tree[1] is the root, and the children of
+    // tree[k] are tree[2k] and tree[2k + 1]. The tree is padded to a power of
+    // two with the largest value of T, so every query descends exactly
+    // log2(size) levels, and the path it takes is its lower_bound. The first
+    // levels are shared by all queries and stay in cache, and the 16
+    // descendants four levels down are adjacent, so they are prefetched with
+    // one or two cache lines.
+    namespace detail {
+        // The lower_bound of every key, or of the first `count`.
+        template <size_t VectorSize, typename T>
+        inline void lower_bound_block(const T* sorted, size_t n, const T* keys, size_t count, size_t* out)
+        {
+            size_t base[VectorSize] = {};
+
+            for (size_t len = n; len > 1;) {
+                auto half = len / 2;
+                for (size_t k = 0; k < VectorSize; ++k)
+                    base[k] += sorted[base[k] + half] < keys[k] ? half : 0;
+                len -= half;
+            }
+
+            for (size_t k = 0; k < count; ++k)
+                out[k] = base[k] + (sorted[base[k]] < keys[k]);
+        }
+
+        template <typename T>
+        size_t eytzinger_fill(const T* sorted, size_t n, T* tree, size_t size, size_t k, size_t next)
+        {
+            if (k >= size)
+                return next;
+
+            next = eytzinger_fill(sorted, n, tree, size, 2 * k, next);
+            tree[k] = next < n ? sorted[next] : std::numeric_limits<T>::max();
+            return eytzinger_fill(sorted, n, tree, size, 2 * k + 1, next + 1);
+        }
+
+        template <size_t VectorSize, typename T>
+        inline void eytzinger_block(const T* tree, size_t n, size_t size, const T* keys, size_t count, size_t* out)
+        {
+            size_t node[VectorSize];
+            std::fill(node, node + VectorSize, 1);
+
+            for (size_t level = 1; level < size; level *= 2) {
+#if defined(__GNUC__)
+                if (32 * level <= size) {
+                    for (size_t k = 0; k < VectorSize; ++k) {
+                        for (size_t line = 0; line < 16 * sizeof(T); line += 64)
+                            __builtin_prefetch(reinterpret_cast<const char*>(tree + 16 * node[k]) + line);
+                    }
+                }
+#endif
+                for (size_t k = 0; k < VectorSize; ++k)
+                    node[k] = 2 * node[k] + (tree[node[k]] < keys[k]);
+            }
+
+            for (size_t k = 0; k < count; ++k)
+                out[k] = std::min(node[k] - size, n);
+        }
+
+        // Calls `func(keys, count, out)` for every block of VectorSize
+        // queries. The lanes past the last query repeat it.
+        template <size_t VectorSize, typename T, typename F>
+        inline void for_each_query_block(const T* queries, size_t m, size_t* out, F func)
+        {
+            for (size_t i = 0; i < m; i += VectorSize) {
+                auto count = std::min(VectorSize, m - i);
+
+                T keys[VectorSize];
+                std::copy(queries + i, queries + i + count, keys);
+                std::fill(keys + count, keys + VectorSize, queries[i]);
+
+                func(keys, count, out + i);
+            }
+        }
+    } // namespace detail
+
+    // out[i] = std::lower_bound(sorted, sorted + n, queries[i]) - sorted
+    template <size_t VectorSize, typename T>
+    void lower_bound_batch(const T* sorted, size_t n, const T* queries, size_t m, size_t* out)
+    {
+        if (n == 0) {
+            std::fill(out, out + m, 0);
+            return;
+        }
+
+        detail::for_each_query_block<VectorSize>(queries, m, out, [&](const T* keys, size_t count, size_t* block_out) {
+            detail::lower_bound_block<VectorSize>(sorted, n, keys, count, block_out);
+        });
+    }
+
+    // The number of elements of the Eytzinger layout of n values, the
+    // smallest power of two above n. Element 0 is unused.
+    constexpr size_t eytzinger_size(size_t n)
+    {
+        size_t size = 1;
+        while (size <= n)
+            size *= 2;
+        return size;
+    }
+
+    // Writes the Eytzinger layout of the n sorted values to tree, which
+    // holds eytzinger_size(n) elements. Align tree to 64 bytes for the
+    // prefetches of eytzinger_lower_bound_batch to cover whole lines.
+    template <typename T>
+    void eytzinger_layout(const T* sorted, size_t n, T* tree)
+    {
+        const auto size = eytzinger_size(n);
+        tree[0] = std::numeric_limits<T>::max();
+        detail::eytzinger_fill(sorted, n, tree, size, 1, 0);
+    }
+
+    // Like lower_bound_batch over the sorted values that tree was built
+    // from, with the results as positions in those values.
+    template <size_t VectorSize, typename T>
+    void eytzinger_lower_bound_batch(const T* tree, size_t n, const T* queries, size_t m, size_t* out)
+    {
+        const auto size = eytzinger_size(n);
+
+        detail::for_each_query_block<VectorSize>(queries, m, out, [&](const T* keys, size_t count, size_t* block_out) {
+            detail::eytzinger_block<VectorSize>(tree, n, size, keys, count, block_out);
+        });
+    }
+
+    // Algorithms: quantized dot products and matrix-vector products.
+    //
+    // quantized_dot and quantized_gemv multiply int8 or uint8 values exactly,
+    // with int8 x int8 and uint8 x int8 operands in either order. The loops
+    // are plain int32 sums of widened products, which compilers turn into
+    // widening multiply-adds: vpdpbusd with AVX-512 VNNI, pmaddwd otherwise.
+    // Those multiply uint8 by int8, so an int8 x int8 product is computed as
+    // (a + 128) * b - 128 * b. Every int32 sum covers at most
+    // quantized_block columns, which cannot overflow, and is then added to
+    // an int64 total. quantized_gemv works on four rows at a time, so every
+    // load of x serves four rows.
+    namespace detail {
+        // 32768 * 255 * 128 < 2^31
+        constexpr size_t quantized_block = 32768;
+
+        template <typename A, typename B>
+        constexpr bool quantized_offset = std::is_signed_v<A> && std::is_signed_v<B>;
+
+        // The first operand of a product, offset by 128 when both are int8.
+        template <typename B, typename A>
+        inline std::int32_t quantized_operand(A x)
+        {
+            static_assert(sizeof(A) == 1 && sizeof(B) == 1, "quantized operands are int8 or uint8");
+            static_assert(std::is_signed_v<A> || std::is_signed_v<B>, "one quantized operand must be int8");
+
+            if constexpr (quantized_offset<A, B>)
+                return static_cast<std::uint8_t>(static_cast<std::uint8_t>(x) ^ 0x80);
+            else
+                return x;
+        }
+
+        // sums[r] += the product of row r of a and b, without the offset.
+        template <size_t Rows, typename A, typename B>
+        inline void quantized_rows(const A* a, size_t stride, const B* b, size_t n, std::int64_t* sums)
+        {
+            for (size_t i = 0; i < n; i += quantized_block) {
+                auto end = std::min(i + quantized_block, n);
+
+                std::int32_t partial[Rows] = {};
+                for (size_t c = i; c < end; ++c) {
+                    std::int32_t y = b[c];
+                    for (size_t r = 0; r < Rows; ++r)
+                        partial[r] += quantized_operand<B>(a[r * stride + c]) * y;
+                }
+
+                for (size_t r = 0; r < Rows; ++r)
+                    sums[r] += partial[r];
+            }
+        }
+
+        template <typename T>
+        std::int64_t quantized_sum(const T* xs, size_t n)
+        {
+            std::int64_t total = 0;
+            for (size_t i = 0; i < n; i += quantized_block) {
+                auto end = std::min(i + quantized_block, n);
+
+                std::int32_t partial = 0;
+                for (size_t c = i; c < end; ++c)
+                    partial += xs[c];
+                total += partial;
+            }
+            return total;
+        }
+    } // namespace detail
+
+    // The sum of a[i] * b[i].
+    template <typename A, typename B>
+    std::int64_t quantized_dot(const A* a, const B* b, size_t n)
+    {
+        if constexpr (detail::quantized_offset<A, B>) {
+            // Summing b in the same loop is cheaper than a second pass.
+            std::int64_t total = 0;
+            for (size_t i = 0; i < n; i += detail::quantized_block) {
+                auto end = std::min(i + detail::quantized_block, n);
+
+                std::int32_t products = 0;
+                std::int32_t offsets = 0;
+                for (size_t c = i; c < end; ++c) {
+                    products += detail::quantized_operand<B>(a[c]) * b[c];
+                    offsets += b[c];
+                }
+                total += products - std::int64_t { 128 } * offsets;
+            }
+            return total;
+        } else {
+            std::int64_t total = 0;
+            detail::quantized_rows<1>(a, 0, b, n, &total);
+            return total;
+        }
+    }
+
+    // out[r] = scales[r] * quantized_dot(matrix + r * cols, x, cols), where
+    // the matrix is stored by rows.
+    template <typename A, typename B>
+    void quantized_gemv(const A* matrix, size_t rows, size_t cols, const B* x, const float* scales, float* out)
+    {
+        const std::int64_t offset = detail::quantized_offset<A, B> ? 128 * detail::quantized_sum(x, cols) : 0;
+
+        size_t r = 0;
+        for (; r + 4 <= rows; r += 4) {
+            std::int64_t sums[4] = {};
+            detail::quantized_rows<4>(matrix + r * cols, cols, x, cols, sums);
+
+            for (size_t k = 0; k < 4; ++k)
+                out[r + k] = scales[r + k] * static_cast<float>(sums[k] - offset);
+        }
+
+        for (; r < rows; ++r) {
+            std::int64_t sum = 0;
+            detail::quantized_rows<1>(matrix + r * cols, cols, x, cols, &sum);
+            out[r] = scales[r] * static_cast<float>(sum - offset);
+        }
+    }
+
+    // Algorithms: argmin, argmax, and minmax_element.
+    //
+    // Values are compared by keys: unsigned integers of the same width in
+    // the same order, with the bits of negative floats flipped. Every lane
+    // keeps its best key and the position it was found at, packed into one
+    // 64-bit word with the key above the position, so a single unsigned min
+    // per lane updates both, and equal keys keep the lower position. The
+    // lanes are then folded with the same min, which picks the first best
+    // element overall, as std::min_element and std::max_element do. Largest
+    // elements are found with complemented keys. Positions take 32 bits, so
+    // longer inputs are reduced in runs of 2^32 elements. 64-bit values
+    // leave no room for the position: their lanes keep the best key only,
+    // and a second pass finds its first occurrence.
+    //
+    // Floats are ordered like IEEE 754 totalOrder, so -0.0 is smaller than
+    // 0.0 and NaNs are smaller or larger than every number, by their sign.
+    // The thread-parallel versions reduce `threads` slices concurrently and
+    // keep the first of equal results.
+    namespace detail {
+        template <typename T>
+        using ordered_key_t = std::conditional_t<sizeof(T) == 8, std::uint64_t,
+            std::conditional_t<sizeof(T) == 4, std::uint32_t, std::conditional_t<sizeof(T) == 2, std::uint16_t, std::uint8_t>>>;
+
+        // The complement of the ordered key when looking for the largest.
+        template <bool Largest, typename T>
+        inline ordered_key_t<T> ordered_key(T x)
+        {
+            static_assert(std::is_arithmetic_v<T>, "extremes are found among integers and floats");
+
+            using Key = ordered_key_t<T>;
+            constexpr Key sign = Key { 1 } << (8 * sizeof(T) - 1);
+
+            Key key;
+            if constexpr (std::is_floating_point_v<T>) {
+                std::memcpy(&key, &x, sizeof(key));
+                key = static_cast<Key>(key ^ ((key & sign) != 0 ? static_cast<Key>(~Key {}) : sign));
+            } else if constexpr (std::is_signed_v<T>) {
+                key = static_cast<Key>(static_cast<Key>(x) ^ sign);
+            } else {
+                key = x;
+            }
+
+            return Largest ? static_cast<Key>(~key) : key;
+        }
+
+        // The lanes of the packed keys and positions of one kind of extreme.
+        template <size_t VectorSize, bool Largest, typename T>
+        struct extreme_lanes {
+            using Lanes = vector<std::uint64_t, VectorSize>;
+
+            static constexpr bool packed = sizeof(T) <= 4;
+
+            inline void update(const T* block, std::uint32_t offset)
+            {
+                for (size_t k = 0; k < VectorSize; ++k)
+                    lanes[k] = std::min(lanes[k], word(block[k], static_cast<std::uint32_t>(offset + k)));
+            }
+
+            static inline std::uint64_t word(T x, std::uint32_t offset)
+            {
+                std::uint64_t key = ordered_key<Largest>(x);
+                return packed ? key << 32 | offset : key;
+            }
+
+            std::uint64_t reduce() const
+            {
+                auto best = lanes[0];
+                for (size_t k = 1; k < VectorSize; ++k)
+                    best = std::min(best, lanes[k]);
+                return best;
+            }
+
+            Lanes lanes = scalar<Lanes>(~std::uint64_t {});
+        };
+
+        // The first positions of the smallest and the largest element of
+        // src[0, n), as far as they are wanted. Positions are 0 when n is 0.
+        template <size_t VectorSize, bool Smallest, bool Largest, typename T>
+        std::pair<size_t, size_t> extremes(const T* src, size_t n)
+        {
+            constexpr bool packed = sizeof(T) <= 4;
+            constexpr size_t run_size = packed ? size_t { 1 } << 32 : std::numeric_limits<size_t>::max();
+
+            size_t positions[2] = {};
+            std::uint64_t keys[2] = {};
+
+            // Runs come in order, so a later one only wins with a better key.
+            auto merge = [&](size_t which, std::uint64_t word, size_t begin) {
+                if constexpr (packed) {
+                    if (begin == 0 || (word >> 32) < keys[which]) {
+                        keys[which] = word >> 32;
+                        positions[which] = begin + (word & 0xffffffff);
+                    }
+                } else {
+                    keys[which] = word;
+                }
+            };
+
+            for (size_t begin = 0; begin < n; begin += run_size) {
+                const auto size = std::min(n - begin, run_size);
+                const auto whole = size / VectorSize * VectorSize;
+                const auto* run = src + begin;
+
+                extreme_lanes<VectorSize, false, T> lows;
+                extreme_lanes<VectorSize, true, T> highs;
+
+                for (size_t i = 0; i < whole; i += VectorSize) {
+                    if constexpr (Smallest)
+                        lows.update(run + i, static_cast<std::uint32_t>(i));
+                    if constexpr (Largest)
+                        highs.update(run + i, static_cast<std::uint32_t>(i));
+                }
+
+                for (size_t i = whole; i < size; ++i) {
+                    if constexpr (Smallest)
+                        lows.lanes[0] = std::min(lows.lanes[0], lows.word(run[i], static_cast<std::uint32_t>(i)));
+                    if constexpr (Largest)
+                        highs.lanes[0] = std::min(highs.lanes[0], highs.word(run[i], static_cast<std::uint32_t>(i)));
+                }
+
+                if constexpr (Smallest)
+                    merge(0, lows.reduce(), begin);
+                if constexpr (Largest)
+                    merge(1, highs.reduce(), begin);
+            }
+
+            if constexpr (!packed) {
+                if (n > 0 && Smallest)
+                    positions[0] = find_if<VectorSize>(src, n, [key = keys[0]](T x) { return ordered_key<false>(x) == key; });
+                if (n > 0 && Largest)
+                    positions[1] = find_if<VectorSize>(src, n, [key = keys[1]](T x) { return ordered_key<true>(x) == key; });
+            }
+
+            return { positions[0], positions[1] };
+        }
+
+        // Like extremes, with `threads` slices reduced concurrently.
+        template <size_t VectorSize, bool Smallest, bool Largest, typename T>
+        std::pair<size_t, size_t> extremes(const T* src, size_t n, size_t threads)
+        {
+            threads = thread_count<VectorSize>(n, threads);
+            if (threads == 1)
+                return extremes<VectorSize, Smallest, Largest>(src, n);
+
+            // The positions of every slice, counted from the start of src.
+            std::vector<std::pair<size_t, size_t>> partials(threads);
+            parallel_slices<VectorSize>(n, threads, [&](size_t t, size_t begin, size_t size) {
+                auto [low, high] = extremes<VectorSize, Smallest, Largest>(src + begin, size);
+                partials[t] = { begin + low, begin + high };
+            });
+
+            auto [low, high] = partials[0];
+            for (size_t t = 1; t < threads; ++t) {
+                if (ordered_key<false>(src[partials[t].first]) < ordered_key<false>(src[low]))
+                    low = partials[t].first;
+                if (ordered_key<true>(src[partials[t].second]) < ordered_key<true>(src[high]))
+                    high = partials[t].second;
+            }
+
+            return { low, high };
+        }
+    } // namespace detail
+
+    // The position of the first smallest element, or 0 when n is 0.
+    template <size_t VectorSize, typename T>
+    size_t argmin(const T* src, size_t n)
+    {
+        return detail::extremes<VectorSize, true, false>(src, n).first;
+    }
+
+    // The position of the first largest element, or 0 when n is 0.
+    template <size_t VectorSize, typename T>
+    size_t argmax(const T* src, size_t n)
+    {
+        return detail::extremes<VectorSize, false, true>(src, n).second;
+    }
+
+    // The positions of the first smallest and the first largest element,
+    // found in one pass. Unlike std::minmax_element, the largest is the
+    // first one too.
+    template <size_t VectorSize, typename T>
+    std::pair<size_t, size_t> minmax_element(const T* src, size_t n)
+    {
+        return detail::extremes<VectorSize, true, true>(src, n);
+    }
+
+    template <size_t VectorSize, typename T>
+    size_t argmin(const T* src, size_t n, size_t threads)
+    {
+        return detail::extremes<VectorSize, true, false>(src, n, threads).first;
+    }
+
+    template <size_t VectorSize, typename T>
+    size_t argmax(const T* src, size_t n, size_t threads)
+    {
+        return detail::extremes<VectorSize, false, true>(src, n, threads).second;
+    }
+
+    template <size_t VectorSize, typename T>
+    std::pair<size_t, size_t> minmax_element(const T* src, size_t n, size_t threads)
+    {
+        return detail::extremes<VectorSize, true, true>(src, n, threads);
+    }
+
+    // Algorithms: polynomials, table interpolation, and calibration curves.
+    //
+    // Coefficients are given lowest power first and are converted to the
+    // type of x. horner takes one multiply-add per coefficient in a single
+    // dependency chain. estrin adds pairs of terms and squares x at every
+    // level, so its chain is only log2 of the degree deep, at the price of a
+    // few more multiplies and slightly different rounding. When many
+    // independent values are evaluated, the chains already overlap and
+    // horner is as fast. Vectors are evaluated lane by lane, which the
+    // compiler turns into vector instructions.
+    //
+    // lut_interpolate reads a table of samples at evenly spaced points from
+    // low to high. Inputs outside [low, high] are clamped to it, and NaNs
+    // read as low. Cubic interpolation passes through the samples with
+    // Catmull-Rom tangents, repeating the end samples at the borders. Table
+    // lookups are evaluated in a loop over the lanes rather than unrolled,
+    // because gcc only vectorizes them into gathers in loops.
+    namespace detail {
+        template <typename V, typename F>
+        inline auto lane_loop(V xs, F func)
+        {
+            typename V::template with_value_t<decltype(func(xs[0]))> results;
+            for (size_t k = 0; k < V::size(); ++k)
+                results[k] = func(xs[k]);
+            return results;
+        }
+
+        template <typename T, typename C>
+        constexpr T horner_scalar(T, C c)
+        {
+            return static_cast<T>(c);
+        }
+
+        template <typename T, typename C, typename... Cs>
+        constexpr T horner_scalar(T x, C c, Cs... cs)
+        {
+            return horner_scalar(x, cs...) * x + static_cast<T>(c);
+        }
+
+        // Adds neighbouring terms into the coefficients of a polynomial in
+        // x^2 until one is left.
+        template <typename T, size_t N>
+        constexpr T estrin_scalar(T x, const std::array<T, N>& cs)
+        {
+            if constexpr (N == 1) {
+                return cs[0];
+            } else {
+                std::array<T, (N + 1) / 2> pairs {};
+                for (size_t i = 0; i < N / 2; ++i)
+                    pairs[i] = cs[2 * i + 1] * x + cs[2 * i];
+                if constexpr (N % 2 == 1)
+                    pairs[N / 2] = cs[N - 1];
+                return estrin_scalar(x * x, pairs);
+            }
+        }
+
+    } // namespace detail
+
+    // c0 + c1 x + c2 x^2 + ... for a number or a vector x.
+    template <typename X, typename... Cs>
+    constexpr X horner(X x, Cs... cs)
+    {
+        static_assert(sizeof...(Cs) > 0, "a polynomial has at least one coefficient");
+
+        if constexpr (is_vector<X>::value)
+            return unroll(x, [=](auto a) { return detail::horner_scalar(a, cs...); });
+        else
+            return detail::horner_scalar(x, cs...);
+    }
+
+    // The same polynomial as horner, by Estrin's scheme.
+    template <typename X, typename... Cs>
+    constexpr X estrin(X x, Cs... cs)
+    {
+        static_assert(sizeof...(Cs) > 0, "a polynomial has at least one coefficient");
+
+        if constexpr (is_vector<X>::value) {
+            return unroll(x, [=](auto a) { return estrin(a, cs...); });
+        } else {
+            return detail::estrin_scalar(x, std::array<X, sizeof...(Cs)> { static_cast<X>(cs)... });
+        }
+    }
+
+    enum class interpolation { linear, cubic };
+
+    namespace detail {
+        template <typename T>
+        using table_index_t = std::make_signed_t<bits_of_t<T>>;
+
+        // The position of x in units of `steps` equal steps from low to
+        // high, clamped to [0, last]; NaNs give 0.
+        template <typename T>
+        inline T clamped_steps(T x, T low, T high, size_t steps, size_t last)
+        {
+            T t = (x - low) * (static_cast<T>(steps) / (high - low));
+            t = t > 0 ? t : 0;
+            return t < static_cast<T>(last) ? t : static_cast<T>(last);
+        }
+
+        template <interpolation Mode, typename T>
+        inline T lut_interpolate_scalar(const T* table, size_t size, T low, T high, T x)
+        {
+            using Index = table_index_t<T>;
+
+            const auto last = static_cast<Index>(size - 1);
+            T t = clamped_steps(x, low, high, size - 1, size - 1);
+            Index i = std::min(static_cast<Index>(t), last - 1);
+            T f = t - static_cast<T>(i);
+
+            T p1 = table[i];
+            T p2 = table[i + 1];
+            if constexpr (Mode == interpolation::linear) {
+                return p1 + f * (p2 - p1);
+            } else {
+                T p0 = table[std::max<Index>(i - 1, 0)];
+                T p3 = table[std::min<Index>(i + 2, last)];
+                return horner(f, p1, T(0.5) * (p2 - p0), p0 - T(2.5) * p1 + T(2) * p2 - T(0.5) * p3,
+                    T(0.5) * (p3 - p0) + T(1.5) * (p1 - p2));
+            }
+        }
+
+        template <typename T, size_t... Is>
+        constexpr T horner_at(T x, const T* cs, std::index_sequence<Is...>)
+        {
+            return horner(x, cs[Is]...);
+        }
+
+    } // namespace detail
+
+    // The table value at x for a number or a vector x. table holds `size`
+    // samples, at least two, from low to high.
+    template <interpolation Mode = interpolation::linear, typename X, typename T>
+    X lut_interpolate(const T* table, size_t size, T low, T high, X x)
+    {
+        if constexpr (is_vector<X>::value)
+            return detail::lane_loop(x, [=](T a) { return detail::lut_interpolate_scalar<Mode>(table, size, low, high, a); });
+        else
+            return detail::lut_interpolate_scalar<Mode>(table, size, low, high, x);
+    }
+
+    // A curve made of `segments` polynomials of degree Degree over equal
+    // parts of [low, high]. coefficients holds Degree + 1 coefficients per
+    // segment, lowest power first, of a polynomial in the position within
+    // the segment, from 0 at its start to 1 at its end. Inputs before low
+    // or after high continue the first or the last polynomial.
+    template <size_t Degree, typename T>
+    struct piecewise_polynomial {
+        template <typename X>
+        X operator()(X x) const
+        {
+            if constexpr (is_vector<X>::value) {
+                return detail::lane_loop(x, [curve = *this](T a) { return curve(a); });
+            } else {
+                using Index = detail::table_index_t<T>;
+
+                T t = (x - low) * (static_cast<T>(segments) / (high - low));
+                auto i = static_cast<Index>(detail::clamped_steps(x, low, high, segments, segments - 1));
+                return detail::horner_at(t - static_cast<T>(i), coefficients + i * (Degree + 1), std::make_index_sequence<Degree + 1> {});
+            }
+        }
+
+        const T* coefficients;
+        size_t segments;
+        T low;
+        T high;
+    };
+
+    // dst[i] = curve(src[i]) with src converted to T first. curve takes
+    // vectors of T when it can, like a piecewise_polynomial or a generic
+    // lambda calling lut_interpolate or horner, and numbers of T otherwise.
+    template <size_t VectorSize, typename S, typename T, typename Curve>
+    void calibrate(const S* src, size_t n, T* dst, Curve curve)
+    {
+        using Source = vector<compute_type_t<S>, VectorSize>;
+        using Target = vector<T, VectorSize>;
+
+        auto rem = n % VectorSize;
+        auto loops = n / VectorSize;
+
+        for (size_t i = 0; i < loops; ++i, src += VectorSize, dst += VectorSize) {
+            auto xs = cast_to<T>(load_from<Source>(src));
+            if constexpr (std::is_invocable_v<Curve, Target>)
+                store_to(curve(xs), dst);
+            else
+                store_to(detail::lane_loop(xs, curve), dst);
+        }
+
+        for (size_t i = 0; i < rem; ++i)
+            dst[i] = curve(static_cast<T>(src[i]));
+    }
+
+    // Like calibrate, with `threads` slices calibrated concurrently.
+    template <size_t VectorSize, typename S, typename T, typename Curve>
+    void calibrate(const S* src, size_t n, T* dst, Curve curve, size_t threads)
+    {
+        detail::parallel_slices<VectorSize>(n, threads, [&](size_t, size_t begin, size_t size) {
+            calibrate<VectorSize>(src + begin, size, dst + begin, curve);
+        });
+    }
+
+    // Algorithms: byteswap_copy.
+    //
+    // Converts big-endian records, as read from the network or from files,
+    // to the byte order of a little-endian host, or back. The swaps are
+    // byte shuffles within each vector, so long arrays run at the speed of a
+    // copy.
+    //
+    // dst[i] = byteswap(src[i]); src and dst may be the same array.
+    template <size_t VectorSize, typename T>
+    void byteswap_copy(const T* src, size_t n, T* dst)
+    {
+        static_assert(std::is_integral_v<T>, "byteswap_copy takes integers");
+
+        transform<VectorSize>(src, n, dst, [](T x) { return detail::byteswap_lane(x); });
+    }
+
+    // Algorithms: adler32, fletcher64, and crc32c.
+    //
+    // adler32 and fletcher64 keep their running sums in vector lanes: every
+    // lane adds its own values, widened to 32 or 64 bits, and the prefix sums
+    // of those sums. At the end of a block the lanes are combined, weighting
+    // each by its position, and reduced by the modulus. The blocks are as
+    // long as the lanes can go without overflowing. fletcher64 sums 32-bit
+    // words modulo 2^32 - 1 and returns sum2 << 32 | sum1; split a stream
+    // only at whole words to continue its checksum.
+    //
+    // crc32c is the Castagnoli CRC of iSCSI, ext4 and RocksDB. With SSE 4.2
+    // or the ARMv8 CRC extension, it runs the crc32 instruction on three
+    // streams at once, which hides its latency, and joins their crcs by
+    // shifting the first two over the bytes that follow them with tables.
+    // Otherwise it reads 8 bytes at a time with slice-by-8 tables. All three
+    // take the checksum of the preceding data, so streams can be checked in
+    // pieces.
+    namespace detail {
+        // Adds `vectors` vectors of values from src to the sums a and b,
+        // which are reduced modulo Mod.
+        template <size_t VectorSize, typename Lane, std::uint64_t Mod, typename S>
+        void fletcher_block(const S* src, size_t vectors, std::uint64_t& a, std::uint64_t& b)
+        {
+            using Vec = vector<Lane, VectorSize>;
+
+            Vec sums {};
+            Vec prefix_sums {};
+            for (size_t i = 0; i < vectors; ++i, src += VectorSize) {
+                // Unrolled, the lanes are left to the slp vectorizer, which
+                // misses the widening loads and the loop-carried sums.
+                PURE_SIMD_NO_UNROLL
+                for (size_t k = 0; k < VectorSize; ++k) {
+                    sums[k] += src[k];
+                    prefix_sums[k] += sums[k];
+                }
+            }
+
+            // Value k of vector i adds (vectors - i) * VectorSize - k times
+            // to b; the prefix sums count it vectors - i times.
+            std::uint64_t sum = 0;
+            std::uint64_t prefix_sum = 0;
+            std::uint64_t weighted_sum = 0;
+            for (size_t k = 0; k < VectorSize; ++k) {
+                sum += sums[k] % Mod;
+                prefix_sum += prefix_sums[k] % Mod;
+                weighted_sum += k * (sums[k] % Mod);
+            }
+
+            const std::uint64_t count = vectors * VectorSize % Mod;
+            b = (b + count * a % Mod + VectorSize * (prefix_sum % Mod) + Mod - weighted_sum % Mod) % Mod;
+            a = (a + sum) % Mod;
+        }
+
+        // The most vectors whose prefix sums fit in the lanes.
+        constexpr size_t adler32_block = 4096;
+
+        constexpr size_t fletcher64_block = 65536;
+
+        constexpr std::uint32_t crc32c_polynomial = 0x82f63b78;
+
+        // table[k][x] is the crc of byte x followed by k zero bytes.
+        struct crc32c_tables {
+            std::uint32_t table[8][256];
+        };
+
+        constexpr crc32c_tables make_crc32c_tables()
+        {
+            crc32c_tables tables {};
+            for (std::uint32_t x = 0; x < 256; ++x) {
+                std::uint32_t crc = x;
+                for (int bit = 0; bit < 8; ++bit)
+                    crc = crc >> 1 ^ (crc & 1 ? crc32c_polynomial : 0);
+                tables.table[0][x] = crc;
+            }
+            for (int k = 1; k < 8; ++k)
+                for (int x = 0; x < 256; ++x)
+                    tables.table[k][x] = tables.table[k - 1][x] >> 8 ^ tables.table[0][tables.table[k - 1][x] & 0xff];
+            return tables;
+        }
+
+        inline constexpr crc32c_tables crc32c_slices = make_crc32c_tables();
+
+        inline std::uint32_t crc32c_slice_by_8(std::uint32_t crc, const unsigned char* bytes, size_t size)
+        {
+            const auto& t = crc32c_slices.table;
+
+            for (; size >= 8; size -= 8, bytes += 8) {
+                std::uint64_t word;
+                std::memcpy(&word, bytes, sizeof(word));
+                word ^= crc;
+                crc = t[7][word & 0xff] ^ t[6][word >> 8 & 0xff] ^ t[5][word >> 16 & 0xff] ^ t[4][word >> 24 & 0xff]
+                    ^ t[3][word >> 32 & 0xff] ^ t[2][word >> 40 & 0xff] ^ t[1][word >> 48 & 0xff] ^ t[0][word >> 56];
+            }
+            for (; size > 0; --size, ++bytes)
+                crc = crc >> 8 ^ t[0][(crc ^ *bytes) & 0xff];
+            return crc;
+        }
+
+#if PURE_SIMD_HAS_CRC32C
+        inline std::uint32_t crc32c_word(std::uint32_t crc, const unsigned char* bytes)
+        {
+            std::uint64_t word;
+            std::memcpy(&word, bytes, sizeof(word));
+#if defined(__x86_64__)
+            return static_cast<std::uint32_t>(__builtin_ia32_crc32di(crc, word));
+#else
+            return __crc32cd(crc, word);
+#endif
+        }
+
+        inline std::uint32_t crc32c_byte(std::uint32_t crc, unsigned char byte)
+        {
+#if defined(__x86_64__)
+            return __builtin_ia32_crc32qi(crc, byte);
+#else
+            return __crc32cb(crc, byte);
+#endif
+        }
+
+        // The bytes of each of the three streams.
+        constexpr size_t crc32c_stream = 1024;
+
+        // The crc after Bytes more zero bytes, which is linear in the crc:
+        // table[k][x] is the image of byte k of the crc being x.
+        struct crc32c_shift {
+            std::uint32_t table[4][256];
+
+            constexpr std::uint32_t operator()(std::uint32_t crc) const
+            {
+                return table[0][crc & 0xff] ^ table[1][crc >> 8 & 0xff] ^ table[2][crc >> 16 & 0xff] ^ table[3][crc >> 24];
+            }
+        };
+
+        // Squares the shift by one zero byte until it shifts by Bytes.
+        template <size_t Bytes>
+        constexpr crc32c_shift make_crc32c_shift()
+        {
+            static_assert(Bytes > 0 && (Bytes & (Bytes - 1)) == 0);
+
+            std::uint32_t images[32] {};
+            for (int bit = 0; bit < 32; ++bit) {
+                std::uint32_t crc = std::uint32_t { 1 } << bit;
+                images[bit] = crc >> 8 ^ crc32c_slices.table[0][crc & 0xff];
+            }
+            for (size_t bytes = 1; bytes < Bytes; bytes *= 2) {
+                std::uint32_t squared[32] {};
+                for (int bit = 0; bit < 32; ++bit)
+                    for (int k = 0; k < 32; ++k)
+                        if (images[bit] >> k & 1)
+                            squared[bit] ^= images[k];
+                for (int bit = 0; bit < 32; ++bit)
+                    images[bit] = squared[bit];
+            }
+
+            crc32c_shift shift {};
+            for (int k = 0; k < 4; ++k)
+                for (int x = 0; x < 256; ++x)
+                    for (int bit = 0; bit < 8; ++bit)
+                        if (x >> bit & 1)
+                            shift.table[k][x] ^= images[8 * k + bit];
+            return shift;
+        }
+
+        template <size_t Bytes>
+        inline constexpr crc32c_shift crc32c_shift_by = make_crc32c_shift<Bytes>();
+
+        inline std::uint32_t crc32c_hardware(std::uint32_t crc, const unsigned char* bytes, size_t size)
+        {
+            constexpr size_t stream = crc32c_stream;
+
+            for (; size >= 3 * stream; size -= 3 * stream, bytes += 3 * stream) {
+                std::uint32_t crc1 = 0;
+                std::uint32_t crc2 = 0;
+                for (size_t i = 0; i < stream; i += 8) {
+                    crc = crc32c_word(crc, bytes + i);
+                    crc1 = crc32c_word(crc1, bytes + stream + i);
+                    crc2 = crc32c_word(crc2, bytes + 2 * stream + i);
+                }
+                crc = crc32c_shift_by<2 * stream>(crc) ^ crc32c_shift_by<stream>(crc1) ^ crc2;
+            }
+            for (; size >= 8; size -= 8, bytes += 8)
+                crc = crc32c_word(crc, bytes);
+            for (; size > 0; --size, ++bytes)
+                crc = crc32c_byte(crc, *bytes);
+            return crc;
+        }
+#endif
+
+    } // namespace detail
+
+    // The Adler-32 checksum of zlib; adler is the checksum of the data before.
+    template <size_t VectorSize>
+    std::uint32_t adler32(const void* data, size_t size, std::uint32_t adler = 1)
+    {
+        constexpr std::uint64_t mod = 65521;
+
+        auto bytes = static_cast<const unsigned char*>(data);
+        std::uint64_t a = (adler & 0xffff) % mod;
+        std::uint64_t b = (adler >> 16) % mod;
+
+        for (size_t vectors = size / VectorSize; vectors > 0;) {
+            const size_t count = std::min(vectors, detail::adler32_block);
+            detail::fletcher_block<VectorSize, std::uint32_t, mod>(bytes, count, a, b);
+            bytes += count * VectorSize;
+            vectors -= count;
+        }
+        for (size_t i = 0; i < size % VectorSize; ++i) {
+            a = (a + bytes[i]) % mod;
+            b = (b + a) % mod;
+        }
+        return static_cast<std::uint32_t>(b << 16 | a);
+    }
+
+    // fletcher is the checksum of the words before.
+    template <size_t VectorSize>
+    std::uint64_t fletcher64(const std::uint32_t* words, size_t n, std::uint64_t fletcher = 0)
+    {
+        constexpr std::uint64_t mod = 0xffffffff;
+
+        std::uint64_t a = (fletcher & 0xffffffff) % mod;
+        std::uint64_t b = (fletcher >> 32) % mod;
+
+        for (size_t vectors = n / VectorSize; vectors > 0;) {
+            const size_t count = std::min(vectors, detail::fletcher64_block);
+            detail::fletcher_block<VectorSize, std::uint64_t, mod>(words, count, a, b);
+            words += count * VectorSize;
+            vectors -= count;
+        }
+        for (size_t i = 0; i < n % VectorSize; ++i) {
+            a = (a + words[i]) % mod;
+            b = (b + a) % mod;
+        }
+        return b << 32 | a;
+    }
+
+    // crc is the crc32c of the data before.
+    inline std::uint32_t crc32c(const void* data, size_t size, std::uint32_t crc = 0)
+    {
+        auto bytes = static_cast<const unsigned char*>(data);
+#if PURE_SIMD_HAS_CRC32C
+        return ~detail::crc32c_hardware(~crc, bytes, size);
+#else
+        return ~detail::crc32c_slice_by_8(~crc, bytes, size);
+#endif
+    }
+
 } // namespace pure_simd
 
 #endif /* PURE_SIMD_H */
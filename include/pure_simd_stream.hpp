@@ -0,0 +1,268 @@
+#ifndef PURE_SIMD_STREAM_H
+#define PURE_SIMD_STREAM_H
+
+// The streaming front end over memory-mapped files. It is kept out of
+// pure_simd.hpp, which does not depend on POSIX headers.
+
+#include <cerrno>
+#include <string>
+#include <system_error>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "pure_simd.hpp"
+
+namespace pure_simd {
+    // Algorithms: streaming over memory-mapped files.
+    //
+    // The functions below walk files that need not fit into memory. The input
+    // is mapped read-only with a sequential hint and processed in chunks of
+    // whole vectors: the next chunk is requested with MADV_WILLNEED before the
+    // current one is processed, and pages that are done with are dropped with
+    // MADV_DONTNEED, so the resident set stays around two chunks. Output
+    // chunks are written back with msync before they are dropped, which
+    // keeps dirty pages from piling up in the page cache.
+    struct stream_options {
+        // Bytes of input per chunk, rounded down to whole vectors.
+        size_t chunk_bytes = size_t(64) << 20;
+
+        // Touches the pages of the next chunk on a background thread while
+        // the current one is processed, so that page faults overlap with the
+        // computation instead of only relying on the kernel's readahead.
+        bool read_ahead_thread = false;
+    };
+
+    namespace detail {
+        [[noreturn]] inline void throw_errno(const std::string& what)
+        {
+            throw std::system_error(errno, std::generic_category(), what);
+        }
+
+        class mapped_file {
+        public:
+            // Maps `path` read-only.
+            explicit mapped_file(const std::string& path)
+                : fd_ { ::open(path.c_str(), O_RDONLY) }
+            {
+                if (fd_ < 0)
+                    throw_errno("cannot open " + path);
+
+                struct stat status;
+                if (::fstat(fd_, &status) != 0)
+                    fail("cannot stat " + path);
+
+                map(path, static_cast<size_t>(status.st_size), PROT_READ);
+                if (size_)
+                    ::madvise(data_, size_, MADV_SEQUENTIAL);
+            }
+
+            // Creates or truncates `path` to `size` bytes and maps it for writing.
+            mapped_file(const std::string& path, size_t size)
+                : fd_ { ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644) }
+            {
+                if (fd_ < 0)
+                    throw_errno("cannot create " + path);
+
+                if (::ftruncate(fd_, static_cast<off_t>(size)) != 0)
+                    fail("cannot resize " + path);
+
+                map(path, size, PROT_READ | PROT_WRITE);
+            }
+
+            mapped_file(const mapped_file&) = delete;
+
+            mapped_file& operator=(const mapped_file&) = delete;
+
+            ~mapped_file()
+            {
+                if (size_)
+                    ::munmap(data_, size_);
+                ::close(fd_);
+            }
+
+            std::byte* data() const { return static_cast<std::byte*>(data_); }
+
+            // Whether `path` names this file, through the same or another
+            // name, as a hard or a symbolic link.
+            bool is_same_file(const std::string& path) const
+            {
+                struct stat mine, other;
+                if (::fstat(fd_, &mine) != 0)
+                    throw_errno("cannot stat a mapped file");
+                if (::stat(path.c_str(), &other) != 0)
+                    return false;
+                return mine.st_dev == other.st_dev && mine.st_ino == other.st_ino;
+            }
+
+            size_t size() const { return size_; }
+
+            // Applies `advice` to the pages overlapping [begin, end). Only
+            // whole pages inside the range are dropped by MADV_DONTNEED.
+            void advise(size_t begin, size_t end, int advice) const
+            {
+                static const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+
+                begin = advice == MADV_DONTNEED ? (begin + page - 1) / page * page : begin / page * page;
+                end = advice == MADV_DONTNEED ? end / page * page : std::min(size_, (end + page - 1) / page * page);
+                if (begin < end)
+                    ::madvise(data() + begin, end - begin, advice);
+            }
+
+            // Writes the pages overlapping [begin, end) back to the file and
+            // drops the whole pages inside the range.
+            void flush(size_t begin, size_t end) const
+            {
+                static const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+
+                const size_t first = begin / page * page;
+                const size_t last = std::min(size_, (end + page - 1) / page * page);
+                if (first < last && ::msync(data() + first, last - first, MS_SYNC) != 0)
+                    throw_errno("cannot write back a mapped file");
+                advise(begin, end, MADV_DONTNEED);
+            }
+
+        private:
+            void map(const std::string& path, size_t size, int protection)
+            {
+                if (size == 0)
+                    return;
+
+                void* data = ::mmap(nullptr, size, protection, MAP_SHARED, fd_, 0);
+                if (data == MAP_FAILED)
+                    fail("cannot map " + path);
+
+                data_ = data;
+                size_ = size;
+            }
+
+            [[noreturn]] void fail(const std::string& what)
+            {
+                int error = errno;
+                ::close(fd_);
+                errno = error;
+                throw_errno(what);
+            }
+
+            int fd_;
+            void* data_ = nullptr;
+            size_t size_ = 0;
+        };
+
+        // Reads one byte of every page in [begin, end), faulting them in.
+        inline void touch_pages(const std::byte* begin, const std::byte* end)
+        {
+            static const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+
+            for (auto p = begin; p < end; p += page)
+                static_cast<void>(*static_cast<const volatile std::byte*>(p));
+        }
+
+        template <typename S>
+        size_t element_count(const mapped_file& file, const std::string& path)
+        {
+            if (file.size() % sizeof(S))
+                throw std::invalid_argument(path + " does not hold a whole number of elements");
+            return file.size() / sizeof(S);
+        }
+
+        template <size_t VectorSize, typename S, typename F>
+        void for_each_chunk(const mapped_file& file, size_t n, F func, stream_options options)
+        {
+            const auto src = reinterpret_cast<const S*>(file.data());
+            const size_t chunk = std::max<size_t>(1, options.chunk_bytes / sizeof(S) / VectorSize) * VectorSize;
+
+            for (size_t begin = 0; begin < n; begin += chunk) {
+                const size_t end = std::min(n, begin + chunk);
+                const size_t next_end = std::min(n, end + chunk);
+
+                file.advise(end * sizeof(S), next_end * sizeof(S), MADV_WILLNEED);
+
+                {
+                    joining_thread reader;
+                    if (options.read_ahead_thread && end < n)
+                        reader.thread = std::thread(touch_pages, file.data() + end * sizeof(S), file.data() + next_end * sizeof(S));
+
+                    func(src + begin, begin, end - begin);
+                }
+
+                file.advise(begin * sizeof(S), end * sizeof(S), MADV_DONTNEED);
+            }
+        }
+
+    } // namespace detail
+
+    // Calls `func(const S* chunk, size_t offset, size_t count)` for
+    // consecutive chunks of the file at `path`, read as an array of S. Every
+    // chunk but the last holds a multiple of VectorSize elements.
+    template <size_t VectorSize, typename S, typename F>
+    void stream_chunks(const std::string& path, F func, stream_options options = {})
+    {
+        static_assert(std::is_trivially_copyable_v<S>);
+
+        detail::mapped_file file(path);
+        detail::for_each_chunk<VectorSize, S>(file, detail::element_count<S>(file, path), func, options);
+    }
+
+    // Streams the file at `src_path` through `func` like transform and writes
+    // the results to `dst_path`, which is created or truncated to the same
+    // number of elements. Throws std::invalid_argument if both paths name the
+    // same file, which truncating would destroy.
+    template <size_t VectorSize, typename S, typename T, typename F>
+    void stream_transform(const std::string& src_path, const std::string& dst_path, F func, stream_options options = {})
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        detail::mapped_file input(src_path);
+        const size_t n = detail::element_count<S>(input, src_path);
+
+        if (input.is_same_file(dst_path))
+            throw std::invalid_argument(dst_path + " is the input of stream_transform");
+
+        detail::mapped_file output(dst_path, n * sizeof(T));
+        const auto dst = reinterpret_cast<T*>(output.data());
+
+        detail::for_each_chunk<VectorSize, S>(
+            input, n, [&](const S* chunk, size_t offset, size_t count) {
+                transform<VectorSize>(chunk, count, dst + offset, func);
+                output.flush(offset * sizeof(T), (offset + count) * sizeof(T));
+            },
+            options);
+    }
+
+    // Reduces the file at `src_path` like accumulate. The vector of partial
+    // sums is carried from chunk to chunk, so the result equals accumulate
+    // over the whole file in memory.
+    template <size_t VectorSize, typename S, typename T, typename F>
+    auto stream_accumulate(const std::string& src_path, T init, F func, stream_options options = {})
+    {
+        using Source = vector<compute_type_t<S>, VectorSize>;
+        using Target = vector<T, VectorSize>;
+
+        auto sum = scalar<Target>(init);
+        stream_chunks<VectorSize, S>(
+            src_path, [&](const S* chunk, size_t, size_t count) {
+                auto loops = count / VectorSize;
+                for (size_t i = 0; i < loops; ++i, chunk += VectorSize)
+                    sum = unroll(sum, load_from<Source>(chunk), func);
+
+                std::transform(chunk, chunk + count % VectorSize, sum.begin(), sum.begin(), [&](compute_type_t<S> val, auto curr) {
+                    return func(curr, val);
+                });
+            },
+            options);
+
+        return sum;
+    }
+
+    template <size_t VectorSize, typename S, typename T>
+    auto stream_accumulate(const std::string& src_path, T init, stream_options options = {})
+    {
+        return stream_accumulate<VectorSize, S>(src_path, init, std::plus<>(), options);
+    }
+} // namespace pure_simd
+
+#endif /* PURE_SIMD_STREAM_H */
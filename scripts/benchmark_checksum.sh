@@ -0,0 +1,3 @@
+#!/usr/bin/env bash
+
+./scripts/benchmark.sh --benchmark_filter=BM_checksum
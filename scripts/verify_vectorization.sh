@@ -0,0 +1,91 @@
+#!/usr/bin/env bash
+
+# Disassembles the kernels of benchmark/vectorization.cpp and reports, per kernel,
+# the widest vector register used and the instruction mix. Fails if a kernel
+# expected to vectorize contains no vector arithmetic at all.
+#
+# Usage: verify_vectorization.sh <object file or static library>
+
+if [ $# -ne 1 ]; then
+    echo "usage: $0 <object file or static library>" >&2
+    exit 2
+fi
+
+OBJDUMP=${OBJDUMP:-objdump}
+
+"$OBJDUMP" -d --no-show-raw-insn "$1" | awk '
+function flush() {
+    if (kernel == "")
+        return;
+
+    width = "scalar";
+    if (v128 > 0) width = "128";
+    if (v256 > 0) width = "256";
+    if (v512 > 0) width = "512";
+
+    status = "ok";
+    if (expect == "vector" && arith == 0) {
+        status = "FAILED";
+        failed++;
+    }
+
+    printf "%-42s %6s %6d %6d %6d %6d %6d %6d  %s\n", kernel, width, total, scalar, fp_scalar, v128, v256, v512, status;
+    kernel = "";
+}
+
+BEGIN {
+    printf "%-42s %6s %6s %6s %6s %6s %6s %6s  %s\n", "kernel", "width", "total", "int", "fp", "v128", "v256", "v512", "status";
+}
+
+/^[0-9a-f]+ <.*>:$/ {
+    flush();
+
+    name = $2;
+    gsub(/[<>:]/, "", name);
+    if (name !~ /^pure_simd_kernel_/)
+        next;
+
+    # pure_simd_kernel_<expectation>__<operation>__<type>__<size>
+    split(substr(name, length("pure_simd_kernel_") + 1), parts, "__");
+    expect = parts[1];
+    kernel = parts[2] "<" parts[3] ", " parts[4] ">";
+    total = scalar = fp_scalar = v128 = v256 = v512 = arith = 0;
+    next;
+}
+
+kernel != "" && /^ +[0-9a-f]+:\t/ {
+    split($0, cols, "\t");
+    insn = cols[2];
+    mnemonic = insn;
+    sub(/ .*/, "", mnemonic);
+
+    total++;
+
+    vector_insn = 1;
+    if (insn ~ /%zmm/)
+        v512++;
+    else if (insn ~ /%ymm/)
+        v256++;
+    else if (insn ~ /%xmm/) {
+        if ((mnemonic !~ /^v?p/ && mnemonic ~ /(ss|sd)$/) || mnemonic ~ /^v?(movd|movq|cvtsi2s|cvtts|ucomis|comis|pextr|pinsr)/) {
+            fp_scalar++;
+            vector_insn = 0;
+        } else
+            v128++;
+    } else {
+        scalar++;
+        vector_insn = 0;
+    }
+
+    if (vector_insn && mnemonic !~ /mov|broadcast|extract|insert|perm|shuf|unpck|blend|align|pack/)
+        arith++;
+}
+
+END {
+    flush();
+    if (failed > 0) {
+        printf "%d kernel(s) expected to vectorize contain only scalar arithmetic\n", failed;
+        exit 1;
+    }
+}
+'
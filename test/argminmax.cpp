@@ -0,0 +1,102 @@
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "pure_simd.hpp"
+#include "gtest/gtest.h"
+
+namespace psd = pure_simd;
+
+namespace {
+    // Few distinct values, so that the extremes repeat.
+    template <typename T>
+    std::vector<T> random_values(std::size_t n, int range)
+    {
+        std::mt19937_64 gen(n);
+        std::uniform_int_distribution<int> dist(-range, range);
+
+        std::vector<T> xs(n);
+        for (auto& x : xs)
+            x = static_cast<T>(dist(gen));
+        return xs;
+    }
+
+    std::size_t first_max(const std::vector<float>& xs)
+    {
+        return std::max_element(xs.begin(), xs.end()) - xs.begin();
+    }
+}
+
+TEST(TestArgMinMax, FirstExtremes)
+{
+    for (std::size_t n = 1; n < 300; n += 7) {
+        auto xs = random_values<float>(n, 5);
+        auto expected_min = static_cast<std::size_t>(std::min_element(xs.begin(), xs.end()) - xs.begin());
+
+        EXPECT_EQ(psd::argmin<16>(xs.data(), n), expected_min) << n;
+        EXPECT_EQ(psd::argmax<8>(xs.data(), n), first_max(xs)) << n;
+        EXPECT_EQ(psd::minmax_element<4>(xs.data(), n), std::make_pair(expected_min, first_max(xs))) << n;
+    }
+
+    auto ys = random_values<std::int64_t>(1000, 1000000);
+    EXPECT_EQ(psd::argmin<8>(ys.data(), ys.size()), static_cast<std::size_t>(std::min_element(ys.begin(), ys.end()) - ys.begin()));
+
+    auto bytes = random_values<std::uint8_t>(1000, 100);
+    EXPECT_EQ(psd::argmax<32>(bytes.data(), bytes.size()), static_cast<std::size_t>(std::max_element(bytes.begin(), bytes.end()) - bytes.begin()));
+
+    EXPECT_EQ(psd::argmin<8>(ys.data(), 0), 0u);
+}
+
+TEST(TestArgMinMax, Ties)
+{
+    // Every lane holds the extreme, the first of which is in the last lane.
+    std::vector<int> xs(64, 1);
+    for (std::size_t i = 15; i < xs.size(); i += 16)
+        xs[i] = 0;
+    xs[7] = 2;
+    xs[40] = 2;
+
+    EXPECT_EQ(psd::argmin<16>(xs.data(), xs.size()), 15u);
+    EXPECT_EQ(psd::argmax<16>(xs.data(), xs.size()), 7u);
+    EXPECT_EQ(psd::minmax_element<8>(xs.data(), xs.size()), std::make_pair(std::size_t { 15 }, std::size_t { 7 }));
+}
+
+TEST(TestArgMinMax, TotalOrder)
+{
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const double inf = std::numeric_limits<double>::infinity();
+
+    std::vector<double> xs(20, 1.0);
+    xs[3] = 0.0;
+    xs[11] = -0.0;
+    EXPECT_EQ(psd::minmax_element<4>(xs.data(), xs.size()), std::make_pair(std::size_t { 11 }, std::size_t { 0 }));
+
+    xs[5] = inf;
+    xs[6] = nan;
+    xs[9] = -inf;
+    xs[13] = -nan;
+    EXPECT_EQ(psd::minmax_element<8>(xs.data(), xs.size()), std::make_pair(std::size_t { 13 }, std::size_t { 6 }));
+
+    std::vector<float> ys(xs.begin(), xs.end());
+    EXPECT_EQ(psd::argmin<16>(ys.data(), ys.size()), 13u);
+    EXPECT_EQ(psd::argmax<16>(ys.data(), ys.size()), 6u);
+}
+
+TEST(TestArgMinMax, Threads)
+{
+    auto xs = random_values<float>(100003, 50);
+    auto expected_min = static_cast<std::size_t>(std::min_element(xs.begin(), xs.end()) - xs.begin());
+
+    for (std::size_t threads : { 1, 2, 3, 8 }) {
+        EXPECT_EQ(psd::argmin<16>(xs.data(), xs.size(), threads), expected_min) << threads;
+        EXPECT_EQ(psd::argmax<16>(xs.data(), xs.size(), threads), first_max(xs)) << threads;
+        EXPECT_EQ(psd::minmax_element<8>(xs.data(), xs.size(), threads), std::make_pair(expected_min, first_max(xs))) << threads;
+    }
+
+    // The extremes only in the last slice.
+    xs.back() = -100;
+    xs[xs.size() - 2] = 100;
+    EXPECT_EQ(psd::minmax_element<16>(xs.data(), xs.size(), 4), std::make_pair(xs.size() - 1, xs.size() - 2));
+}
@@ -0,0 +1,134 @@
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "pure_simd.hpp"
+#include "gtest/gtest.h"
+
+namespace psd = pure_simd;
+
+namespace {
+    template <typename T>
+    unsigned reference_popcount(T x)
+    {
+        unsigned count = 0;
+        for (; x != 0; x = static_cast<T>(x >> 1))
+            count += x & 1;
+        return count;
+    }
+
+    template <typename T>
+    unsigned reference_countl_zero(T x)
+    {
+        unsigned count = 0;
+        for (unsigned bit = 8 * sizeof(T); bit-- > 0 && ((x >> bit) & 1) == 0;)
+            ++count;
+        return count;
+    }
+
+    template <typename T>
+    unsigned reference_countr_zero(T x)
+    {
+        unsigned count = 0;
+        for (unsigned bit = 0; bit < 8 * sizeof(T) && ((x >> bit) & 1) == 0; ++bit)
+            ++count;
+        return count;
+    }
+
+    // Random values with random runs of zeros at either end, and the edges.
+    template <typename T, std::size_t N>
+    psd::vector<T, N> random_lanes(std::uint64_t seed)
+    {
+        std::mt19937_64 gen(seed);
+
+        psd::vector<T, N> xs;
+        for (std::size_t k = 0; k < N; ++k) {
+            auto x = static_cast<T>(gen());
+            xs[k] = static_cast<T>(static_cast<T>(x >> (gen() % (8 * sizeof(T)))) << (gen() % (8 * sizeof(T))));
+        }
+        xs[0] = 0;
+        xs[1] = static_cast<T>(~T {});
+        xs[2] = 1;
+        xs[3] = static_cast<T>(T { 1 } << (8 * sizeof(T) - 1));
+        return xs;
+    }
+
+    template <typename T, std::size_t N>
+    void check_bits()
+    {
+        for (std::uint64_t seed = 0; seed < 10; ++seed) {
+            auto xs = random_lanes<T, N>(seed);
+
+            auto pops = psd::popcount(xs);
+            auto leading = psd::countl_zero(xs);
+            auto trailing = psd::countr_zero(xs);
+            for (std::size_t k = 0; k < N; ++k) {
+                EXPECT_EQ(pops[k], reference_popcount(xs[k])) << +xs[k];
+                EXPECT_EQ(leading[k], reference_countl_zero(xs[k])) << +xs[k];
+                EXPECT_EQ(trailing[k], reference_countr_zero(xs[k])) << +xs[k];
+            }
+
+            for (int s : { 0, 1, 3, 8, int(8 * sizeof(T)) - 1, int(8 * sizeof(T)), -1, -5, 100 }) {
+                auto left = psd::rotl(xs, s);
+                auto right = psd::rotr(xs, s);
+                for (std::size_t k = 0; k < N; ++k) {
+                    auto r = static_cast<unsigned>(s) % (8 * sizeof(T));
+                    auto expected = static_cast<T>(r == 0 ? xs[k] : (xs[k] << r) | (xs[k] >> (8 * sizeof(T) - r)));
+                    EXPECT_EQ(left[k], expected) << s;
+                    EXPECT_EQ(psd::rotl(right, s)[k], xs[k]) << s;
+                }
+            }
+        }
+    }
+}
+
+TEST(TestBits, Counts)
+{
+    check_bits<std::uint8_t, 64>();
+    check_bits<std::uint16_t, 32>();
+    check_bits<std::uint32_t, 16>();
+    check_bits<std::uint64_t, 8>();
+    check_bits<std::uint64_t, 5>();
+}
+
+TEST(TestBits, Byteswap)
+{
+    psd::vector<std::uint32_t, 4> words { 0x01020304u, 0, 0xff000000u, 0xdeadbeefu };
+    EXPECT_TRUE(psd::all(psd::byteswap(words) == psd::vector<std::uint32_t, 4> { 0x04030201u, 0, 0x000000ffu, 0xefbeaddeu }));
+
+    psd::vector<std::int16_t, 2> halves { 0x0180, -2 };
+    EXPECT_TRUE(psd::all(psd::byteswap(halves) == psd::vector<std::int16_t, 2> { -32767, -257 }));
+
+    psd::vector<std::uint64_t, 2> longs { 0x0102030405060708ull, 1 };
+    EXPECT_TRUE(psd::all(psd::byteswap(longs) == psd::vector<std::uint64_t, 2> { 0x0807060504030201ull, 0x0100000000000000ull }));
+}
+
+TEST(TestBits, ByteswapCopy)
+{
+    // Big-endian bytes of 0, 1, 2, ... as they would come from a file.
+    std::vector<unsigned char> bytes(4 * 1001);
+    for (std::size_t i = 0; i < bytes.size(); i += 4) {
+        auto value = static_cast<std::uint32_t>(i / 4 * 0x01010101u);
+        for (std::size_t b = 0; b < 4; ++b)
+            bytes[i + b] = static_cast<unsigned char>(value >> (24 - 8 * b));
+    }
+
+    std::vector<std::uint32_t> words(1001);
+    std::memcpy(words.data(), bytes.data(), bytes.size());
+
+    std::vector<std::uint32_t> host(words.size());
+    psd::byteswap_copy<16>(words.data(), words.size(), host.data());
+    for (std::size_t i = 0; i < host.size(); ++i)
+        ASSERT_EQ(host[i], static_cast<std::uint32_t>(i * 0x01010101u)) << i;
+
+    // In place, twice, gives back the input.
+    std::vector<std::int64_t> longs(77);
+    for (std::size_t i = 0; i < longs.size(); ++i)
+        longs[i] = static_cast<std::int64_t>(i * 0x0123456789abcdefull);
+    auto original = longs;
+    psd::byteswap_copy<8>(longs.data(), longs.size(), longs.data());
+    EXPECT_EQ(longs[1], static_cast<std::int64_t>(0xefcdab8967452301ull));
+    psd::byteswap_copy<8>(longs.data(), longs.size(), longs.data());
+    EXPECT_EQ(longs, original);
+}
@@ -0,0 +1,144 @@
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "pure_simd.hpp"
+#include "gtest/gtest.h"
+
+namespace psd = pure_simd;
+
+namespace {
+    std::uint32_t reference_adler32(const unsigned char* bytes, std::size_t size, std::uint32_t adler = 1)
+    {
+        std::uint32_t a = adler & 0xffff;
+        std::uint32_t b = adler >> 16;
+        for (std::size_t i = 0; i < size; ++i) {
+            a = (a + bytes[i]) % 65521;
+            b = (b + a) % 65521;
+        }
+        return b << 16 | a;
+    }
+
+    std::uint64_t reference_fletcher64(const std::uint32_t* words, std::size_t n)
+    {
+        std::uint64_t a = 0;
+        std::uint64_t b = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            a = (a + words[i]) % 0xffffffff;
+            b = (b + a) % 0xffffffff;
+        }
+        return b << 32 | a;
+    }
+
+    std::uint32_t reference_crc32c(const unsigned char* bytes, std::size_t size)
+    {
+        std::uint32_t crc = 0xffffffff;
+        for (std::size_t i = 0; i < size; ++i) {
+            crc ^= bytes[i];
+            for (int bit = 0; bit < 8; ++bit)
+                crc = crc >> 1 ^ (crc & 1 ? 0x82f63b78 : 0);
+        }
+        return ~crc;
+    }
+
+    std::vector<unsigned char> random_bytes(std::size_t n, unsigned seed)
+    {
+        std::mt19937 gen(seed);
+
+        std::vector<unsigned char> bytes(n);
+        for (auto& byte : bytes)
+            byte = static_cast<unsigned char>(gen());
+        return bytes;
+    }
+}
+
+TEST(TestChecksum, KnownValues)
+{
+    const std::string digits = "123456789";
+
+    EXPECT_EQ(psd::adler32<16>(digits.data(), digits.size()), 0x091e01deu);
+    EXPECT_EQ(psd::adler32<32>("Wikipedia", 9), 0x11e60398u);
+    EXPECT_EQ(psd::adler32<32>(nullptr, 0), 1u);
+
+    EXPECT_EQ(psd::crc32c(digits.data(), digits.size()), 0xe3069283u);
+    EXPECT_EQ(psd::crc32c(nullptr, 0), 0u);
+
+    // 32 zero bytes and 32 bytes of 0xff, from RFC 3720.
+    std::vector<unsigned char> zeros(32, 0);
+    std::vector<unsigned char> ones(32, 0xff);
+    EXPECT_EQ(psd::crc32c(zeros.data(), zeros.size()), 0x8a9136aau);
+    EXPECT_EQ(psd::crc32c(ones.data(), ones.size()), 0x62a8ab43u);
+
+    std::uint32_t words[] { 0x64636261, 0x68676665 };
+    EXPECT_EQ(psd::fletcher64<4>(words, 1), 0x6463626164636261ull);
+    EXPECT_EQ(psd::fletcher64<4>(words, 2), reference_fletcher64(words, 2));
+}
+
+TEST(TestChecksum, MatchesReference)
+{
+    // Long enough for several blocks of every lane width and many streams.
+    for (std::size_t size : { std::size_t { 1 }, std::size_t { 31 }, std::size_t { 1000 }, std::size_t { 3 * 1024 * 3 + 17 }, std::size_t { 1 << 20 } }) {
+        auto bytes = random_bytes(size, static_cast<unsigned>(size));
+        if (size == 1 << 20)
+            std::fill(bytes.begin(), bytes.begin() + size / 2, 0xff);
+
+        EXPECT_EQ(psd::adler32<16>(bytes.data(), size), reference_adler32(bytes.data(), size)) << size;
+        EXPECT_EQ(psd::adler32<64>(bytes.data(), size), reference_adler32(bytes.data(), size)) << size;
+        EXPECT_EQ(psd::crc32c(bytes.data(), size), reference_crc32c(bytes.data(), size)) << size;
+
+        std::vector<std::uint32_t> words(size / 4);
+        std::memcpy(words.data(), bytes.data(), words.size() * 4);
+        EXPECT_EQ(psd::fletcher64<8>(words.data(), words.size()), reference_fletcher64(words.data(), words.size())) << size;
+        EXPECT_EQ(psd::fletcher64<16>(words.data(), words.size()), reference_fletcher64(words.data(), words.size())) << size;
+    }
+
+    // All ones is the largest input for the lane sums.
+    std::vector<std::uint32_t> ones(300000, 0xffffffff);
+    EXPECT_EQ(psd::fletcher64<8>(ones.data(), ones.size()), 0u);
+    ones[0] = 0xfffffffe;
+    EXPECT_EQ(psd::fletcher64<8>(ones.data(), ones.size()), reference_fletcher64(ones.data(), ones.size()));
+}
+
+// crc32c takes the hardware path where it exists, so the table fallback
+// is tested directly.
+TEST(TestChecksum, SliceBy8)
+{
+    auto slice_by_8 = [](const unsigned char* bytes, std::size_t size, std::uint32_t crc = 0) {
+        return ~psd::detail::crc32c_slice_by_8(~crc, bytes, size);
+    };
+
+    auto bytes = random_bytes(5000, 11);
+    for (std::size_t offset : { 0, 1, 3, 7 }) {
+        for (std::size_t size : { 0, 1, 7, 8, 9, 15, 16, 17, 100, 4093 }) {
+            EXPECT_EQ(slice_by_8(bytes.data() + offset, size), reference_crc32c(bytes.data() + offset, size)) << offset << " " << size;
+        }
+    }
+
+    const std::string digits = "123456789";
+    EXPECT_EQ(slice_by_8(reinterpret_cast<const unsigned char*>(digits.data()), digits.size()), 0xe3069283u);
+
+    for (std::size_t split : { 0, 1, 13, 2048, 4999, 5000 }) {
+        auto crc = slice_by_8(bytes.data(), split);
+        EXPECT_EQ(slice_by_8(bytes.data() + split, bytes.size() - split, crc), reference_crc32c(bytes.data(), bytes.size())) << split;
+    }
+}
+
+TEST(TestChecksum, Continues)
+{
+    auto bytes = random_bytes(20000, 7);
+
+    for (std::size_t split : { 0, 1, 13, 4096, 9999, 20000 }) {
+        auto adler = psd::adler32<32>(bytes.data(), split);
+        EXPECT_EQ(psd::adler32<32>(bytes.data() + split, bytes.size() - split, adler), reference_adler32(bytes.data(), bytes.size())) << split;
+
+        auto crc = psd::crc32c(bytes.data(), split);
+        EXPECT_EQ(psd::crc32c(bytes.data() + split, bytes.size() - split, crc), reference_crc32c(bytes.data(), bytes.size())) << split;
+    }
+
+    std::vector<std::uint32_t> words(5000);
+    std::memcpy(words.data(), bytes.data(), words.size() * 4);
+    auto fletcher = psd::fletcher64<8>(words.data(), 1234);
+    EXPECT_EQ(psd::fletcher64<8>(words.data() + 1234, words.size() - 1234, fletcher), reference_fletcher64(words.data(), words.size()));
+}
@@ -0,0 +1,145 @@
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "pure_simd.hpp"
+#include "gtest/gtest.h"
+
+namespace psd = pure_simd;
+
+namespace {
+    std::vector<std::uint32_t> random_values(size_t n, unsigned bits, unsigned seed)
+    {
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<std::uint32_t> dist;
+
+        std::vector<std::uint32_t> xs(n);
+        for (auto& x : xs)
+            x = bits == 32 ? dist(gen) : dist(gen) & ((std::uint32_t { 1 } << bits) - 1);
+        return xs;
+    }
+
+    // A sorted posting list with small gaps.
+    std::vector<std::uint32_t> sorted_values(size_t n, unsigned seed)
+    {
+        std::mt19937 gen(seed);
+        std::geometric_distribution<std::uint32_t> gap(0.1);
+
+        std::vector<std::uint32_t> xs(n);
+        std::uint32_t x = 1'000'000;
+        for (auto& value : xs)
+            value = x += gap(gen);
+        return xs;
+    }
+}
+
+TEST(TestCodec, InclusiveScan)
+{
+    for (size_t n : { 0, 1, 7, 1024, 3001 }) {
+        auto xs = random_values(n, 32, 1);
+
+        std::vector<std::uint32_t> expected(n);
+        std::inclusive_scan(xs.begin(), xs.end(), expected.begin(), std::plus<>(), 5u);
+
+        std::vector<std::uint32_t> actual(n);
+        psd::inclusive_scan<8>(xs.data(), n, actual.data(), 5u);
+        EXPECT_EQ(actual, expected) << n;
+
+        psd::inclusive_scan<16>(xs.data(), n, xs.data(), 5u);
+        EXPECT_EQ(xs, expected) << n;
+    }
+}
+
+TEST(TestCodec, PackBits)
+{
+    for (unsigned bits = 0; bits <= 32; ++bits) {
+        for (size_t n : { 0, 1, 31, 1024, 2500 }) {
+            auto xs = random_values(n, bits, bits);
+
+            std::vector<std::uint32_t> packed(psd::packed_size(n, bits) + 1, 0xdeadbeef);
+            auto end = psd::pack_bits<8>(xs.data(), n, bits, packed.data());
+            ASSERT_EQ(end - packed.data(), static_cast<std::ptrdiff_t>(psd::packed_size(n, bits)));
+            EXPECT_EQ(packed.back(), 0xdeadbeef);
+
+            // The layout does not depend on the vector size.
+            std::vector<std::uint32_t> packed32(packed.size(), 0xdeadbeef);
+            psd::pack_bits<32>(xs.data(), n, bits, packed32.data());
+            EXPECT_EQ(packed32, packed) << bits << " " << n;
+
+            std::vector<std::uint32_t> unpacked(n, 0xdeadbeef);
+            EXPECT_EQ(psd::unpack_bits<16>(packed.data(), n, bits, unpacked.data()), end);
+            EXPECT_EQ(unpacked, xs) << bits << " " << n;
+        }
+    }
+
+    std::vector<std::uint32_t> xs { 5, 9, 1 };
+    EXPECT_EQ(psd::required_bits<8>(xs.data(), xs.size()), 4u);
+    EXPECT_EQ(psd::required_bits<8>(xs.data(), 0), 0u);
+}
+
+TEST(TestCodec, EncodeDecode)
+{
+    using psd::integer_coding;
+
+    for (auto coding : { integer_coding::frame_of_reference, integer_coding::delta }) {
+        for (size_t n : { 0, 1, 1000, 1024, 5000 }) {
+            for (const auto& xs : { random_values(n, 32, 3), random_values(n, 7, 4), sorted_values(n, 5) }) {
+                std::vector<std::uint32_t> encoded(psd::max_encoded_size(n));
+                auto size = psd::encode<8>(xs.data(), n, encoded.data(), coding);
+                ASSERT_LE(size, encoded.size());
+
+                std::vector<std::uint32_t> decoded(n);
+                EXPECT_EQ(psd::decode<16>(encoded.data(), size, n, decoded.data(), coding), encoded.data() + size);
+                EXPECT_EQ(decoded, xs) << n;
+            }
+        }
+    }
+
+    // Frame of reference only stores the spread of a block, delta coding
+    // only the gaps.
+    auto xs = sorted_values(10'000, 6);
+    std::vector<std::uint32_t> encoded(psd::max_encoded_size(xs.size()));
+    auto for_size = psd::encode<8>(xs.data(), xs.size(), encoded.data(), integer_coding::frame_of_reference);
+    auto delta_size = psd::encode<8>(xs.data(), xs.size(), encoded.data(), integer_coding::delta);
+    EXPECT_LT(for_size, xs.size() / 2);
+    EXPECT_LT(delta_size, for_size);
+}
+
+TEST(TestCodec, CorruptInput)
+{
+    using psd::integer_coding;
+
+    const size_t n = 3000;
+    auto xs = random_values(n, 7, 5);
+    std::vector<std::uint32_t> encoded(psd::max_encoded_size(n));
+    auto size = psd::encode<8>(xs.data(), n, encoded.data(), integer_coding::frame_of_reference);
+    encoded.resize(size);
+
+    std::vector<std::uint32_t> decoded(n);
+    auto decode = [&](const std::vector<std::uint32_t>& words) {
+        return psd::decode<8>(words.data(), words.size(), n, decoded.data(), integer_coding::frame_of_reference);
+    };
+
+    auto wide = encoded;
+    wide[0] = 33;
+    EXPECT_THROW(decode(wide), std::invalid_argument);
+    wide[0] = 0xffffffff;
+    EXPECT_THROW(decode(wide), std::invalid_argument);
+
+    // A wider first block runs into the next one, and then past the end.
+    auto grown = encoded;
+    grown[0] = 32;
+    EXPECT_THROW(decode(grown), std::invalid_argument);
+
+    for (size_t cut : { size_t { 0 }, size_t { 1 }, size_t { 2 }, size - 1 }) {
+        std::vector<std::uint32_t> truncated(encoded.begin(), encoded.begin() + cut);
+        EXPECT_THROW(decode(truncated), std::invalid_argument) << cut;
+    }
+
+    EXPECT_THROW(psd::unpack_bits<8>(encoded.data(), 10, 40, decoded.data()), std::invalid_argument);
+    EXPECT_EQ(decode(encoded), encoded.data() + size);
+    EXPECT_EQ(decoded, xs);
+}
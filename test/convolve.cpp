@@ -0,0 +1,143 @@
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include "pure_simd.hpp"
+#include "gtest/gtest.h"
+
+namespace psd = pure_simd;
+
+namespace {
+    std::vector<float> random_floats(size_t n, unsigned seed)
+    {
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+        std::vector<float> xs(n);
+        for (auto& x : xs)
+            x = dist(gen);
+        return xs;
+    }
+
+    float at(const std::vector<float>& xs, std::ptrdiff_t i, psd::border mode)
+    {
+        auto n = static_cast<std::ptrdiff_t>(xs.size());
+        if (i >= 0 && i < n)
+            return xs[i];
+        if (mode == psd::border::clamp)
+            return xs[i < 0 ? 0 : n - 1];
+        if (mode == psd::border::wrap)
+            return xs[(i % n + n) % n];
+        return 0.0f;
+    }
+
+    std::vector<float> reference_convolve(const std::vector<float>& xs, const std::vector<float>& kernel, psd::border mode)
+    {
+        auto radius = static_cast<std::ptrdiff_t>(kernel.size() / 2);
+
+        std::vector<float> out(xs.size());
+        for (size_t i = 0; i < xs.size(); ++i) {
+            for (size_t k = 0; k < kernel.size(); ++k)
+                out[i] += kernel[k] * at(xs, static_cast<std::ptrdiff_t>(i + k) - radius, mode);
+        }
+        return out;
+    }
+
+    void expect_near(const std::vector<float>& actual, const std::vector<float>& expected)
+    {
+        ASSERT_EQ(actual.size(), expected.size());
+        for (size_t i = 0; i < actual.size(); ++i)
+            ASSERT_NEAR(actual[i], expected[i], 1e-5f) << i;
+    }
+
+    constexpr psd::border modes[] = { psd::border::zero, psd::border::clamp, psd::border::wrap };
+}
+
+TEST(TestConvolve, MatchesReference)
+{
+    for (auto mode : modes) {
+        for (size_t taps : { 1, 2, 3, 7, 8, 9, 16, 31, 33 }) {
+            auto kernel = random_floats(taps, 1);
+            for (size_t n : { 1, 2, 5, 16, 31, 100, 1000 }) {
+                auto xs = random_floats(n, 2);
+                auto expected = reference_convolve(xs, kernel, mode);
+
+                std::vector<float> out4(n), out8(n), out16(n);
+                psd::convolve<4>(xs.data(), n, kernel.data(), taps, out4.data(), mode);
+                psd::convolve<8>(xs.data(), n, kernel.data(), taps, out8.data(), mode);
+                psd::convolve<16>(xs.data(), n, kernel.data(), taps, out16.data(), mode);
+
+                SCOPED_TRACE(testing::Message() << "taps " << taps << ", n " << n);
+                expect_near(out4, expected);
+                expect_near(out8, expected);
+                expect_near(out16, expected);
+            }
+        }
+    }
+}
+
+TEST(TestConvolve, Fir)
+{
+    std::vector<float> xs { 1, 2, 3, 4, 5 };
+    std::vector<float> taps { 1, 10, 100 };
+
+    std::vector<float> out(xs.size());
+    psd::fir<4>(xs.data(), xs.size(), taps.data(), taps.size(), out.data());
+    EXPECT_EQ(out, (std::vector<float> { 1, 12, 123, 234, 345 }));
+
+    psd::fir<4>(xs.data(), xs.size(), taps.data(), taps.size(), out.data(), psd::border::clamp);
+    EXPECT_EQ(out, (std::vector<float> { 111, 112, 123, 234, 345 }));
+
+    psd::fir<4>(xs.data(), xs.size(), taps.data(), taps.size(), out.data(), psd::border::wrap);
+    EXPECT_EQ(out, (std::vector<float> { 451, 512, 123, 234, 345 }));
+}
+
+TEST(TestConvolve, Separable)
+{
+    const size_t width = 37, height = 23;
+
+    auto image = random_floats(width * height, 3);
+    auto row_kernel = random_floats(5, 4);
+    auto column_kernel = random_floats(3, 5);
+
+    for (auto mode : modes) {
+        std::vector<float> expected(width * height);
+        for (size_t y = 0; y < height; ++y) {
+            std::vector<float> row(image.begin() + y * width, image.begin() + (y + 1) * width);
+            auto filtered = reference_convolve(row, row_kernel, mode);
+            std::copy(filtered.begin(), filtered.end(), expected.begin() + y * width);
+        }
+        for (size_t x = 0; x < width; ++x) {
+            std::vector<float> column(height);
+            for (size_t y = 0; y < height; ++y)
+                column[y] = expected[y * width + x];
+            auto filtered = reference_convolve(column, column_kernel, mode);
+            for (size_t y = 0; y < height; ++y)
+                expected[y * width + x] = filtered[y];
+        }
+
+        std::vector<float> out(width * height);
+        psd::convolve_separable<8>(image.data(), width, height,
+            row_kernel.data(), row_kernel.size(), column_kernel.data(), column_kernel.size(), out.data(), mode);
+        expect_near(out, expected);
+    }
+}
+
+TEST(TestConvolve, Stencil)
+{
+    auto xs = random_floats(103, 6);
+
+    for (auto mode : modes) {
+        std::vector<float> expected(xs.size());
+        for (size_t i = 0; i < xs.size(); ++i) {
+            auto c = static_cast<std::ptrdiff_t>(i);
+            expected[i] = std::max(at(xs, c - 2, mode), at(xs, c + 2, mode)) - at(xs, c, mode);
+        }
+
+        std::vector<float> out(xs.size());
+        psd::stencil<8, 2>(xs.data(), xs.size(), out.data(), [](const auto& w) {
+            return psd::unroll(w[0], w[4], [](float a, float b) { return std::max(a, b); }) - w[2];
+        }, mode);
+        EXPECT_EQ(out, expected);
+    }
+}
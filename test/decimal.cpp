@@ -0,0 +1,168 @@
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "pure_simd.hpp"
+#include "gtest/gtest.h"
+
+namespace psd = pure_simd;
+
+namespace {
+    // Numbers of every length up to the limit of the type.
+    template <typename T>
+    std::vector<T> random_numbers(std::size_t n)
+    {
+        std::mt19937_64 gen(42);
+
+        std::vector<T> xs(n);
+        for (auto& x : xs)
+            x = static_cast<T>(gen() >> (gen() % 64));
+        return xs;
+    }
+
+    template <typename T>
+    std::string join(const std::vector<T>& xs, char delimiter)
+    {
+        std::string text;
+        for (auto x : xs)
+            text += std::to_string(x) + delimiter;
+        return text;
+    }
+}
+
+TEST(TestDecimal, ParseUint)
+{
+    auto xs = random_numbers<std::uint64_t>(1000);
+    xs[0] = 0;
+    xs[1] = std::numeric_limits<std::uint64_t>::max();
+    xs[2] = 1234567890123456ull;
+    xs[3] = 12345678901234567ull;
+
+    auto text = join(xs, ',');
+    text.pop_back();
+
+    std::vector<std::uint64_t> parsed(xs.size());
+    auto [ptr, count] = psd::parse_uint<16>(text.data(), text.data() + text.size(), parsed.data(), parsed.size());
+    EXPECT_EQ(count, xs.size());
+    EXPECT_EQ(ptr, text.data() + text.size());
+    EXPECT_EQ(parsed, xs);
+
+    parsed.assign(xs.size(), 0);
+    text += '\n';
+    count = psd::parse_uint<8>(text.data(), text.data() + text.size(), parsed.data(), parsed.size()).count;
+    EXPECT_EQ(count, xs.size());
+    EXPECT_EQ(parsed, xs);
+
+    std::string leading = "00000000000000000000000042\n7";
+    count = psd::parse_uint<16>(leading.data(), leading.data() + leading.size(), parsed.data(), 2).count;
+    EXPECT_EQ(count, 2);
+    EXPECT_EQ(parsed[0], 42u);
+    EXPECT_EQ(parsed[1], 7u);
+
+    std::string bad = "1,2,,3,18446744073709551616";
+    auto result = psd::parse_uint<8>(bad.data(), bad.data() + bad.size(), parsed.data(), 10);
+    EXPECT_EQ(result.count, 2);
+    EXPECT_EQ(result.ptr, bad.data() + 4);
+
+    parsed.assign(xs.size(), 99);
+    result = psd::parse_uint<8>(bad.data() + 5, bad.data() + bad.size(), parsed.data(), 10);
+    EXPECT_EQ(result.count, 1);
+    EXPECT_EQ(result.ptr, bad.data() + 7);
+    EXPECT_EQ(parsed[1], 99u);
+
+    result = psd::parse_uint<16>(bad.data(), bad.data() + bad.size(), parsed.data(), 1);
+    EXPECT_EQ(result.count, 1);
+    EXPECT_EQ(result.ptr, bad.data() + 2);
+}
+
+TEST(TestDecimal, ParseInt)
+{
+    auto xs = random_numbers<std::int64_t>(1000);
+    for (std::size_t i = 0; i < xs.size(); i += 2)
+        xs[i] = -xs[i];
+    xs[0] = std::numeric_limits<std::int64_t>::min();
+    xs[1] = std::numeric_limits<std::int64_t>::max();
+
+    auto text = join(xs, '\t');
+
+    std::vector<std::int64_t> parsed(xs.size());
+    auto count = psd::parse_int<16>(text.data(), text.data() + text.size(), parsed.data(), parsed.size()).count;
+    EXPECT_EQ(count, xs.size());
+    EXPECT_EQ(parsed, xs);
+
+    for (std::string bad : { "9223372036854775808", "-9223372036854775809", "-", "+1" }) {
+        parsed[0] = 99;
+        EXPECT_EQ(psd::parse_int<8>(bad.data(), bad.data() + bad.size(), parsed.data(), 1).count, 0) << bad;
+        EXPECT_EQ(parsed[0], 99) << bad;
+    }
+}
+
+TEST(TestDecimal, ParseDouble)
+{
+    std::mt19937_64 gen(42);
+    std::uniform_real_distribution<double> dist(-1000.0, 1000.0);
+
+    std::vector<std::string> fields { "0", "-0", "1.5", ".25", "3.", "1e3", "2.5E-3", "-7e+2", "123456789.123456789",
+        "0.1", "1e-300", "1e308", "1.7976931348623157e308", "4.9e-324", "12345678901234567890123", "inf", "nan" };
+    for (int i = 0; i < 1000; ++i) {
+        char buffer[32];
+        auto x = dist(gen) * std::pow(10.0, static_cast<int>(gen() % 40) - 20);
+        fields.emplace_back(buffer, std::to_chars(buffer, buffer + sizeof(buffer), x).ptr);
+        fields.emplace_back(buffer, std::to_chars(buffer, buffer + sizeof(buffer), static_cast<float>(x)).ptr);
+    }
+
+    std::string text;
+    for (auto& field : fields)
+        text += field + ',';
+
+    std::vector<double> parsed(fields.size());
+    auto [ptr, count] = psd::parse_double<16>(text.data(), text.data() + text.size(), parsed.data(), parsed.size());
+    EXPECT_EQ(count, fields.size());
+    EXPECT_EQ(ptr, text.data() + text.size());
+
+    for (std::size_t i = 0; i < fields.size(); ++i) {
+        double expected = 0;
+        std::from_chars(fields[i].data(), fields[i].data() + fields[i].size(), expected);
+        if (fields[i] == "nan")
+            EXPECT_TRUE(std::isnan(parsed[i]));
+        else
+            EXPECT_EQ(parsed[i], expected) << fields[i];
+    }
+    EXPECT_TRUE(std::signbit(parsed[1]));
+
+    std::string bad = "1.5,x";
+    parsed[1] = 99;
+    EXPECT_EQ(psd::parse_double<8>(bad.data(), bad.data() + bad.size(), parsed.data(), 2).count, 1);
+    EXPECT_EQ(parsed[1], 99);
+}
+
+TEST(TestDecimal, Format)
+{
+    auto xs = random_numbers<std::uint64_t>(1001);
+    xs[0] = 0;
+    xs[1] = std::numeric_limits<std::uint64_t>::max();
+    xs[2] = 10000000000000000ull;
+    xs[3] = 9999999999999999ull;
+
+    std::string text(psd::max_formatted_size(xs.size()), '\0');
+    auto end = psd::format_uint<16>(xs.data(), xs.size(), text.data(), ',');
+    EXPECT_EQ(std::string(text.data(), end), join(xs, ','));
+
+    auto ys = random_numbers<std::int64_t>(1001);
+    for (std::size_t i = 0; i < ys.size(); i += 3)
+        ys[i] = -ys[i];
+    ys[0] = std::numeric_limits<std::int64_t>::min();
+    ys[1] = -1;
+
+    text.assign(psd::max_formatted_size(ys.size()), '\0');
+    end = psd::format_int<8>(ys.data(), ys.size(), text.data(), '\n');
+    EXPECT_EQ(std::string(text.data(), end), join(ys, '\n'));
+
+    std::vector<std::int64_t> parsed(ys.size());
+    EXPECT_EQ(psd::parse_int<16>(text.data(), end, parsed.data(), parsed.size()).count, ys.size());
+    EXPECT_EQ(parsed, ys);
+}
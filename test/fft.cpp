@@ -0,0 +1,142 @@
+#include <cmath>
+#include <complex>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "pure_simd.hpp"
+#include "gtest/gtest.h"
+
+namespace psd = pure_simd;
+
+namespace {
+    std::vector<std::complex<double>> naive_dft(const std::vector<float>& re, const std::vector<float>& im)
+    {
+        const std::size_t n = re.size();
+        const double pi = std::acos(-1.0);
+
+        std::vector<std::complex<double>> out(n);
+        for (std::size_t k = 0; k < n; ++k)
+            for (std::size_t j = 0; j < n; ++j)
+                out[k] += std::complex<double>(re[j], im[j]) * std::polar(1.0, -2 * pi * (j * k % n) / n);
+        return out;
+    }
+
+    std::vector<float> random_signal(std::size_t n, unsigned seed)
+    {
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+        std::vector<float> xs(n);
+        for (auto& x : xs)
+            x = dist(gen);
+        return xs;
+    }
+
+    template <std::size_t VectorSize>
+    void expect_fft_matches_dft(std::size_t n)
+    {
+        auto re = random_signal(n, 1);
+        auto im = random_signal(n, 2);
+        auto expected = naive_dft(re, im);
+
+        auto plan = psd::make_fft_plan<float>(n);
+        psd::fft<VectorSize>(plan, re.data(), im.data());
+
+        // float rounding grows with log2(n) and the magnitude of the sums.
+        const double tolerance = 1e-5 * std::sqrt(static_cast<double>(n)) * std::log2(2.0 * n);
+        for (std::size_t k = 0; k < n; ++k) {
+            EXPECT_NEAR(re[k], expected[k].real(), tolerance) << n << " " << k;
+            EXPECT_NEAR(im[k], expected[k].imag(), tolerance) << n << " " << k;
+        }
+    }
+}
+
+TEST(TestFFT, ComplexVector)
+{
+    using cvec = psd::complex_vector<float, 4>;
+    using fvec = cvec::vector_type;
+
+    cvec xs { { 1, 0, 3, -1 }, { 2, 1, -4, 0 } };
+    cvec ys { { 3, 2, 1, 0 }, { -1, 0, 1, 2 } };
+
+    auto product = xs * ys;
+    auto conj_product = psd::conj_multiply(xs, ys);
+    auto magnitudes = psd::abs(xs);
+
+    for (std::size_t i = 0; i < 4; ++i) {
+        std::complex<float> x(xs.re[i], xs.im[i]);
+        std::complex<float> y(ys.re[i], ys.im[i]);
+
+        EXPECT_EQ(std::complex<float>(product.re[i], product.im[i]), x * y);
+        EXPECT_EQ(std::complex<float>(conj_product.re[i], conj_product.im[i]), x * std::conj(y));
+        EXPECT_FLOAT_EQ(magnitudes[i], std::abs(x));
+        EXPECT_EQ(psd::conj(xs).im[i], -xs.im[i]);
+    }
+
+    EXPECT_TRUE(psd::all(psd::norm(xs) == fvec { 5, 1, 25, 1 }));
+
+    static_assert(psd::is_complex_vector<cvec>::value);
+    static_assert(!psd::is_complex_vector<fvec>::value);
+
+    float re[4], im[4];
+    psd::store_to(xs, re, im);
+    auto loaded = psd::load_from<cvec>(re, im);
+    EXPECT_TRUE(psd::all(loaded.re == xs.re));
+    EXPECT_TRUE(psd::all(loaded.im == xs.im));
+}
+
+TEST(TestFFT, MatchesDFT)
+{
+    for (std::size_t n = 1; n <= 1024; n *= 2) {
+        expect_fft_matches_dft<1>(n);
+        expect_fft_matches_dft<4>(n);
+        expect_fft_matches_dft<8>(n);
+        expect_fft_matches_dft<16>(n);
+    }
+}
+
+TEST(TestFFT, RoundTrip)
+{
+    for (std::size_t n : { 2, 64, 512, 4096 }) {
+        auto re = random_signal(n, 3);
+        auto im = random_signal(n, 4);
+        auto re0 = re;
+        auto im0 = im;
+
+        auto plan = psd::make_fft_plan<double>(n);
+        std::vector<double> dre(re.begin(), re.end());
+        std::vector<double> dim(im.begin(), im.end());
+
+        psd::fft<8>(plan, dre.data(), dim.data());
+        psd::ifft<8>(plan, dre.data(), dim.data());
+
+        for (std::size_t k = 0; k < n; ++k) {
+            EXPECT_NEAR(dre[k], re0[k], 1e-12);
+            EXPECT_NEAR(dim[k], im0[k], 1e-12);
+        }
+    }
+}
+
+TEST(TestFFT, Impulse)
+{
+    // The transform of a unit impulse at 1 is the twiddle sequence itself.
+    const std::size_t n = 256;
+    std::vector<float> re(n), im(n);
+    re[1] = 1;
+
+    auto plan = psd::make_fft_plan<float>(n);
+    psd::fft<8>(plan, re.data(), im.data());
+
+    const double pi = std::acos(-1.0);
+    for (std::size_t k = 0; k < n; ++k) {
+        EXPECT_NEAR(re[k], std::cos(2 * pi * k / n), 1e-6);
+        EXPECT_NEAR(im[k], -std::sin(2 * pi * k / n), 1e-6);
+    }
+}
+
+TEST(TestFFT, InvalidSize)
+{
+    EXPECT_THROW(psd::make_fft_plan<float>(0), std::invalid_argument);
+    EXPECT_THROW(psd::make_fft_plan<float>(12), std::invalid_argument);
+}
@@ -0,0 +1,103 @@
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "pure_simd.hpp"
+#include "gtest/gtest.h"
+
+namespace psd = pure_simd;
+
+namespace {
+    const std::string text = "2020-05-01 12:00:01 INFO  started\n"
+                             "2020-05-01 12:00:02 WARN  disk almost full\n"
+                             "\n"
+                             "2020-05-01 12:00:03 ERROR disk full; retrying in 10s\n"
+                             "2020-05-01 12:00:04 INFO  done";
+
+    const char* data = text.data();
+}
+
+TEST(TestFind, Find)
+{
+    for (char c : { '\n', 'E', ';', '2', 'x', 'e' }) {
+        auto expected = std::find(text.begin(), text.end(), c) - text.begin();
+
+        EXPECT_EQ(psd::find<32>(data, text.size(), c), expected);
+        EXPECT_EQ(psd::find<64>(data, text.size(), c), expected);
+    }
+
+    std::vector<int> xs(100, 7);
+    xs[77] = 8;
+    EXPECT_EQ(psd::find<16>(xs.data(), xs.size(), 8), 77);
+    EXPECT_EQ(psd::find<16>(xs.data(), 77, 8), 77);
+    EXPECT_EQ(psd::find<16>(xs.data(), 0, 8), 0);
+}
+
+TEST(TestFind, FindIfNot)
+{
+    auto is_digit = [](auto c) { return c >= '0' && c <= '9'; };
+    auto expected = std::find_if_not(text.begin(), text.end(), is_digit) - text.begin();
+
+    EXPECT_EQ(psd::find_if_not<32>(data, text.size(), is_digit), expected);
+
+    std::string digits(100, '5');
+    EXPECT_EQ(psd::find_if_not<32>(digits.data(), digits.size(), is_digit), digits.size());
+}
+
+TEST(TestFind, FindFirstOf)
+{
+    const char set[] { ';', '!', 'W' };
+    auto expected = std::find_first_of(text.begin(), text.end(), set, set + 3) - text.begin();
+
+    EXPECT_EQ(psd::find_first_of<32>(data, text.size(), set, 3), expected);
+    EXPECT_EQ(psd::find_first_of<32>(data, text.size(), set, 2), text.find(';'));
+    EXPECT_EQ(psd::find_first_of<32>(data, text.size(), set, 0), text.size());
+}
+
+TEST(TestFind, Count)
+{
+    for (char c : { '\n', '0', ' ', 'x' })
+        EXPECT_EQ(psd::count<32>(data, text.size(), c), std::count(text.begin(), text.end(), c));
+
+    // More than 255 matches per lane.
+    std::vector<unsigned char> bytes(64 * 1000 + 3, 1);
+    EXPECT_EQ(psd::count<64>(bytes.data(), bytes.size(), static_cast<unsigned char>(1)), bytes.size());
+}
+
+TEST(TestFind, FindAll)
+{
+    std::vector<std::size_t> expected;
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        if (text[i] == ' ')
+            expected.push_back(i);
+    }
+
+    std::vector<std::size_t> positions;
+    psd::find_all<32>(data, text.size(), ' ', [&](std::size_t pos) {
+        positions.push_back(pos);
+    });
+
+    EXPECT_EQ(positions, expected);
+}
+
+TEST(TestFind, Split)
+{
+    std::vector<std::string> lines;
+    psd::split<32>(data, text.size(), '\n', [&](std::size_t begin, std::size_t end) {
+        lines.emplace_back(data + begin, data + end);
+    });
+
+    ASSERT_EQ(lines.size(), 5);
+    EXPECT_EQ(lines[0], "2020-05-01 12:00:01 INFO  started");
+    EXPECT_EQ(lines[2], "");
+    EXPECT_EQ(lines[4], "2020-05-01 12:00:04 INFO  done");
+
+    std::vector<std::pair<std::size_t, std::size_t>> pieces;
+    psd::split<32>(data, 0, '\n', [&](std::size_t begin, std::size_t end) {
+        pieces.emplace_back(begin, end);
+    });
+
+    ASSERT_EQ(pieces.size(), 1);
+    EXPECT_EQ(pieces[0].first, 0);
+    EXPECT_EQ(pieces[0].second, 0);
+}
@@ -0,0 +1,164 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "pure_simd.hpp"
+#include "gtest/gtest.h"
+
+namespace psd = pure_simd;
+
+namespace {
+    // Rounds x * 2^-shift to nearest with ties up, and saturates to Int.
+    template <typename Int>
+    Int reference_product(std::int64_t x, std::int64_t y, unsigned shift)
+    {
+        auto product = std::floor(static_cast<long double>(x * y) / (std::int64_t { 1 } << shift) + 0.5L);
+        product = std::clamp<long double>(product, std::numeric_limits<Int>::min(), std::numeric_limits<Int>::max());
+        return static_cast<Int>(product);
+    }
+
+    template <typename Int>
+    Int reference_sum(std::int64_t x, std::int64_t y)
+    {
+        return static_cast<Int>(std::clamp<std::int64_t>(x + y, std::numeric_limits<Int>::min(), std::numeric_limits<Int>::max()));
+    }
+}
+
+TEST(TestFixed, Conversions)
+{
+    EXPECT_EQ(psd::q15(0.5f).raw(), 16384);
+    EXPECT_EQ(psd::q15(-1.0f).raw(), -32768);
+    EXPECT_EQ(psd::q15(1.0f).raw(), 32767);
+    EXPECT_EQ(psd::q15(-7.0f).raw(), -32768);
+    EXPECT_EQ(psd::q15(std::numeric_limits<float>::quiet_NaN()).raw(), 0);
+    EXPECT_EQ(psd::q15(std::numeric_limits<float>::infinity()).raw(), 32767);
+
+    // Ties round to even.
+    EXPECT_EQ(psd::q15(2.5f / 32768).raw(), 2);
+    EXPECT_EQ(psd::q15(3.5f / 32768).raw(), 4);
+    EXPECT_EQ(psd::q15(-2.5f / 32768).raw(), -2);
+
+    EXPECT_EQ(float(psd::q15::from_raw(-16384)), -0.5f);
+    EXPECT_EQ(float(psd::q15::from_raw(1)), std::ldexp(1.0f, -15));
+    EXPECT_EQ(float(psd::fixed<std::int16_t, 8>(3.25f)), 3.25f);
+    EXPECT_EQ(psd::q7(0.25f).raw(), 32);
+
+    // 32-bit formats go through double without losing bits.
+    EXPECT_EQ(psd::q31(-0.5).raw(), -(1 << 30));
+    EXPECT_EQ(psd::q31(std::ldexp(1.0, -31)).raw(), 1);
+    EXPECT_EQ(double(psd::q31::from_raw(std::numeric_limits<std::int32_t>::max())), 1.0 - std::ldexp(1.0, -31));
+}
+
+TEST(TestFixed, Arithmetic)
+{
+    using psd::q15;
+    using q14 = psd::fixed<std::int16_t, 14>;
+
+    EXPECT_EQ((q15(0.5f) * q15(0.5f)).raw(), 8192);
+    EXPECT_EQ((q15(-1.0f) * q15(-1.0f)).raw(), 32767);
+    EXPECT_EQ((q15(-1.0f) * q15(0.5f)).raw(), -16384);
+    EXPECT_EQ((q15::from_raw(1) * q15(0.5f)).raw(), 1);
+    EXPECT_EQ((q15::from_raw(-1) * q15(0.5f)).raw(), 0);
+
+    // Q14 coefficients reach 2, and the product stays Q15.
+    EXPECT_EQ((q15(0.25f) * q14(1.5f)).raw(), q15(0.375f).raw());
+    EXPECT_EQ((q15(0.75f) * q14(-1.75f)).raw(), -32768);
+
+    EXPECT_EQ((q15(0.75f) + q15(0.5f)).raw(), 32767);
+    EXPECT_EQ((q15(-0.75f) - q15(0.5f)).raw(), -32768);
+    EXPECT_EQ((-q15(-1.0f)).raw(), 32767);
+    EXPECT_TRUE(q15(0.25f) < q15(0.5f));
+    EXPECT_TRUE(q15(0.25f) == q15::from_raw(8192));
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dist(-32768, 32767);
+
+    using V = psd::vector<q15, 32>;
+    using W = psd::vector<q14, 32>;
+    for (int round = 0; round < 20; ++round) {
+        V xs, ys;
+        W cs;
+        for (size_t k = 0; k < V::size(); ++k) {
+            xs[k] = q15::from_raw(static_cast<std::int16_t>(dist(gen)));
+            ys[k] = q15::from_raw(static_cast<std::int16_t>(dist(gen)));
+            cs[k] = q14::from_raw(static_cast<std::int16_t>(dist(gen)));
+        }
+        xs[0] = ys[0] = q15::from_raw(-32768);
+
+        auto products = xs * ys;
+        auto scaled = xs * cs;
+        auto sums = xs + ys;
+        auto differences = xs - ys;
+        for (size_t k = 0; k < V::size(); ++k) {
+            EXPECT_EQ(products[k].raw(), reference_product<std::int16_t>(xs[k].raw(), ys[k].raw(), 15)) << k;
+            EXPECT_EQ(scaled[k].raw(), reference_product<std::int16_t>(xs[k].raw(), cs[k].raw(), 14)) << k;
+            EXPECT_EQ(sums[k].raw(), reference_sum<std::int16_t>(xs[k].raw(), ys[k].raw())) << k;
+            EXPECT_EQ(differences[k].raw(), reference_sum<std::int16_t>(xs[k].raw(), -ys[k].raw())) << k;
+        }
+    }
+
+    psd::vector<psd::q31, 4> xs { psd::q31(-1.0), psd::q31(0.5), psd::q31::from_raw(3), psd::q31(0.75) };
+    psd::vector<psd::q31, 4> ys { psd::q31(-1.0), psd::q31(-0.5), psd::q31(0.5), psd::q31(0.5) };
+    auto products = xs * ys;
+    EXPECT_EQ(products[0].raw(), std::numeric_limits<std::int32_t>::max());
+    EXPECT_EQ(products[1].raw(), psd::q31(-0.25).raw());
+    EXPECT_EQ(products[2].raw(), 2);
+    EXPECT_EQ((xs + ys)[3].raw(), std::numeric_limits<std::int32_t>::max());
+}
+
+TEST(TestFixed, BulkConversions)
+{
+    using V = psd::vector<float, 16>;
+
+    std::vector<float> xs(16 * 5);
+    for (size_t i = 0; i < xs.size(); ++i)
+        xs[i] = -1.25f + 2.5f * i / (xs.size() - 1);
+
+    std::vector<psd::q15> qs(xs.size());
+    for (size_t i = 0; i < xs.size(); i += V::size())
+        psd::store_to(psd::load_from<V>(xs.data() + i), qs.data() + i);
+
+    std::vector<float> back(xs.size());
+    for (size_t i = 0; i < xs.size(); i += V::size())
+        psd::store_to(psd::load_from<V>(qs.data() + i), back.data() + i);
+
+    for (size_t i = 0; i < xs.size(); ++i) {
+        ASSERT_EQ(qs[i].raw(), psd::q15(xs[i]).raw()) << i;
+        ASSERT_NEAR(back[i], std::clamp(xs[i], -1.0f, 32767.0f / 32768), std::ldexp(1.0f, -16)) << i;
+    }
+
+    // transform computes in the lane type.
+    std::vector<psd::q15> halves(qs.size());
+    psd::transform<16>(qs.data(), qs.size(), halves.data(), [](auto x) { return x * psd::q15(0.5f); });
+    for (size_t i = 0; i < qs.size(); ++i)
+        ASSERT_EQ(halves[i].raw(), (qs[i] * psd::q15(0.5f)).raw()) << i;
+
+    std::vector<double> ds { -1.0, -0.123456789, 0.0, 0.999999999 };
+    std::vector<psd::q31> q31s(ds.size());
+    psd::store_to(psd::load_from<psd::vector<double, 4>>(ds.data()), q31s.data());
+    for (size_t i = 0; i < ds.size(); ++i)
+        EXPECT_NEAR(double(q31s[i]), ds[i], std::ldexp(1.0, -31)) << i;
+}
+
+TEST(TestFixed, Fir)
+{
+    std::vector<float> signal(300);
+    for (size_t i = 0; i < signal.size(); ++i)
+        signal[i] = 0.5f * std::sin(0.1f * i);
+    std::vector<float> taps { 0.1f, 0.2f, 0.4f, 0.2f, 0.1f };
+
+    std::vector<float> expected(signal.size());
+    psd::fir<8>(signal.data(), signal.size(), taps.data(), taps.size(), expected.data());
+
+    std::vector<psd::q15> qsignal(signal.begin(), signal.end());
+    std::vector<psd::q15> qtaps(taps.begin(), taps.end());
+    std::vector<psd::q15> out(signal.size());
+    psd::fir<16>(qsignal.data(), qsignal.size(), qtaps.data(), qtaps.size(), out.data());
+
+    // Each tap rounds once, and the inputs once.
+    for (size_t i = 0; i < signal.size(); ++i)
+        ASSERT_NEAR(float(out[i]), expected[i], 8.0f / 32768) << i;
+}
@@ -0,0 +1,111 @@
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "pure_simd.hpp"
+#include "gtest/gtest.h"
+
+namespace psd = pure_simd;
+
+namespace {
+    template <typename T>
+    std::vector<T> random_values(size_t n, unsigned seed)
+    {
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<float> dist(-4.0f, 4.0f);
+
+        std::vector<T> xs(n);
+        for (auto& x : xs)
+            x = T(dist(gen));
+        return xs;
+    }
+}
+
+TEST(TestFloat16, Float16Conversions)
+{
+    EXPECT_EQ(psd::float16(1.0f).bits(), 0x3c00);
+    EXPECT_EQ(psd::float16(-2.0f).bits(), 0xc000);
+    EXPECT_EQ(psd::float16(65504.0f).bits(), 0x7bff);
+    EXPECT_EQ(psd::float16(65520.0f).bits(), 0x7c00);
+    EXPECT_EQ(psd::float16(std::ldexp(1.0f, -24)).bits(), 0x0001);
+
+    // Ties round to even.
+    EXPECT_EQ(psd::float16(1.0f + std::ldexp(1.0f, -11)).bits(), 0x3c00);
+    EXPECT_EQ(psd::float16(1.0f + 3 * std::ldexp(1.0f, -11)).bits(), 0x3c02);
+
+    EXPECT_EQ(float(psd::float16::from_bits(0x0001)), std::ldexp(1.0f, -24));
+    EXPECT_EQ(float(psd::float16::from_bits(0xfc00)), -std::numeric_limits<float>::infinity());
+    EXPECT_TRUE(std::isnan(float(psd::float16::from_bits(0x7e00))));
+
+    // Every half converts to float and back unchanged, by either path.
+    for (std::uint32_t bits = 0; bits <= 0xffff; ++bits) {
+        auto half = static_cast<std::uint16_t>(bits);
+        float x = psd::float16::from_bits(half);
+        EXPECT_EQ(psd::detail::bits_of_float(psd::detail::half_to_float(half)), psd::detail::bits_of_float(x)) << bits;
+
+        if (!std::isnan(x)) {
+            EXPECT_EQ(psd::float16(x).bits(), half) << bits;
+            EXPECT_EQ(psd::detail::float_to_half(x), half) << bits;
+        }
+    }
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<std::uint32_t> dist;
+    for (int i = 0; i < 100'000; ++i) {
+        float x = psd::detail::float_of_bits(dist(gen));
+        if (!std::isnan(x)) {
+            EXPECT_EQ(psd::detail::float_to_half(x), psd::float16(x).bits()) << x;
+        }
+    }
+}
+
+TEST(TestFloat16, BFloat16Conversions)
+{
+    EXPECT_EQ(psd::bfloat16(1.0f).bits(), 0x3f80);
+    EXPECT_EQ(psd::bfloat16(psd::detail::float_of_bits(0x3f808000)).bits(), 0x3f80);
+    EXPECT_EQ(psd::bfloat16(psd::detail::float_of_bits(0x3f818000)).bits(), 0x3f82);
+    EXPECT_EQ(psd::bfloat16(psd::detail::float_of_bits(0x3f808001)).bits(), 0x3f81);
+    EXPECT_TRUE(std::isnan(float(psd::bfloat16(std::numeric_limits<float>::quiet_NaN()))));
+    EXPECT_EQ(float(psd::bfloat16::from_bits(0xc040)), -3.0f);
+}
+
+TEST(TestFloat16, LoadAndStore)
+{
+    using fvec = psd::vector<float, 8>;
+
+    auto halves = random_values<psd::float16>(8, 1);
+    auto xs = psd::load_from<fvec>(halves.data());
+    for (size_t i = 0; i < 8; ++i)
+        EXPECT_EQ(xs[i], float(halves[i]));
+
+    std::vector<psd::bfloat16> brains(8);
+    psd::store_to(xs, brains.data());
+    for (size_t i = 0; i < 8; ++i)
+        EXPECT_EQ(brains[i].bits(), psd::bfloat16(xs[i]).bits());
+}
+
+TEST(TestFloat16, Algorithms)
+{
+    const size_t n = 1003;
+    auto halves = random_values<psd::float16>(n, 1);
+    auto brains = random_values<psd::bfloat16>(n, 2);
+
+    std::vector<float> wide_halves(halves.begin(), halves.end());
+    std::vector<float> wide_brains(brains.begin(), brains.end());
+
+    auto expected = psd::inner_product<16>(wide_halves.data(), n, wide_brains.data(), 0.0f);
+    auto actual = psd::inner_product<16>(halves.data(), n, brains.data(), 0.0f);
+    for (size_t i = 0; i < 16; ++i)
+        EXPECT_NEAR(actual[i], expected[i], 1e-4f);
+
+    auto sums = psd::accumulate<16>(halves.data(), n, 0.0f);
+    auto expected_sums = psd::accumulate<16>(wide_halves.data(), n, 0.0f);
+    EXPECT_TRUE(psd::all(sums == expected_sums));
+
+    std::vector<psd::float16> doubled(n);
+    psd::transform<16>(halves.data(), n, doubled.data(), [](auto x) { return x + x; });
+    for (size_t i = 0; i < n; ++i)
+        EXPECT_EQ(float(doubled[i]), 2 * float(halves[i]));
+}
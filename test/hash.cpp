@@ -0,0 +1,178 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include "pure_simd.hpp"
+#include "gtest/gtest.h"
+
+namespace psd = pure_simd;
+
+namespace {
+    template <typename T>
+    T rotl(T x, int r)
+    {
+        return static_cast<T>(x << r | x >> (8 * sizeof(T) - r));
+    }
+
+    // XXH32 of a message shorter than 16 bytes.
+    std::uint32_t xxh32(const void* data, std::size_t len)
+    {
+        auto p = static_cast<const unsigned char*>(data);
+
+        std::uint32_t h = 0x165667b1u + static_cast<std::uint32_t>(len);
+        for (; len >= 4; p += 4, len -= 4) {
+            std::uint32_t word;
+            std::memcpy(&word, p, 4);
+            h = rotl(h + word * 0xc2b2ae3du, 17) * 0x27d4eb2fu;
+        }
+        for (; len > 0; ++p, --len)
+            h = rotl(h + *p * 0x165667b1u, 11) * 0x9e3779b1u;
+
+        h = (h ^ h >> 15) * 0x85ebca77u;
+        h = (h ^ h >> 13) * 0xc2b2ae3du;
+        return h ^ h >> 16;
+    }
+
+    // XXH64 of a message shorter than 32 bytes.
+    std::uint64_t xxh64(const void* data, std::size_t len)
+    {
+        auto p = static_cast<const unsigned char*>(data);
+
+        std::uint64_t h = 0x27d4eb2f165667c5ull + len;
+        for (; len >= 8; p += 8, len -= 8) {
+            std::uint64_t word;
+            std::memcpy(&word, p, 8);
+            h ^= rotl(word * 0xc2b2ae3d27d4eb4full, 31) * 0x9e3779b185ebca87ull;
+            h = rotl(h, 27) * 0x9e3779b185ebca87ull + 0x85ebca77c2b2ae63ull;
+        }
+        for (; len > 0; ++p, --len)
+            h = rotl(h ^ *p * 0x27d4eb2f165667c5ull, 11) * 0x9e3779b185ebca87ull;
+
+        h = (h ^ h >> 33) * 0xc2b2ae3d27d4eb4full;
+        h = (h ^ h >> 29) * 0x165667b19e3779f9ull;
+        return h ^ h >> 32;
+    }
+
+    template <typename T>
+    std::vector<T> random_keys(std::size_t n, std::uint64_t range)
+    {
+        std::mt19937_64 gen(42);
+
+        std::vector<T> xs(n);
+        for (auto& x : xs)
+            x = static_cast<T>(gen() % range + 1);
+        return xs;
+    }
+
+    template <std::size_t VectorSize, typename Hash, typename T>
+    void check_vector_hash(Hash hash)
+    {
+        using KeyVec = psd::vector<T, VectorSize>;
+
+        auto keys = random_keys<T>(VectorSize, ~std::uint64_t { 0 });
+        auto hashes = hash(psd::load_from<KeyVec>(keys.data()));
+        for (std::size_t i = 0; i < VectorSize; ++i)
+            EXPECT_EQ(hashes[i], hash(keys[i]));
+    }
+}
+
+TEST(TestHash, Hashers)
+{
+    EXPECT_EQ(xxh32(nullptr, 0), 0x02cc5d05u);
+    EXPECT_EQ(xxh64(nullptr, 0), 0xef46db3751d8e999ull);
+
+    for (auto key : random_keys<std::uint32_t>(100, ~std::uint64_t { 0 }))
+        EXPECT_EQ(psd::xxhash_mix {}(key), xxh32(&key, sizeof(key)));
+    for (auto key : random_keys<std::uint64_t>(100, ~std::uint64_t { 0 }))
+        EXPECT_EQ(psd::xxhash_mix {}(key), xxh64(&key, sizeof(key)));
+
+    EXPECT_EQ(psd::multiply_shift {}(std::uint32_t { 1 }), 0x9e3779b9u);
+    EXPECT_EQ(psd::murmur3_mix {}(std::uint64_t { 0 }), 0u);
+
+    check_vector_hash<8, psd::multiply_shift, std::uint32_t>({});
+    check_vector_hash<16, psd::murmur3_mix, std::uint32_t>({});
+    check_vector_hash<4, psd::murmur3_mix, std::uint64_t>({});
+    check_vector_hash<8, psd::xxhash_mix, std::uint64_t>({});
+}
+
+TEST(TestHash, HashBatch)
+{
+    auto keys = random_keys<std::uint64_t>(1003, ~std::uint64_t { 0 });
+
+    std::vector<std::uint64_t> hashes(keys.size());
+    psd::hash_batch<8>(keys.data(), keys.size(), hashes.data());
+    for (std::size_t i = 0; i < keys.size(); ++i)
+        ASSERT_EQ(hashes[i], psd::murmur3_mix {}(keys[i]));
+
+    auto narrow = random_keys<std::uint32_t>(1003, ~std::uint32_t { 0 });
+    std::vector<std::uint32_t> narrow_hashes(narrow.size());
+    psd::hash_batch<16>(narrow.data(), narrow.size(), narrow_hashes.data(), psd::xxhash_mix {});
+    for (std::size_t i = 0; i < narrow.size(); ++i)
+        ASSERT_EQ(narrow_hashes[i], psd::xxhash_mix {}(narrow[i]));
+}
+
+TEST(TestHash, MatchGroup)
+{
+    std::uint32_t group[16] = { 5, 0, 7, 5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 5 };
+    EXPECT_EQ(psd::match_group<16>(group, 5u), 0b1000000000001001u);
+    EXPECT_EQ(psd::match_group<16>(group, 7u), 0b100u);
+    EXPECT_EQ(psd::match_group<8>(group, 9u), 0u);
+}
+
+TEST(TestHash, HashTable)
+{
+    // Keys repeat, so that insert meets keys that are already in the table.
+    auto keys = random_keys<std::uint64_t>(3000, 2000);
+    auto absent = random_keys<std::uint64_t>(1000, 2000);
+    for (auto& key : absent)
+        key += 2000;
+
+    std::vector<std::uint64_t> table(4096, 0);
+    std::vector<std::size_t> slots(keys.size());
+    psd::hash_table_insert<8>(table.data(), table.size(), std::uint64_t { 0 }, keys.data(), keys.size(), slots.data());
+
+    std::unordered_map<std::uint64_t, std::size_t> expected;
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        ASSERT_EQ(table[slots[i]], keys[i]);
+        ASSERT_EQ(expected.emplace(keys[i], slots[i]).first->second, slots[i]);
+    }
+    EXPECT_EQ(std::count(table.begin(), table.end(), 0u), static_cast<std::ptrdiff_t>(table.size() - expected.size()));
+
+    std::vector<std::size_t> found(keys.size());
+    psd::hash_table_find<8>(table.data(), table.size(), std::uint64_t { 0 }, keys.data(), keys.size(), found.data());
+    EXPECT_EQ(found, slots);
+
+    psd::hash_table_find<8>(table.data(), table.size(), std::uint64_t { 0 }, absent.data(), absent.size(), found.data());
+    for (std::size_t i = 0; i < absent.size(); ++i)
+        ASSERT_EQ(found[i], table.size());
+}
+
+TEST(TestHash, HashTableLimits)
+{
+    // A single group of 16 slots, filled completely.
+    std::vector<std::uint32_t> keys(17);
+    std::iota(keys.begin(), keys.end(), 1u);
+
+    std::vector<std::uint32_t> table(16, 0);
+    std::vector<std::size_t> slots(keys.size());
+    psd::hash_table_insert<16>(table.data(), table.size(), 0u, keys.data(), 16, slots.data(), psd::xxhash_mix {});
+    for (std::size_t i = 0; i < 16; ++i)
+        EXPECT_EQ(slots[i], i);
+
+    psd::hash_table_find<16>(table.data(), table.size(), 0u, keys.data(), keys.size(), slots.data(), psd::xxhash_mix {});
+    EXPECT_EQ(slots[3], 3u);
+    EXPECT_EQ(slots[16], table.size());
+
+    EXPECT_THROW(psd::hash_table_insert<16>(table.data(), table.size(), 0u, keys.data() + 16, 1, slots.data()), std::length_error);
+
+    std::uint32_t empty_key = 0;
+    std::vector<std::uint32_t> other(32, 0);
+    EXPECT_THROW(psd::hash_table_insert<16>(other.data(), other.size(), 0u, &empty_key, 1, slots.data()), std::invalid_argument);
+    EXPECT_THROW(psd::hash_table_insert<16>(other.data(), 24, 0u, keys.data(), 1, slots.data()), std::invalid_argument);
+    EXPECT_THROW(psd::hash_table_find<16>(other.data(), 48, 0u, keys.data(), 1, slots.data()), std::invalid_argument);
+}
@@ -0,0 +1,119 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "pure_simd.hpp"
+#include "gtest/gtest.h"
+
+namespace psd = pure_simd;
+
+namespace {
+    template <typename T>
+    std::vector<size_t> reference_histogram(const std::vector<T>& keys, size_t bins)
+    {
+        std::vector<size_t> out(bins);
+        for (auto key : keys) {
+            if (key >= 0 && static_cast<size_t>(key) < bins)
+                ++out[key];
+        }
+        return out;
+    }
+
+    template <typename T>
+    std::vector<T> random_keys(size_t n, int lo, int hi)
+    {
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<int> dist(lo, hi);
+
+        std::vector<T> keys(n);
+        for (auto& key : keys)
+            key = static_cast<T>(dist(gen));
+        return keys;
+    }
+}
+
+TEST(TestHistogram, Uniform)
+{
+    for (size_t n : { 0, 1, 15, 16, 17, 1000, 4099 }) {
+        auto keys = random_keys<std::uint8_t>(n, 0, 255);
+        std::vector<size_t> out(256, 12345);
+
+        psd::histogram<16>(keys.data(), keys.size(), out.size(), out.data());
+        EXPECT_EQ(out, reference_histogram(keys, 256)) << n;
+    }
+}
+
+TEST(TestHistogram, Skewed)
+{
+    std::vector<std::uint16_t> keys(1000, 7);
+    keys[500] = 3;
+
+    std::vector<size_t> out(8);
+    psd::histogram<8>(keys.data(), keys.size(), out.size(), out.data());
+
+    EXPECT_EQ(out, (std::vector<size_t> { 0, 0, 0, 1, 0, 0, 0, 999 }));
+}
+
+TEST(TestHistogram, OutOfRange)
+{
+    auto keys = random_keys<std::int32_t>(1001, -100, 100);
+    std::vector<size_t> out(50);
+
+    psd::histogram<8>(keys.data(), keys.size(), out.size(), out.data());
+    EXPECT_EQ(out, reference_histogram(keys, 50));
+
+    auto wide_keys = random_keys<std::uint16_t>(1001, 0, 65535);
+    std::vector<size_t> wide_out(1000);
+
+    psd::histogram<4>(wide_keys.data(), wide_keys.size(), wide_out.size(), wide_out.data());
+    EXPECT_EQ(wide_out, reference_histogram(wide_keys, 1000));
+}
+
+TEST(TestHistogram, Threads)
+{
+    auto keys = random_keys<std::uint8_t>(100003, 0, 255);
+    auto expected = reference_histogram(keys, 200);
+
+    for (size_t threads : { 1, 2, 3, 8 }) {
+        std::vector<size_t> out(200);
+        psd::histogram<16>(keys.data(), keys.size(), out.size(), out.data(), threads);
+        EXPECT_EQ(out, expected) << threads;
+    }
+
+    std::vector<size_t> out(200, 1);
+    psd::histogram<16>(keys.data(), 5, out.size(), out.data(), 4);
+    EXPECT_EQ(out, reference_histogram(std::vector<std::uint8_t>(keys.begin(), keys.begin() + 5), 200));
+}
+
+TEST(TestHistogram, ParallelSlices)
+{
+    for (size_t n : { 0, 5, 8, 100, 1003 }) {
+        std::vector<int> owners(n, -1);
+        psd::detail::parallel_slices<8>(n, 4, [&](size_t t, size_t begin, size_t size) {
+            if (begin + size < n) {
+                EXPECT_EQ(size % 8, 0u) << n;
+            }
+            for (size_t i = begin; i < begin + size; ++i)
+                owners[i] = static_cast<int>(t);
+        });
+
+        EXPECT_EQ(std::count(owners.begin(), owners.end(), -1), 0) << n;
+        EXPECT_TRUE(std::is_sorted(owners.begin(), owners.end())) << n;
+    }
+
+    // The other slices still run to the end when the caller's slice throws.
+    std::atomic<size_t> done { 0 };
+    auto slice = [&](size_t, size_t begin, size_t size) {
+        if (begin + size == 1000)
+            throw std::runtime_error("last slice");
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        ++done;
+    };
+    EXPECT_THROW(psd::detail::parallel_slices<8>(1000, 4, slice), std::runtime_error);
+    EXPECT_EQ(done, 3u);
+}
@@ -0,0 +1,157 @@
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "image.hpp"
+
+namespace {
+    std::vector<std::uint32_t> random_pixels(std::size_t n, bool premultiplied)
+    {
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<std::uint32_t> dist;
+
+        std::vector<std::uint32_t> pixels(n);
+        for (auto& pixel : pixels) {
+            pixel = dist(gen);
+            if (premultiplied) {
+                std::uint32_t alpha = pixel >> 24;
+                std::uint32_t r = (pixel & 0xff) * alpha / 255;
+                std::uint32_t g = ((pixel >> 8) & 0xff) * alpha / 255;
+                std::uint32_t b = ((pixel >> 16) & 0xff) * alpha / 255;
+                pixel = r | (g << 8) | (b << 16) | (alpha << 24);
+            }
+        }
+        return pixels;
+    }
+
+    int channel(std::uint32_t pixel, int c) { return (pixel >> (8 * c)) & 0xff; }
+}
+
+TEST(TestImage, Blend)
+{
+    for (std::size_t n : { 1, 7, 8, 33, 1000 }) {
+        auto src = random_pixels(n, true);
+        auto dst = random_pixels(n + 1, true);
+        dst.erase(dst.begin());
+
+        auto expected = dst;
+        scalar_blend(src.data(), n, expected.data());
+
+        auto actual = dst;
+        pure_simd_blend<16>(src.data(), n, actual.data());
+        EXPECT_EQ(actual, expected) << n;
+    }
+
+    std::uint32_t opaque = 0xff102030, transparent = 0, half = 0x80402010, background = 0xff80c0ff;
+
+    std::vector<std::uint32_t> dst { background, background, background };
+    std::vector<std::uint32_t> src { opaque, transparent, half };
+    scalar_blend(src.data(), src.size(), dst.data());
+
+    EXPECT_EQ(dst[0], opaque);
+    EXPECT_EQ(dst[1], background);
+    EXPECT_EQ(dst[2], 0xff80808fu);
+}
+
+TEST(TestImage, Premultiply)
+{
+    auto src = random_pixels(1001, false);
+
+    std::vector<std::uint32_t> expected(src.size()), actual(src.size());
+    scalar_premultiply(src.data(), src.size(), expected.data());
+    pure_simd_premultiply<8>(src.data(), src.size(), actual.data());
+    EXPECT_EQ(actual, expected);
+
+    for (std::size_t i = 0; i < src.size(); ++i) {
+        int alpha = channel(src[i], 3);
+        EXPECT_EQ(channel(expected[i], 3), alpha);
+        for (int c = 0; c < 3; ++c)
+            EXPECT_NEAR(channel(expected[i], c), channel(src[i], c) * alpha / 255.0, 0.5);
+    }
+}
+
+TEST(TestImage, Gray)
+{
+    auto src = random_pixels(1001, false);
+    src[0] = 0xffffffff;
+    src[1] = 0xff000000;
+
+    std::vector<std::uint8_t> expected(src.size()), actual(src.size());
+    scalar_rgba_to_gray(src.data(), src.size(), expected.data());
+    pure_simd_rgba_to_gray<32>(src.data(), src.size(), actual.data());
+
+    EXPECT_EQ(actual, expected);
+    EXPECT_EQ(expected[0], 255);
+    EXPECT_EQ(expected[1], 0);
+}
+
+TEST(TestImage, YuvRoundTrip)
+{
+    const std::size_t n = 1001;
+    auto src = random_pixels(n, false);
+
+    std::vector<std::uint8_t> y(n), u(n), v(n), y2(n), u2(n), v2(n);
+    scalar_rgba_to_yuv(src.data(), n, y.data(), u.data(), v.data());
+    pure_simd_rgba_to_yuv<16>(src.data(), n, y2.data(), u2.data(), v2.data());
+    EXPECT_EQ(y, y2);
+    EXPECT_EQ(u, u2);
+    EXPECT_EQ(v, v2);
+
+    std::vector<std::uint32_t> expected(n), actual(n);
+    scalar_yuv_to_rgba(y.data(), u.data(), v.data(), n, expected.data());
+    pure_simd_yuv_to_rgba<16>(y.data(), u.data(), v.data(), n, actual.data());
+    EXPECT_EQ(actual, expected);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        EXPECT_EQ(channel(actual[i], 3), 255);
+        for (int c = 0; c < 3; ++c)
+            EXPECT_LE(std::abs(channel(actual[i], c) - channel(src[i], c)), 3) << i;
+    }
+}
+
+TEST(TestImage, ResizeBilinear)
+{
+    const std::size_t width = 67, height = 41;
+    auto src = random_pixels(width * height, false);
+
+    std::vector<std::uint32_t> same(width * height);
+    pure_simd_resize_bilinear<8>(src.data(), width, height, same.data(), width, height);
+    EXPECT_EQ(same, src);
+
+    for (auto [w, h] : { std::pair { 34, 21 }, std::pair { 50, 40 }, std::pair { 1, 1 }, std::pair { 17, 3 } }) {
+        std::vector<std::uint32_t> expected(w * h), actual(w * h);
+        scalar_resize_bilinear(src.data(), width, height, expected.data(), w, h);
+        pure_simd_resize_bilinear<8>(src.data(), width, height, actual.data(), w, h);
+        EXPECT_EQ(actual, expected) << w << "x" << h;
+    }
+
+    std::vector<std::uint32_t> flat(width * height, 0x80402010), small(20 * 10);
+    pure_simd_resize_bilinear<16>(flat.data(), width, height, small.data(), 20, 10);
+    EXPECT_EQ(small, std::vector<std::uint32_t>(20 * 10, 0x80402010));
+}
+
+TEST(TestImage, Rgb)
+{
+    const std::size_t n = 1001;
+    auto src = random_pixels(n, false);
+
+    std::vector<std::uint8_t> rgb(3 * n);
+    rgba_to_rgb(src.data(), n, rgb.data());
+    for (std::size_t i = 0; i < n; ++i)
+        for (int c = 0; c < 3; ++c)
+            ASSERT_EQ(rgb[3 * i + c], channel(src[i], c)) << i;
+
+    std::vector<std::uint32_t> rgba(n);
+    rgb_to_rgba(rgb.data(), n, rgba.data());
+    for (std::size_t i = 0; i < n; ++i)
+        ASSERT_EQ(rgba[i], src[i] | 0xff000000u) << i;
+
+    // An RGB image goes through the RGBA kernels.
+    std::vector<std::uint8_t> expected(n), actual(n);
+    scalar_rgba_to_gray(rgba.data(), n, expected.data());
+    pure_simd_rgba_to_gray<16>(rgba.data(), n, actual.data());
+    EXPECT_EQ(actual, expected);
+}
@@ -0,0 +1,102 @@
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "mandelbrot.hpp"
+#include "pure_simd.hpp"
+
+#define BUFFER_SIZE (MANDELBROT_WIDTH * MANDELBROT_HEIGHT)
+
+namespace psd = pure_simd;
+
+TEST(TestMandelbrot, AnyAllNone)
+{
+    using mvec = psd::vector<bool, 4>;
+
+    EXPECT_TRUE(psd::any(mvec { false, false, true, false }));
+    EXPECT_FALSE(psd::any(mvec {}));
+    EXPECT_TRUE(psd::all(mvec { true, true, true, true }));
+    EXPECT_FALSE(psd::all(mvec { true, false, true, true }));
+    EXPECT_TRUE(psd::none(mvec {}));
+}
+
+TEST(TestMandelbrot, WhileAny)
+{
+    using ivec = psd::vector<int, 4>;
+
+    // Counts every lane down to zero and freezes it there.
+    ivec xs { 3, 0, 5, 1 };
+    ivec steps {};
+
+    auto nonzero = [](ivec xs) { return psd::unroll(xs, [](int x) { return -static_cast<int>(x != 0); }); };
+
+    auto iterations = psd::while_any(nonzero(xs), [&](ivec active) {
+        xs = xs + active;
+        steps = steps - active;
+        return nonzero(xs);
+    });
+
+    EXPECT_EQ(iterations, 5);
+    EXPECT_TRUE(psd::all(xs == psd::scalar<ivec>(0)));
+    EXPECT_TRUE(psd::all(steps == ivec { 3, 0, 5, 1 }));
+}
+
+TEST(TestMandelbrot, MaskedLoop)
+{
+    using ivec = psd::vector<int, 4>;
+
+    // Item i needs i % 7 + 1 steps.
+    std::vector<int> results(23, -1);
+    ivec remaining {};
+    ivec steps {};
+
+    psd::masked_loop<4>(
+        results.size(),
+        [&](std::size_t lane, std::size_t item) {
+            remaining[lane] = item % 7 + 1;
+            steps[lane] = 0;
+        },
+        [&](ivec) {
+            remaining = remaining - psd::scalar<ivec>(1);
+            steps = steps + psd::scalar<ivec>(1);
+            return psd::unroll(remaining, [](int r) { return -static_cast<int>(r > 0); });
+        },
+        [&](std::size_t lane, std::size_t item) {
+            EXPECT_EQ(results[item], -1);
+            results[item] = steps[lane];
+        });
+
+    for (std::size_t i = 0; i < results.size(); ++i)
+        EXPECT_EQ(results[i], static_cast<int>(i % 7 + 1));
+
+    psd::masked_loop<4>(
+        0, [](std::size_t, std::size_t) { FAIL(); },
+        [](ivec active) { return active; },
+        [](std::size_t, std::size_t) { FAIL(); });
+}
+
+TEST(TestMandelbrot, PureSIMD)
+{
+    std::vector<int> buffer(BUFFER_SIZE, -1);
+    scalar_mandelbrot(buffer.data());
+
+#define TEST_FUNCTION_OF_SIZE(func_name, size)          \
+    {                                                   \
+        std::vector<int> buffer##size(BUFFER_SIZE, -1); \
+                                                        \
+        func_name<size>(buffer##size.data());           \
+                                                        \
+        for (std::size_t i = 0; i < BUFFER_SIZE; ++i) { \
+            EXPECT_EQ(buffer[i], buffer##size[i]) << i; \
+        }                                               \
+    }
+
+    TEST_FUNCTION_OF_SIZE(pure_simd_mandelbrot, 4)
+    TEST_FUNCTION_OF_SIZE(pure_simd_mandelbrot, 8)
+    TEST_FUNCTION_OF_SIZE(pure_simd_mandelbrot, 16)
+    TEST_FUNCTION_OF_SIZE(pure_simd_mandelbrot, 32)
+    TEST_FUNCTION_OF_SIZE(pure_simd_mandelbrot_persistent, 4)
+    TEST_FUNCTION_OF_SIZE(pure_simd_mandelbrot_persistent, 8)
+    TEST_FUNCTION_OF_SIZE(pure_simd_mandelbrot_persistent, 16)
+    TEST_FUNCTION_OF_SIZE(pure_simd_mandelbrot_persistent, 32)
+}
@@ -0,0 +1,125 @@
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "pure_simd.hpp"
+#include "gtest/gtest.h"
+
+namespace psd = pure_simd;
+
+namespace {
+    double reference_polynomial(double x, const std::vector<double>& cs)
+    {
+        double sum = 0;
+        for (std::size_t k = 0; k < cs.size(); ++k)
+            sum += cs[k] * std::pow(x, k);
+        return sum;
+    }
+
+    // Samples of sin from 0 to 4.
+    std::vector<float> sine_table(std::size_t size)
+    {
+        std::vector<float> table(size);
+        for (std::size_t i = 0; i < size; ++i)
+            table[i] = std::sin(4.0f * i / (size - 1));
+        return table;
+    }
+}
+
+TEST(TestPolynomial, HornerAndEstrin)
+{
+    std::vector<double> cs { 1.5, -2.0, 0.25, 3.0, -0.5, 0.125, 1.0, -1.0 };
+
+    for (double x : { -1.5, -0.3, 0.0, 0.7, 2.0 }) {
+        auto expected = reference_polynomial(x, cs);
+        EXPECT_NEAR(psd::horner(x, 1.5, -2.0, 0.25, 3.0, -0.5, 0.125, 1.0, -1.0), expected, 1e-12) << x;
+        EXPECT_NEAR(psd::estrin(x, 1.5, -2.0, 0.25, 3.0, -0.5, 0.125, 1.0, -1.0), expected, 1e-12) << x;
+        EXPECT_NEAR(psd::estrin(x, 1.5, -2.0, 0.25, 3.0, -0.5), psd::horner(x, 1.5, -2.0, 0.25, 3.0, -0.5), 1e-12) << x;
+    }
+
+    EXPECT_EQ(psd::horner(2, 7), 7);
+    EXPECT_EQ(psd::estrin(2, 7), 7);
+    EXPECT_EQ(psd::horner(3, 1, 2, 1), 16);
+    EXPECT_EQ(psd::estrin(3, 1, 2, 1), 16);
+
+    auto xs = psd::iota<psd::vector<float, 8>>(-1.0f, 0.25f);
+    auto hs = psd::horner(xs, 1.0, 0.5, -0.25, 2.0);
+    auto es = psd::estrin(xs, 1.0, 0.5, -0.25, 2.0);
+    for (std::size_t k = 0; k < xs.size(); ++k) {
+        EXPECT_FLOAT_EQ(hs[k], static_cast<float>(reference_polynomial(xs[k], { 1.0, 0.5, -0.25, 2.0 }))) << k;
+        EXPECT_FLOAT_EQ(es[k], hs[k]) << k;
+    }
+}
+
+TEST(TestPolynomial, LutInterpolate)
+{
+    std::vector<float> table { 0.0f, 1.0f, 4.0f, 9.0f, 16.0f };
+
+    // The samples themselves, and the interpolation between them.
+    for (std::size_t i = 0; i < table.size(); ++i) {
+        EXPECT_EQ(psd::lut_interpolate(table.data(), table.size(), 0.0f, 8.0f, 2.0f * i), table[i]) << i;
+        EXPECT_FLOAT_EQ(psd::lut_interpolate<psd::interpolation::cubic>(table.data(), table.size(), 0.0f, 8.0f, 2.0f * i), table[i]) << i;
+    }
+    EXPECT_FLOAT_EQ(psd::lut_interpolate(table.data(), table.size(), 0.0f, 8.0f, 3.0f), 2.5f);
+    EXPECT_FLOAT_EQ(psd::lut_interpolate(table.data(), table.size(), 0.0f, 8.0f, 6.5f), 10.75f);
+
+    // Catmull-Rom reproduces quadratics away from the borders.
+    EXPECT_FLOAT_EQ(psd::lut_interpolate<psd::interpolation::cubic>(table.data(), table.size(), 0.0f, 8.0f, 3.0f), 2.25f);
+    EXPECT_FLOAT_EQ(psd::lut_interpolate<psd::interpolation::cubic>(table.data(), table.size(), 0.0f, 8.0f, 4.5f), 5.0625f);
+
+    // Clamped outside the table, NaN reads as low.
+    EXPECT_EQ(psd::lut_interpolate(table.data(), table.size(), 0.0f, 8.0f, -5.0f), 0.0f);
+    EXPECT_EQ(psd::lut_interpolate(table.data(), table.size(), 0.0f, 8.0f, 100.0f), 16.0f);
+    EXPECT_EQ(psd::lut_interpolate<psd::interpolation::cubic>(table.data(), table.size(), 0.0f, 8.0f, 1e30f), 16.0f);
+    EXPECT_EQ(psd::lut_interpolate(table.data(), table.size(), 0.0f, 8.0f, std::numeric_limits<float>::quiet_NaN()), 0.0f);
+
+    auto sines = sine_table(1025);
+    auto xs = psd::iota<psd::vector<float, 16>>(-0.1f, 0.27f);
+    auto linear = psd::lut_interpolate(sines.data(), sines.size(), 0.0f, 4.0f, xs);
+    auto cubic = psd::lut_interpolate<psd::interpolation::cubic>(sines.data(), sines.size(), 0.0f, 4.0f, xs);
+    for (std::size_t k = 0; k < xs.size(); ++k) {
+        float expected = std::sin(std::clamp(xs[k], 0.0f, 4.0f));
+        EXPECT_NEAR(linear[k], expected, 2e-6f) << k;
+        EXPECT_NEAR(cubic[k], expected, 1e-6f) << k;
+    }
+}
+
+TEST(TestPolynomial, Calibrate)
+{
+    // Two quadratic segments over [0, 100): 1 + u^2 and 2 + 2u, with u the
+    // position within the segment.
+    std::vector<double> coefficients { 1.0, 0.0, 1.0, 2.0, 2.0, 0.0 };
+    psd::piecewise_polynomial<2, double> curve { coefficients.data(), 2, 0.0, 100.0 };
+
+    std::vector<std::uint16_t> counts(1003);
+    for (std::size_t i = 0; i < counts.size(); ++i)
+        counts[i] = static_cast<std::uint16_t>(i % 120);
+
+    auto expected = [](double x) {
+        double u = x / 50.0;
+        return x < 50.0 ? 1.0 + u * u : 2.0 + 2.0 * (u - 1.0);
+    };
+
+    for (std::size_t threads : { 1, 3 }) {
+        std::vector<double> out(counts.size());
+        psd::calibrate<8>(counts.data(), counts.size(), out.data(), curve, threads);
+        for (std::size_t i = 0; i < counts.size(); ++i)
+            ASSERT_DOUBLE_EQ(out[i], expected(counts[i])) << i;
+    }
+
+    // Before low, the first polynomial continues.
+    EXPECT_DOUBLE_EQ(curve(-50.0), 2.0);
+
+    auto sines = sine_table(257);
+    std::vector<float> xs(100);
+    for (std::size_t i = 0; i < xs.size(); ++i)
+        xs[i] = 0.04f * i;
+
+    std::vector<float> out(xs.size());
+    psd::calibrate<16>(xs.data(), xs.size(), out.data(), [&](float x) {
+        return psd::lut_interpolate<psd::interpolation::cubic>(sines.data(), sines.size(), 0.0f, 4.0f, x);
+    });
+    for (std::size_t i = 0; i < xs.size(); ++i)
+        EXPECT_NEAR(out[i], std::sin(xs[i]), 1e-5f) << i;
+}
@@ -0,0 +1,85 @@
+#include <numeric>
+#include <vector>
+
+#include "pure_simd.hpp"
+#include "gtest/gtest.h"
+
+namespace psd = pure_simd;
+
+namespace {
+    const psd::prefetch_options every_options[] = {
+        {},
+        psd::prefetch_bytes(1),
+        psd::prefetch_bytes(256, true, 0),
+        psd::prefetch_vectors(4, false, 1),
+        psd::prefetch_vectors(1000),
+    };
+}
+
+TEST(TestPrefetch, Transform)
+{
+    for (size_t n : { 0, 5, 64, 1003 }) {
+        std::vector<int> xs(n), ys(n);
+        std::iota(xs.begin(), xs.end(), -100);
+        std::iota(ys.rbegin(), ys.rend(), 7);
+
+        std::vector<int> expected(n), expected2(n);
+        auto square = [](int x) { return x * x; };
+        auto subtract = [](int x, int y) { return x - y; };
+        psd::transform<8>(xs.data(), n, expected.data(), square);
+        psd::transform<8>(xs.data(), n, ys.data(), expected2.data(), subtract);
+
+        for (auto options : every_options) {
+            std::vector<int> actual(n), actual2(n);
+            psd::transform<8>(xs.data(), n, actual.data(), square, options);
+            psd::transform<8>(xs.data(), n, ys.data(), actual2.data(), subtract, options);
+            EXPECT_EQ(actual, expected) << n;
+            EXPECT_EQ(actual2, expected2) << n;
+        }
+    }
+}
+
+TEST(TestPrefetch, Reductions)
+{
+    std::vector<long> xs(1003), ys(1003);
+    std::iota(xs.begin(), xs.end(), 1);
+    std::iota(ys.rbegin(), ys.rend(), -5);
+
+    auto sums = psd::accumulate<16>(xs.data(), xs.size(), 2L);
+    auto products = psd::inner_product<16>(xs.data(), xs.size(), ys.data(), 2L);
+
+    for (auto options : every_options) {
+        EXPECT_TRUE(psd::all(psd::accumulate<16>(xs.data(), xs.size(), 2L, options) == sums));
+        EXPECT_TRUE(psd::all(psd::inner_product<16>(xs.data(), xs.size(), ys.data(), 2L, options) == products));
+    }
+}
+
+TEST(TestPrefetch, Gather)
+{
+    std::vector<float> src(4096);
+    std::iota(src.begin(), src.end(), 0.5f);
+
+    std::vector<unsigned> indices(1001);
+    for (size_t i = 0; i < indices.size(); ++i)
+        indices[i] = (i * 2654435761u) % src.size();
+
+    for (auto options : every_options) {
+        std::vector<float> gathered(indices.size()), strided(src.size() / 3 + 1);
+        psd::gather<8>(src.data(), indices.data(), indices.size(), gathered.data(), options);
+        psd::gather_strided<8>(src.data(), 3, strided.size(), strided.data(), options);
+
+        for (size_t i = 0; i < indices.size(); ++i)
+            EXPECT_EQ(gathered[i], src[indices[i]]);
+        for (size_t i = 0; i < strided.size(); ++i)
+            EXPECT_EQ(strided[i], src[i * 3]);
+    }
+}
+
+TEST(TestPrefetch, Auto)
+{
+    auto options = psd::prefetch_auto();
+    EXPECT_GE(options.distance, 4 * psd::cache_line_size);
+    EXPECT_LE(options.distance, 1024 * psd::cache_line_size);
+    EXPECT_EQ(options.distance % psd::cache_line_size, 0u);
+    EXPECT_EQ(psd::prefetch_auto().distance, options.distance);
+}
@@ -0,0 +1,77 @@
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "pure_simd.hpp"
+#include "gtest/gtest.h"
+
+namespace psd = pure_simd;
+
+namespace {
+    template <typename T>
+    std::vector<T> random_bytes(std::size_t n, std::uint64_t seed)
+    {
+        std::mt19937_64 gen(seed);
+
+        std::vector<T> xs(n);
+        for (auto& x : xs)
+            x = static_cast<T>(gen());
+        return xs;
+    }
+
+    template <typename A, typename B>
+    std::int64_t reference_dot(const A* a, const B* b, std::size_t n)
+    {
+        std::int64_t sum = 0;
+        for (std::size_t i = 0; i < n; ++i)
+            sum += std::int64_t { a[i] } * b[i];
+        return sum;
+    }
+
+    template <typename A, typename B>
+    void check_dot()
+    {
+        for (std::size_t n : { 0, 1, 63, 64, 1000, 70000 }) {
+            auto a = random_bytes<A>(n, 1);
+            auto b = random_bytes<B>(n, 2);
+            EXPECT_EQ(psd::quantized_dot(a.data(), b.data(), n), reference_dot(a.data(), b.data(), n)) << n;
+        }
+    }
+}
+
+TEST(TestQuantized, Dot)
+{
+    check_dot<std::int8_t, std::int8_t>();
+    check_dot<std::uint8_t, std::int8_t>();
+    check_dot<std::int8_t, std::uint8_t>();
+
+    // The extreme products over more columns than one int32 sum can hold.
+    std::size_t n = 100000;
+    std::vector<std::int8_t> lows(n, -128);
+    std::vector<std::uint8_t> highs(n, 255);
+    EXPECT_EQ(psd::quantized_dot(lows.data(), lows.data(), n), std::int64_t { 16384 } * n);
+    EXPECT_EQ(psd::quantized_dot(highs.data(), lows.data(), n), std::int64_t { -32640 } * n);
+}
+
+TEST(TestQuantized, Gemv)
+{
+    for (std::size_t rows : { 1, 4, 7 }) {
+        std::size_t cols = 333;
+        auto matrix = random_bytes<std::int8_t>(rows * cols, 1);
+        auto x = random_bytes<std::int8_t>(cols, 2);
+        auto ux = random_bytes<std::uint8_t>(cols, 3);
+
+        std::vector<float> scales(rows);
+        for (std::size_t r = 0; r < rows; ++r)
+            scales[r] = 0.5f + 0.25f * r;
+
+        std::vector<float> out(rows);
+        psd::quantized_gemv(matrix.data(), rows, cols, x.data(), scales.data(), out.data());
+        for (std::size_t r = 0; r < rows; ++r)
+            EXPECT_EQ(out[r], scales[r] * static_cast<float>(reference_dot(matrix.data() + r * cols, x.data(), cols)));
+
+        psd::quantized_gemv(matrix.data(), rows, cols, ux.data(), scales.data(), out.data());
+        for (std::size_t r = 0; r < rows; ++r)
+            EXPECT_EQ(out[r], scales[r] * static_cast<float>(reference_dot(matrix.data() + r * cols, ux.data(), cols)));
+    }
+}
@@ -0,0 +1,188 @@
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+#include "pure_simd.hpp"
+#include "gtest/gtest.h"
+
+namespace psd = pure_simd;
+
+namespace {
+    std::uint64_t rotl(std::uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    // The reference xoshiro256++ by Blackman and Vigna.
+    std::uint64_t xoshiro_next(std::uint64_t (&s)[4])
+    {
+        std::uint64_t result = rotl(s[0] + s[3], 23) + s[0];
+        std::uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    template <typename T>
+    std::pair<double, double> mean_and_variance(const std::vector<T>& xs)
+    {
+        double mean = std::accumulate(xs.begin(), xs.end(), 0.0) / xs.size();
+        double squares = 0;
+        for (auto x : xs)
+            squares += (x - mean) * (x - mean);
+        return { mean, squares / xs.size() };
+    }
+}
+
+// Known answers from the Random123 distribution.
+TEST(TestRandom, PhiloxKnownAnswers)
+{
+    using V = psd::vector<std::uint32_t, 4>;
+
+    auto block = [](V counter, std::uint32_t k0, std::uint32_t k1) {
+        using C = psd::vector<std::uint32_t, 1>;
+        auto words = psd::detail::philox_block<C>({ C { counter[0] }, C { counter[1] }, C { counter[2] }, C { counter[3] } }, k0, k1);
+        return V { words[0][0], words[1][0], words[2][0], words[3][0] };
+    };
+
+    EXPECT_TRUE(psd::all(block(V { 0, 0, 0, 0 }, 0, 0) == V { 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 }));
+    EXPECT_TRUE(psd::all(block(V { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff }, 0xffffffff, 0xffffffff)
+        == V { 0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd }));
+    EXPECT_TRUE(psd::all(block(V { 0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344 }, 0xa4093822, 0x299f31d0)
+        == V { 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 }));
+
+    // The first four calls return the words of the blocks of counters 0 to 3.
+    psd::philox<4> gen;
+    V words[4] = { gen(), gen(), gen(), gen() };
+    EXPECT_TRUE(psd::all(V { words[0][0], words[1][0], words[2][0], words[3][0] } == V { 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 }));
+}
+
+TEST(TestRandom, PhiloxPositions)
+{
+    psd::philox<8> gen(42, 7);
+    std::vector<std::uint32_t> expected(160);
+    psd::fill_random(expected.data(), expected.size(), gen, psd::uniform_bits<std::uint32_t> {});
+    EXPECT_EQ(gen.position(), 160u);
+
+    // Any call can be reached directly.
+    for (size_t start : { 8, 16, 24, 40, 100 }) {
+        psd::philox<8> copy(42, 7);
+        copy.seek(start);
+        auto xs = copy();
+        for (size_t i = 0; i < 8; ++i)
+            EXPECT_EQ(xs[i], expected[start / 8 * 8 + i]) << start;
+        EXPECT_EQ(copy.position(), start / 8 * 8 + 8);
+    }
+
+    // A copy continues from where the engine was, not from its last block.
+    auto copy = gen;
+    copy.seek(24);
+    gen.seek(24);
+    gen.discard(8);
+    copy();
+    EXPECT_TRUE(psd::all(copy() == gen()));
+
+    psd::philox<4> other_stream(42, 8), other_seed(43, 7);
+    EXPECT_FALSE(psd::all(other_stream() == psd::philox<4>(42, 7)()));
+    EXPECT_FALSE(psd::all(other_seed() == psd::philox<4>(42, 7)()));
+}
+
+TEST(TestRandom, Xoshiro)
+{
+    std::uint64_t seed = 5, s[4];
+    for (auto& word : s)
+        word = psd::detail::splitmix64(seed);
+
+    psd::xoshiro256pp<4> gen(5);
+    std::vector<std::uint64_t> lanes[4];
+    for (int i = 0; i < 100; ++i) {
+        auto xs = gen();
+        EXPECT_EQ(xs[0], xoshiro_next(s)) << i;
+        for (size_t lane = 0; lane < 4; ++lane)
+            lanes[lane].push_back(xs[lane]);
+    }
+
+    for (size_t lane = 1; lane < 4; ++lane)
+        EXPECT_NE(lanes[lane], lanes[0]);
+
+    auto jumped = gen;
+    jumped.long_jump();
+    EXPECT_FALSE(psd::all(jumped() == gen()));
+}
+
+TEST(TestRandom, Uniform)
+{
+    std::vector<float> floats(100001);
+    psd::philox<16> philox(1);
+    psd::fill_random(floats.data(), floats.size(), philox, psd::uniform_real<float> { -2.0f, 3.0f });
+
+    EXPECT_GE(*std::min_element(floats.begin(), floats.end()), -2.0f);
+    EXPECT_LT(*std::max_element(floats.begin(), floats.end()), 3.0f);
+    auto [mean, variance] = mean_and_variance(floats);
+    EXPECT_NEAR(mean, 0.5, 0.02);
+    EXPECT_NEAR(variance, 25.0 / 12, 0.02);
+
+    // Doubles take two values of a 32-bit engine.
+    std::vector<double> doubles(1000);
+    psd::philox<8> bits(1);
+    psd::fill_random(doubles.data(), doubles.size(), bits, psd::uniform_real<double> {});
+    EXPECT_EQ(bits.position(), 2000u);
+
+    psd::xoshiro256pp<8> xoshiro(1);
+    std::vector<double> unit(100000);
+    psd::fill_random(unit.data(), unit.size(), xoshiro, psd::uniform_real<double> {});
+    EXPECT_GE(*std::min_element(unit.begin(), unit.end()), 0.0);
+    EXPECT_LT(*std::max_element(unit.begin(), unit.end()), 1.0);
+    EXPECT_NEAR(mean_and_variance(unit).first, 0.5, 0.01);
+}
+
+TEST(TestRandom, Normal)
+{
+    for (float x : { 1e-7f, 0.3f, 0.70710677f, 0.7071068f, 0.999f, 1.0f })
+        EXPECT_NEAR(psd::detail::log_normal_float(x), std::log(x), 2e-7f * std::max(1.0f, std::abs(std::log(x)))) << x;
+
+    for (float t = 0; t < 1; t += 1.0f / 97) {
+        auto [s, c] = psd::detail::sin_cos_turns(t);
+        EXPECT_NEAR(s, std::sin(2 * M_PI * t), 1e-6) << t;
+        EXPECT_NEAR(c, std::cos(2 * M_PI * t), 1e-6) << t;
+    }
+
+    std::vector<float> floats(200000);
+    psd::philox<16> philox(2);
+    psd::fill_random(floats.data(), floats.size(), philox, psd::normal<float> { 1.0f, 2.0f });
+    auto [mean, variance] = mean_and_variance(floats);
+    EXPECT_NEAR(mean, 1.0, 0.02);
+    EXPECT_NEAR(variance, 4.0, 0.05);
+
+    auto within = std::count_if(floats.begin(), floats.end(), [](float x) { return std::abs(x - 1.0f) < 2.0f; });
+    EXPECT_NEAR(double(within) / floats.size(), 0.6827, 0.005);
+
+    std::vector<double> doubles(200000);
+    psd::xoshiro256pp<4> xoshiro(2);
+    psd::fill_random(doubles.data(), doubles.size(), xoshiro, psd::normal<double> {});
+    auto [dmean, dvariance] = mean_and_variance(doubles);
+    EXPECT_NEAR(dmean, 0.0, 0.01);
+    EXPECT_NEAR(dvariance, 1.0, 0.02);
+}
+
+TEST(TestRandom, FillThreads)
+{
+    for (size_t n : { 0, 5, 64, 1000, 100003 }) {
+        psd::philox<8> serial(3, 1), parallel(3, 1);
+        serial.discard(13);
+        parallel.discard(13);
+
+        std::vector<double> expected(n), actual(n);
+        psd::fill_random(expected.data(), n, serial, psd::normal<double> {});
+        psd::fill_random(actual.data(), n, parallel, psd::normal<double> {}, 4);
+        EXPECT_EQ(actual, expected) << n;
+        EXPECT_EQ(parallel.position(), serial.position()) << n;
+
+        std::vector<float> floats(n), more(n);
+        psd::fill_random(floats.data(), n, serial, psd::uniform_real<float> {}, 3);
+        psd::fill_random(more.data(), n, parallel, psd::uniform_real<float> {});
+        EXPECT_EQ(floats, more) << n;
+    }
+}
@@ -0,0 +1,114 @@
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "pure_simd.hpp"
+#include "gtest/gtest.h"
+
+namespace psd = pure_simd;
+
+namespace {
+    // Values of very different magnitudes, so the summation order matters.
+    std::vector<float> random_values(size_t n, unsigned seed)
+    {
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<float> mantissa(-1.0f, 1.0f);
+        std::uniform_int_distribution<int> exponent(-10, 10);
+
+        std::vector<float> xs(n);
+        for (auto& x : xs)
+            x = std::ldexp(mantissa(gen), exponent(gen));
+        return xs;
+    }
+
+    long double exact_sum(const std::vector<float>& xs)
+    {
+        long double sum = 0;
+        for (auto x : xs)
+            sum += x;
+        return sum;
+    }
+
+    template <typename Mode>
+    void expect_deterministic_accumulate(Mode mode, const std::vector<float>& xs)
+    {
+        auto expected = psd::accumulate<1>(xs.data(), xs.size(), 0.5f, mode);
+
+        EXPECT_EQ(psd::accumulate<4>(xs.data(), xs.size(), 0.5f, mode), expected);
+        EXPECT_EQ(psd::accumulate<8>(xs.data(), xs.size(), 0.5f, mode), expected);
+        EXPECT_EQ(psd::accumulate<16>(xs.data(), xs.size(), 0.5f, mode), expected);
+        EXPECT_EQ(psd::accumulate<64>(xs.data(), xs.size(), 0.5f, mode), expected);
+
+        for (size_t threads : { 2, 3, 7 })
+            EXPECT_EQ(psd::accumulate<16>(xs.data(), xs.size(), 0.5f, mode.with_threads(threads)), expected);
+    }
+
+    template <typename Mode>
+    void expect_deterministic_inner_product(Mode mode, const std::vector<float>& xs, const std::vector<float>& ys)
+    {
+        auto expected = psd::inner_product<1>(xs.data(), xs.size(), ys.data(), 0.0f, mode);
+
+        EXPECT_EQ(psd::inner_product<8>(xs.data(), xs.size(), ys.data(), 0.0f, mode), expected);
+        EXPECT_EQ(psd::inner_product<32>(xs.data(), xs.size(), ys.data(), 0.0f, mode), expected);
+        EXPECT_EQ(psd::inner_product<16>(xs.data(), xs.size(), ys.data(), 0.0f, mode.with_threads(4)), expected);
+    }
+}
+
+TEST(TestReduce, DeterministicAccumulate)
+{
+    for (size_t n : { 0, 1, 63, 64, 65, 4096, 4097, 100003 }) {
+        auto xs = random_values(n, 42);
+
+        expect_deterministic_accumulate(psd::pairwise, xs);
+        expect_deterministic_accumulate(psd::kahan, xs);
+        expect_deterministic_accumulate(psd::neumaier, xs);
+    }
+}
+
+TEST(TestReduce, DeterministicInnerProduct)
+{
+    for (size_t n : { 0, 5, 4096, 20001 }) {
+        auto xs = random_values(n, 1);
+        auto ys = random_values(n, 2);
+
+        expect_deterministic_inner_product(psd::pairwise, xs, ys);
+        expect_deterministic_inner_product(psd::kahan, xs, ys);
+        expect_deterministic_inner_product(psd::neumaier, xs, ys);
+    }
+}
+
+TEST(TestReduce, Empty)
+{
+    const float* none = nullptr;
+
+    EXPECT_EQ(psd::accumulate<8>(none, 0, 1.5f, psd::kahan), 1.5f);
+    EXPECT_EQ(psd::inner_product<8>(none, 0, none, 2.5, psd::neumaier), 2.5);
+}
+
+TEST(TestReduce, Compensated)
+{
+    auto xs = random_values(1000003, 7);
+    auto exact = exact_sum(xs);
+
+    auto pairwise_error = std::abs(psd::accumulate<16>(xs.data(), xs.size(), 0.0f, psd::pairwise) - exact);
+    auto kahan_error = std::abs(psd::accumulate<16>(xs.data(), xs.size(), 0.0f, psd::kahan) - exact);
+    auto neumaier_error = std::abs(psd::accumulate<16>(xs.data(), xs.size(), 0.0f, psd::neumaier) - exact);
+
+    // Compensated float sums are correctly rounded up to a few ulps.
+    auto ulp = std::abs(std::nextafter(static_cast<float>(exact), 0.0f) - static_cast<float>(exact));
+    EXPECT_LE(kahan_error, 2 * ulp);
+    EXPECT_LE(neumaier_error, 2 * ulp);
+    EXPECT_LE(neumaier_error, pairwise_error);
+
+    // Neumaier also survives cancellation, where Kahan loses the small terms.
+    std::vector<double> ys { 1.0, 1e100, 1.0, -1e100 };
+    EXPECT_EQ(psd::accumulate<4>(ys.data(), ys.size(), 0.0, psd::neumaier), 2.0);
+}
+
+TEST(TestReduce, Conversion)
+{
+    std::vector<int> xs(1000, 3);
+
+    EXPECT_EQ(psd::accumulate<8>(xs.data(), xs.size(), 0.0, psd::pairwise), 3000.0);
+    EXPECT_EQ(psd::inner_product<8>(xs.data(), xs.size(), xs.data(), 0.0f, psd::kahan), 9000.0f);
+}
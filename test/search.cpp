@@ -0,0 +1,97 @@
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "pure_simd.hpp"
+#include "gtest/gtest.h"
+
+namespace psd = pure_simd;
+
+namespace {
+    template <typename T>
+    std::vector<T> random_values(std::size_t n, std::int64_t range, std::uint64_t seed)
+    {
+        std::mt19937_64 gen(seed);
+
+        std::vector<T> xs(n);
+        for (auto& x : xs)
+            x = static_cast<T>(static_cast<std::int64_t>(gen() % range) - range / 2);
+        return xs;
+    }
+
+    template <typename T>
+    std::vector<std::size_t> expected_bounds(const std::vector<T>& sorted, const std::vector<T>& queries)
+    {
+        std::vector<std::size_t> bounds;
+        for (auto q : queries)
+            bounds.push_back(std::lower_bound(sorted.begin(), sorted.end(), q) - sorted.begin());
+        return bounds;
+    }
+
+    // Sorted arrays of every size up to 70, with duplicates, and queries
+    // below, between, on and above their values.
+    template <std::size_t VectorSize, typename T>
+    void check_lower_bounds()
+    {
+        auto queries = random_values<T>(37, 120, 7);
+        queries.push_back(std::numeric_limits<T>::max());
+        queries.push_back(std::numeric_limits<T>::lowest());
+
+        for (std::size_t n = 0; n <= 70; ++n) {
+            auto sorted = random_values<T>(n, 100, n);
+            std::sort(sorted.begin(), sorted.end());
+            auto expected = expected_bounds(sorted, queries);
+
+            std::vector<std::size_t> bounds(queries.size());
+            psd::lower_bound_batch<VectorSize>(sorted.data(), n, queries.data(), queries.size(), bounds.data());
+            EXPECT_EQ(bounds, expected) << n;
+
+            std::vector<T> tree(psd::eytzinger_size(n));
+            psd::eytzinger_layout(sorted.data(), n, tree.data());
+
+            bounds.assign(queries.size(), 0);
+            psd::eytzinger_lower_bound_batch<VectorSize>(tree.data(), n, queries.data(), queries.size(), bounds.data());
+            EXPECT_EQ(bounds, expected) << n;
+        }
+    }
+}
+
+TEST(TestSearch, LowerBound)
+{
+    check_lower_bounds<8, std::int64_t>();
+    check_lower_bounds<16, std::uint32_t>();
+    check_lower_bounds<4, double>();
+}
+
+TEST(TestSearch, EytzingerLayout)
+{
+    EXPECT_EQ(psd::eytzinger_size(0), 1u);
+    EXPECT_EQ(psd::eytzinger_size(7), 8u);
+    EXPECT_EQ(psd::eytzinger_size(8), 16u);
+
+    int sorted[] = { 1, 2, 3, 4, 5, 6 };
+    int tree[8];
+    psd::eytzinger_layout(sorted, 6, tree);
+
+    constexpr int max = std::numeric_limits<int>::max();
+    EXPECT_EQ(std::vector<int>(tree + 1, tree + 8), (std::vector<int> { 4, 2, 6, 1, 3, 5, max }));
+}
+
+TEST(TestSearch, Large)
+{
+    auto sorted = random_values<std::int64_t>(100000, std::int64_t { 1 } << 40, 1);
+    std::sort(sorted.begin(), sorted.end());
+    auto queries = random_values<std::int64_t>(10000, std::int64_t { 1 } << 40, 2);
+    auto expected = expected_bounds(sorted, queries);
+
+    std::vector<std::size_t> bounds(queries.size());
+    psd::lower_bound_batch<16>(sorted.data(), sorted.size(), queries.data(), queries.size(), bounds.data());
+    EXPECT_EQ(bounds, expected);
+
+    std::vector<std::int64_t> tree(psd::eytzinger_size(sorted.size()));
+    psd::eytzinger_layout(sorted.data(), sorted.size(), tree.data());
+    psd::eytzinger_lower_bound_batch<16>(tree.data(), sorted.size(), queries.data(), queries.size(), bounds.data());
+    EXPECT_EQ(bounds, expected);
+}
@@ -0,0 +1,167 @@
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "pure_simd.hpp"
+#include "gtest/gtest.h"
+
+namespace psd = pure_simd;
+
+namespace {
+    template <typename T>
+    std::vector<T> random_keys(std::size_t n, int max)
+    {
+        std::mt19937 gen(n);
+        std::uniform_int_distribution<> dis(-max, max);
+        std::vector<T> keys(n);
+        std::generate(keys.begin(), keys.end(), [&] {
+            return static_cast<T>(dis(gen));
+        });
+        return keys;
+    }
+}
+
+TEST(TestSort, Vector)
+{
+    using ivec = psd::vector<int, 8>;
+
+    ivec xs { 5, -1, 7, 3, 3, 0, 9, -4 };
+    ivec ys = psd::sort(xs);
+
+    EXPECT_TRUE(std::is_sorted(ys.begin(), ys.end()));
+    EXPECT_TRUE(std::is_permutation(xs.begin(), xs.end(), ys.begin()));
+
+    using fvec = psd::vector<float, 32>;
+
+    auto keys = random_keys<float>(32, 10);
+    fvec fs = psd::sort(psd::load_from<fvec>(keys.data()));
+    std::sort(keys.begin(), keys.end());
+
+    EXPECT_TRUE(std::equal(keys.begin(), keys.end(), fs.begin()));
+}
+
+TEST(TestSort, VectorWithPayload)
+{
+    using ivec = psd::vector<int, 16>;
+    using svec = psd::vector<short, 16>;
+
+    auto keys = random_keys<int>(16, 5);
+    auto xs = psd::load_from<ivec>(keys.data());
+    auto idxs = psd::iota<svec, short>(short { 0 }, short { 1 });
+
+    auto [sorted_keys, sorted_idxs] = psd::sort(xs, idxs);
+
+    EXPECT_TRUE(std::is_sorted(sorted_keys.begin(), sorted_keys.end()));
+    EXPECT_TRUE(std::is_permutation(idxs.begin(), idxs.end(), sorted_idxs.begin()));
+
+    for (std::size_t i = 0; i < 16; ++i)
+        EXPECT_EQ(sorted_keys[i], xs[sorted_idxs[i]]);
+}
+
+TEST(TestSort, Merge)
+{
+    using ivec = psd::vector<int, 4>;
+
+    auto [lo, hi] = psd::merge(ivec { 1, 4, 5, 8 }, ivec { 2, 3, 6, 7 });
+
+    EXPECT_EQ(lo[0], 1);
+    EXPECT_EQ(lo[1], 2);
+    EXPECT_EQ(lo[2], 3);
+    EXPECT_EQ(lo[3], 4);
+    EXPECT_EQ(hi[0], 5);
+    EXPECT_EQ(hi[1], 6);
+    EXPECT_EQ(hi[2], 7);
+    EXPECT_EQ(hi[3], 8);
+}
+
+TEST(TestSort, Columns)
+{
+    using ivec = psd::vector<int, 4>;
+
+    std::array<ivec, 4> columns { {
+        { 3, 0, 7, -1 },
+        { 1, 0, 2, -5 },
+        { 2, 9, 4, 8 },
+        { 0, 5, 1, 6 },
+    } };
+
+    auto sorted = psd::sort_columns(columns);
+
+    for (std::size_t i = 0; i < 4; ++i) {
+        std::vector<int> column { columns[0][i], columns[1][i], columns[2][i], columns[3][i] };
+        std::sort(column.begin(), column.end());
+
+        for (std::size_t k = 0; k < 4; ++k)
+            EXPECT_EQ(sorted[k][i], column[k]);
+    }
+
+    using svec = psd::vector<short, 4>;
+
+    std::array<svec, 4> idxs { {
+        { 0, 0, 0, 0 },
+        { 1, 1, 1, 1 },
+        { 2, 2, 2, 2 },
+        { 3, 3, 3, 3 },
+    } };
+
+    auto [sorted_keys, sorted_idxs] = psd::sort_columns(columns, idxs);
+
+    for (std::size_t i = 0; i < 4; ++i) {
+        for (std::size_t k = 0; k < 4; ++k) {
+            EXPECT_EQ(sorted_keys[k][i], sorted[k][i]);
+            EXPECT_EQ(sorted_keys[k][i], columns[sorted_idxs[k][i]][i]);
+        }
+    }
+}
+
+TEST(TestSort, Array)
+{
+    for (std::size_t n : { 0, 1, 7, 16, 17, 100, 1000, 4097 }) {
+        auto keys = random_keys<std::int32_t>(n, 1000);
+        auto expected = keys;
+        std::sort(expected.begin(), expected.end());
+
+        psd::sort<16>(keys.data(), n);
+
+        EXPECT_EQ(keys, expected);
+    }
+
+    auto keys = random_keys<double>(999, 1000000);
+    auto expected = keys;
+    std::sort(expected.begin(), expected.end());
+
+    psd::sort<4>(keys.data(), keys.size());
+
+    EXPECT_EQ(keys, expected);
+
+    keys = random_keys<double>(5000, 10);
+    expected = keys;
+    std::sort(expected.begin(), expected.end());
+
+    psd::sort<32>(keys.data(), keys.size());
+
+    EXPECT_EQ(keys, expected);
+}
+
+TEST(TestSort, ArrayWithPayload)
+{
+    for (std::size_t n : { 3, 8, 50, 3000 }) {
+        auto keys = random_keys<std::uint32_t>(n, 20);
+        const auto original = keys;
+
+        std::vector<std::uint32_t> idxs(n);
+        std::iota(idxs.begin(), idxs.end(), 0);
+
+        psd::sort<8>(keys.data(), n, idxs.data());
+
+        EXPECT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+
+        auto sorted_idxs = idxs;
+        std::sort(sorted_idxs.begin(), sorted_idxs.end());
+        for (std::size_t i = 0; i < n; ++i) {
+            EXPECT_EQ(sorted_idxs[i], i);
+            EXPECT_EQ(keys[i], original[idxs[i]]);
+        }
+    }
+}
@@ -0,0 +1,145 @@
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "pure_simd_stream.hpp"
+#include "gtest/gtest.h"
+
+namespace psd = pure_simd;
+
+namespace {
+    // A file in the temporary directory that is removed again.
+    struct temporary_file {
+        explicit temporary_file(const std::string& name)
+            : path { (std::filesystem::temp_directory_path() / ("pure_simd_" + name)).string() }
+        {
+        }
+
+        ~temporary_file() { std::remove(path.c_str()); }
+
+        std::string path;
+    };
+
+    template <typename T>
+    void write_file(const std::string& path, const std::vector<T>& xs)
+    {
+        std::ofstream out(path, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(xs.data()), xs.size() * sizeof(T));
+    }
+
+    template <typename T>
+    std::vector<T> read_file(const std::string& path)
+    {
+        std::ifstream in(path, std::ios::binary);
+        std::vector<T> xs(std::filesystem::file_size(path) / sizeof(T));
+        in.read(reinterpret_cast<char*>(xs.data()), xs.size() * sizeof(T));
+        return xs;
+    }
+
+    // Chunks of 1000 ints, so that most sizes have several chunks and a tail.
+    constexpr psd::stream_options small_chunks { 4000 };
+}
+
+TEST(TestStream, Chunks)
+{
+    temporary_file src("chunks");
+
+    std::vector<int> xs(10'003);
+    std::iota(xs.begin(), xs.end(), 0);
+    write_file(src.path, xs);
+
+    std::vector<int> seen;
+    psd::stream_chunks<8, int>(
+        src.path, [&](const int* chunk, size_t offset, size_t count) {
+            EXPECT_EQ(offset, seen.size());
+            if (offset + count < xs.size()) {
+                EXPECT_EQ(count % 8, 0u);
+            }
+            seen.insert(seen.end(), chunk, chunk + count);
+        },
+        small_chunks);
+
+    EXPECT_EQ(seen, xs);
+}
+
+TEST(TestStream, Transform)
+{
+    temporary_file src("transform_src"), dst("transform_dst");
+
+    for (size_t n : { 0, 1, 999, 1000, 12'345 }) {
+        std::vector<int> xs(n);
+        std::iota(xs.begin(), xs.end(), -7);
+        write_file(src.path, xs);
+
+        auto square = [](int x) { return static_cast<double>(x) * x; };
+        for (auto options : { small_chunks, psd::stream_options { 4000, true }, psd::stream_options {} }) {
+            psd::stream_transform<8, int, double>(src.path, dst.path, square, options);
+
+            std::vector<double> expected(n);
+            std::transform(xs.begin(), xs.end(), expected.begin(), square);
+            EXPECT_EQ(read_file<double>(dst.path), expected) << n;
+        }
+    }
+}
+
+TEST(TestStream, Accumulate)
+{
+    temporary_file src("accumulate");
+
+    std::vector<int> xs(12'345);
+    std::iota(xs.begin(), xs.end(), 1);
+    write_file(src.path, xs);
+
+    auto expected = psd::accumulate<16>(xs.data(), xs.size(), 3);
+    auto sums = psd::stream_accumulate<16, int>(src.path, 3, small_chunks);
+    EXPECT_TRUE(psd::all(sums == expected));
+
+    auto sums_read_ahead = psd::stream_accumulate<16, int>(src.path, 3, psd::stream_options { 4000, true });
+    EXPECT_TRUE(psd::all(sums_read_ahead == expected));
+
+    auto max = [](long x, long y) { return std::max(x, y); };
+    auto maxima = psd::stream_accumulate<16, int>(src.path, 0L, max, small_chunks);
+    EXPECT_EQ(*std::max_element(maxima.begin(), maxima.end()), 12'345);
+}
+
+TEST(TestStream, Errors)
+{
+    temporary_file src("errors");
+    write_file(src.path, std::vector<char>(7));
+
+    auto sum_ints = [](const std::string& path) { return psd::stream_accumulate<8, int>(path, 0); };
+    EXPECT_THROW(sum_ints(src.path), std::invalid_argument);
+    EXPECT_THROW(sum_ints(src.path + ".missing"), std::system_error);
+}
+
+TEST(TestStream, ThrowingFunction)
+{
+    temporary_file src("throwing");
+    write_file(src.path, std::vector<int>(10'000));
+
+    // The read-ahead thread is still running when the first chunk throws.
+    auto fail = [](const int*, size_t, size_t) { throw std::runtime_error("chunk"); };
+    EXPECT_THROW((psd::stream_chunks<8, int>(src.path, fail, psd::stream_options { 4000, true })), std::runtime_error);
+}
+
+TEST(TestStream, TransformOntoItself)
+{
+    temporary_file src("in_place");
+    temporary_file link("in_place_link");
+
+    std::vector<int> xs(10'000);
+    std::iota(xs.begin(), xs.end(), 0);
+    write_file(src.path, xs);
+    std::filesystem::create_symlink(src.path, link.path);
+
+    auto twice = [](auto x) { return x + x; };
+    for (const auto& dst : { src.path, link.path })
+        EXPECT_THROW((psd::stream_transform<8, int, int>(src.path, dst, twice, small_chunks)), std::invalid_argument) << dst;
+
+    EXPECT_EQ(read_file<int>(src.path), xs);
+}
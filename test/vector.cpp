@@ -1,5 +1,6 @@
 #include <algorithm>
 #include <numeric>
+#include <tuple>
 #include <type_traits>
 
 #include "pure_simd.hpp"
@@ -86,6 +87,65 @@ TEST(TestVector, UnrollBinaryOperation)
     EXPECT_EQ(ns[4], 0);
 }
 
+TEST(TestVector, UnrollVariadic)
+{
+    vec xs { 0, 1, 2, 3, 4 };
+    vec ys { 5, 6, 7, 8, 9 };
+
+    vec zs = unroll([](int a, int b, int c, int d) { return a * b + c * d; }, xs, ys, ys, xs);
+
+    EXPECT_EQ(zs[0], 0);
+    EXPECT_EQ(zs[1], 12);
+    EXPECT_EQ(zs[4], 72);
+
+    auto [sums, differences] = unroll([](int a, int b) { return std::tuple { a + b, a - b }; }, xs, ys);
+    static_assert(std::is_same_v<decltype(sums), vec>);
+
+    EXPECT_EQ(sums[0], 5);
+    EXPECT_EQ(sums[4], 13);
+    EXPECT_EQ(differences[0], -5);
+    EXPECT_EQ(differences[4], -5);
+}
+
+int negate(int x) { return -x; }
+
+TEST(TestVector, TransformVariadic)
+{
+    std::vector<float> as(19), xs(19), bs(19), ys(19), cs(19), zs(19);
+    for (size_t i = 0; i < as.size(); ++i) {
+        as[i] = i;
+        xs[i] = 2;
+        bs[i] = 1;
+        ys[i] = i * 0.5f;
+        cs[i] = -3;
+        zs[i] = 0.25f;
+    }
+
+    std::vector<float> out(19);
+    transform<8>(out.data(), out.size(), [](auto a, auto x, auto b, auto y, auto c, auto z) { return a * x + b * y + c * z; },
+        as.data(), xs.data(), bs.data(), ys.data(), cs.data(), zs.data());
+
+    for (size_t i = 0; i < out.size(); ++i)
+        EXPECT_FLOAT_EQ(out[i], as[i] * xs[i] + bs[i] * ys[i] + cs[i] * zs[i]);
+
+    std::vector<float> sums(19), products(19);
+    transform<4>(std::tuple { sums.data(), products.data() }, sums.size(),
+        [](float a, float y) { return std::tuple { a + y, a * y }; }, as.data(), ys.data());
+
+    for (size_t i = 0; i < sums.size(); ++i) {
+        EXPECT_FLOAT_EQ(sums[i], as[i] + ys[i]);
+        EXPECT_FLOAT_EQ(products[i], as[i] * ys[i]);
+    }
+
+    std::vector<int> ns { 1, 2, 3, 4, 5 }, negated(5);
+    transform<4>(negated.data(), ns.size(), negate, ns.data());
+    EXPECT_EQ(negated, (std::vector<int> { -1, -2, -3, -4, -5 }));
+
+    std::fill(negated.begin(), negated.end(), 0);
+    transform<4>(ns.data(), ns.size(), negated.data(), negate);
+    EXPECT_EQ(negated, (std::vector<int> { -1, -2, -3, -4, -5 }));
+}
+
 template <typename Vec>
 bool all_equal(Vec xs, Vec ys)
 {